@@ -5,8 +5,31 @@
       "sources": [
         "src/main.cpp",
         "src/common/filesystem_common.cpp",
+        "src/common/fingerprint.cpp",
+        "src/common/duplicate_detector.cpp",
+        "src/common/package_manifest.cpp",
+        "src/common/scan_diagnostics.cpp",
+        "src/common/tree_shape.cpp",
+        "src/common/latency_histogram.cpp",
+        "src/common/memory_accounting.cpp",
+        "src/common/cpu_topology.cpp",
+        "src/common/partitioned_inode_set.cpp",
+        "src/common/ignore_patterns.cpp",
+        "src/common/operation_watchdog.cpp",
+        "src/common/scan_coalescer.cpp",
+        "src/common/scan_scheduler.cpp",
+        "src/common/tree_export_writer.cpp",
+        "src/common/tree_sink.cpp",
+        "src/common/snapshot_writer.cpp",
+        "src/common/snapshot_reader.cpp",
+        "src/common/snapshot_query.cpp",
+        "src/common/process_metrics.cpp",
+        "src/common/blake3_hasher.cpp",
         "src/windows/mft_accelerator.cpp",
         "src/linux/syscall_accelerator.cpp",
+        "src/linux/scan_pipeline.cpp",
+        "src/linux/content_digest.cpp",
+        "src/linux/project_quota.cpp",
         "src/macos/syscall_accelerator.cpp"
       ],
       "include_dirs": [
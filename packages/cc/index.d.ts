@@ -8,10 +8,258 @@ export interface CalculationOptions {
   maxDepth?: number;
   /** 忽略模式列表 */
   ignorePatterns?: string[];
-  /** 是否启用硬链接检测 */
+  /** 是否启用硬链接检测（开启时同一 inode 只计一次，关闭时每个路径单独计数） */
   inodeCheck?: boolean;
   /** 是否包含符号链接大小 */
   includeLink?: boolean;
+  /** 是否跟随符号链接 */
+  followSymlinks?: boolean;
+  /** 最大线程数（0 为自动） */
+  maxThreads?: number;
+  /** 是否检测相同子树，在遍历线程中自底向上计算结构哈希（Linux/macOS） */
+  detectDuplicates?: boolean;
+  /** 相同子树检测是否同时比较文件内容（需读取文件，较慢） */
+  duplicateContentHash?: boolean;
+  /** 是否按 node_modules 中的 npm 包汇总（含 @scope/pkg，Linux/macOS） */
+  aggregatePackages?: boolean;
+  /** 报告最慢目录的数量，0 为不统计（Linux/macOS） */
+  slowDirectoryLimit?: number;
+  /** 是否统计 getdents64 / stat / open / close 的延迟直方图（Linux/macOS） */
+  latencyHistograms?: boolean;
+  /** 是否统计目录树形状：深度、扇出、路径长度分布（Linux/macOS） */
+  shapeProfile?: boolean;
+  /** 形状统计中保留的最大目录与最长路径数量，默认 10 */
+  shapeProfileLimit?: number;
+  /** 扫描器内存上限（字节），超出后降级为仅汇总模式，0 为不限制 */
+  memoryLimit?: number;
+  /** 工作线程依次绑定的 CPU 列表，按 NUMA 节点交错分配（Linux） */
+  cpuAffinity?: number[];
+  /** 未指定 cpuAffinity 时，将工作线程轮流绑定到各 NUMA 节点的 CPU 集合（Linux） */
+  numaAware?: boolean;
+  /** 目录自身大小是否计入总大小，与 get-folder 的 JS 实现口径一致（Linux/macOS） */
+  includeDirectorySize?: boolean;
+  /** 流水线模式的列目录线程数，0 为按目录递归遍历（Linux；启用相同子树检测、包统计或慢目录统计时不生效） */
+  pipelineListers?: number;
+  /** 流水线模式的 stat 线程数，0 为自动（Linux） */
+  pipelineStatWorkers?: number;
+  /** 流水线模式目录项批次队列的容量（批次数），队列满时列目录线程等待（Linux） */
+  pipelineQueueDepth?: number;
+  /**
+   * 单次 open / getdents64 / stat 的超时时间（毫秒），0 为不限制（Linux）
+   * 超时的子树被放弃并记入 timedOut，阻塞的线程由新线程接替；设置后使用流水线扫描，扫描根路径本身不受监视。
+   * 流水线不支持 detectDuplicates、aggregatePackages 与 slowDirectoryLimit，与这些选项同时设置时不扫描，只在 errors 中返回错误
+   */
+  operationTimeoutMs?: number;
+  /**
+   * 与进行中的相同请求（词法规范化后的路径与其余选项均相同）合并，共享同一次扫描的结果
+   * 异步调用加入进行中的扫描；同步调用只复用未过期的缓存结果
+   */
+  coalesce?: boolean;
+  /** 启用 coalesce 时结果的缓存时间（毫秒），0 为不缓存 */
+  coalesceTtlMs?: number;
+  /**
+   * 与并发扫描共享执行槽位时的优先级，默认 'normal'
+   * 槽位按加权公平方式分配（interactive : normal : batch = 16 : 4 : 1）
+   */
+  priority?: ScanPriority;
+  /**
+   * 根目录是 ext4 / XFS 项目配额目录时，直接读取项目的配额用量而不遍历（Linux）
+   * 需要 CAP_SYS_ADMIN、inodeCheck 与 includeDirectorySize 均为 true，且项目 ID 只分配给这棵目录树；
+   * 设置了过滤条件或需要逐项统计的选项时仍完整遍历。使用配额时各项数量与最新修改 / 访问时间为 0
+   */
+  projectQuota?: boolean;
+}
+
+/**
+ * 项目配额用量接口
+ */
+export interface ProjectQuotaUsage {
+  /** 项目 ID */
+  projectId: number;
+  /** 已占用空间（字节，按分配的块计算，字符串形式的数字） */
+  spaceBytes: string;
+  /** 已使用的 inode 数（文件、目录、链接等合计） */
+  inodes: number;
+}
+
+/**
+ * 慢目录记录接口
+ */
+export interface SlowDirectory {
+  /** 目录路径 */
+  path: string;
+  /** 列目录耗时（毫秒，含打开目录） */
+  listMs: number;
+  /** 子项 stat 耗时（毫秒，不含子目录递归） */
+  statMs: number;
+  /** 总耗时（毫秒） */
+  totalMs: number;
+  /** 子项数量 */
+  entryCount: number;
+  /** 平均每个子项耗时（毫秒） */
+  msPerEntry: number;
+}
+
+/**
+ * 目录扇出分桶接口（按 2 的幂划分）
+ */
+export interface FanOutBucket {
+  /** 子项数下界 */
+  min: number;
+  /** 子项数上界 */
+  max: number;
+  /** 目录数 */
+  count: number;
+}
+
+/**
+ * 目录树形状统计接口
+ */
+export interface TreeShape {
+  /** 计入统计的项目数（文件、目录、符号链接） */
+  entries: number;
+  /** 已列出的目录数 */
+  directories: number;
+  /** 深度分布（counts[d] 为深度 d 的项目数，根为 0） */
+  depth: { counts: number[]; mean: number; max: number };
+  /** 目录扇出分布（子项数，含隐藏与忽略的项目；百分位为分桶上界） */
+  fanOut: { buckets: FanOutBucket[]; mean: number; p50: number; p90: number; p99: number; max: number };
+  /** 路径长度分布（字节，百分位精度为 8 字节） */
+  pathLength: { mean: number; p50: number; p90: number; p99: number; max: number };
+  /** 子项最多的目录（降序） */
+  largestDirectories: Array<{ path: string; entryCount: number }>;
+  /** 最长的路径（降序） */
+  longestPaths: Array<{ path: string; length: number }>;
+}
+
+/**
+ * 相同子树分组接口
+ */
+export interface DuplicateGroup {
+  /** 结构哈希（16 位十六进制） */
+  hash: string;
+  /** 单个副本大小（字符串形式的数字） */
+  size: string;
+  /** 单个副本文件数量 */
+  fileCount: number;
+  /** 可回收大小（字符串形式的数字） */
+  redundantSize: string;
+  /** 各副本路径 */
+  paths: string[];
+}
+
+/**
+ * 延迟百分位统计接口（单位：微秒）
+ */
+export interface LatencyPercentiles {
+  /** 调用次数 */
+  count: number;
+  /** 平均值 */
+  meanUs: number;
+  /** 中位数 */
+  p50Us: number;
+  /** 99 分位 */
+  p99Us: number;
+  /** 99.9 分位 */
+  p999Us: number;
+  /** 最大值 */
+  maxUs: number;
+}
+
+/**
+ * 各系统调用延迟统计接口
+ */
+export interface SyscallLatency {
+  getdents64: LatencyPercentiles;
+  stat: LatencyPercentiles;
+  open: LatencyPercentiles;
+  close: LatencyPercentiles;
+}
+
+/**
+ * 单项内存用量接口（字节）
+ */
+export interface MemoryFigure {
+  /** 当前用量 */
+  current: number;
+  /** 峰值用量 */
+  peak: number;
+}
+
+/**
+ * 扫描优先级
+ */
+export type ScanPriority = 'interactive' | 'normal' | 'batch';
+
+/**
+ * 扫描调度器状态
+ */
+export interface SchedulerStats {
+  /** 所有扫描共享的执行槽位数 */
+  capacity: number;
+  /** 已占用的槽位数 */
+  active: number;
+  /** 等待槽位的线程数 */
+  waiting: number;
+}
+
+/**
+ * 扫描器内存用量接口（估算值，字节）
+ */
+export interface MemoryUsage {
+  /** 当前合计用量 */
+  current: number;
+  /** 峰值合计用量 */
+  peak: number;
+  /** 内存上限，0 为不限制 */
+  limit: number;
+  /** 是否因超出上限降级为仅汇总模式 */
+  degraded: boolean;
+  /** 各子系统用量 */
+  subsystems: {
+    /** 硬链接去重集合 */
+    inodeSet: MemoryFigure;
+    /** 目录树节点 */
+    treeNodes: MemoryFigure;
+    /** 路径、错误等字符串 */
+    strings: MemoryFigure;
+    /** 读取缓冲区 */
+    buffers: MemoryFigure;
+    /** 待处理目录队列 */
+    queues: MemoryFigure;
+  };
+}
+
+/**
+ * 进行中扫描的内存用量（getMemoryUsage 的返回值）
+ */
+export interface ActiveMemoryUsage {
+  /** 所有进行中扫描的当前用量合计 */
+  current: number;
+  /** 各进行中扫描的用量（峰值与上限按扫描分别给出） */
+  scans: MemoryUsage[];
+}
+
+/**
+ * npm 包统计接口
+ */
+export interface PackageInfo {
+  /** 包名（pkg 或 @scope/pkg） */
+  name: string;
+  /** 版本号（来自 package.json，未找到时为空字符串） */
+  version: string;
+  /** 包目录路径 */
+  path: string;
+  /** 包大小，不含内部嵌套的 node_modules（字符串形式的数字） */
+  size: string;
+  /** 文件数量，不含内部嵌套的 node_modules */
+  fileCount: number;
+  /** 嵌套深度（路径中 node_modules 的层数） */
+  depth: number;
+  /** 包内最新的修改时间（毫秒时间戳，字符串形式的数字，含内部嵌套的 node_modules） */
+  newestModifiedTime: string;
+  /** 包内文件最新的访问时间（毫秒时间戳，字符串形式的数字，含内部嵌套的 node_modules） */
+  newestAccessedTime: string;
 }
 
 /**
@@ -26,6 +274,34 @@ export interface CalculationResult {
   directoryCount: number;
   /** 链接数量 */
   linkCount: number;
+  /** 统计范围内最新的修改时间（毫秒时间戳，字符串形式的数字，含目录自身） */
+  newestModifiedTime: string;
+  /** 统计范围内文件与链接最新的访问时间（毫秒时间戳，字符串形式的数字，不含目录） */
+  newestAccessedTime: string;
+  /** 耗时（毫秒） */
+  durationMs: number;
+  /** 错误信息 */
+  errors: string[];
+  /** 操作超时而放弃的路径，其子树未计入统计（仅设置 operationTimeoutMs 时有内容） */
+  timedOut: string[];
+  /** 是否复用了相同请求的扫描结果（合并或缓存，仅启用 coalesce 时可能为 true） */
+  coalesced: boolean;
+  /** 结果取自项目配额时的用量（此时 totalSize 为按块计算的 spaceBytes；fileCount、directoryCount、linkCount 与最新修改 / 访问时间均为 0，不表示目录为空），完整遍历时为 null */
+  quota: ProjectQuotaUsage | null;
+  /** 相同子树分组（按可回收大小降序，仅启用 detectDuplicates 时有内容） */
+  duplicateGroups: DuplicateGroup[];
+  /** 相同子树可回收总大小（字符串形式的数字） */
+  redundantSize: string;
+  /** npm 包统计（按大小降序，仅启用 aggregatePackages 时有内容） */
+  packages: PackageInfo[];
+  /** 最慢的目录（按总耗时降序，仅设置 slowDirectoryLimit 时有内容） */
+  slowDirectories: SlowDirectory[];
+  /** 各系统调用延迟统计（仅启用 latencyHistograms 时有数据） */
+  syscallLatency: SyscallLatency;
+  /** 目录树形状统计（仅启用 shapeProfile 时有数据） */
+  shape: TreeShape;
+  /** 扫描器自身内存用量 */
+  memory: MemoryUsage;
 }
 
 /**
@@ -65,10 +341,190 @@ export interface TreeNode {
   totalSize: string;
   /** 深度 */
   depth: number;
+  /** 元数据指纹（16 位十六进制，包含全部子项的名称、大小、修改时间和类型） */
+  fingerprint: string;
+  /** 子树中最新的修改时间（毫秒时间戳，字符串形式的数字，含自身） */
+  newestModifiedTime: string;
+  /** 子树中文件与链接最新的访问时间（毫秒时间戳，字符串形式的数字，不含目录） */
+  newestAccessedTime: string;
   /** 子节点 */
   children: TreeNode[];
 }
 
+/**
+ * 目录树导出格式
+ */
+export type ExportFormat = 'json' | 'ndjson' | 'snapshot';
+
+/**
+ * 目录树导出选项接口
+ */
+export interface ExportOptions extends CalculationOptions {
+  /** 导出格式：'json' 为嵌套 JSON（结构同 TreeNode），'ndjson' 为每行一个不含 children 的节点，目录在其子项之后，'snapshot' 为可由 querySnapshotAsync 查询的列式快照，默认 'json' */
+  exportFormat?: ExportFormat;
+}
+
+/**
+ * 目录树导出结果接口
+ */
+export interface ExportResult {
+  /** 导出的节点数 */
+  entryCount: number;
+  /** 写出的字节数 */
+  bytesWritten: number;
+  /** 耗时（毫秒） */
+  durationMs: number;
+  /** 导出期间扫描器自身的内存用量 */
+  memory: MemoryUsage;
+}
+
+/**
+ * 快照聚合的分组方式
+ */
+export type SnapshotGroupBy = 'none' | 'depth' | 'extension' | 'owner' | 'mtime' | 'type';
+
+/**
+ * 快照聚合查询接口
+ */
+export interface SnapshotQuery {
+  /** 分组方式，默认 'none'（其他取值抛出 TypeError） */
+  groupBy?: SnapshotGroupBy;
+  /** groupBy 为 'mtime' 时的分桶宽度（毫秒），默认一天 */
+  timeBucketMs?: number;
+  /** 只统计该路径及其子树 */
+  pathPrefix?: string;
+  /** 自身大小下限（含） */
+  minSize?: number;
+  /** 自身大小上限（含） */
+  maxSize?: number;
+  /** 只统计该类型（其他取值抛出 TypeError） */
+  type?: 'file' | 'directory' | 'symlink';
+  /** 线程数，默认为 CPU 数 */
+  threads?: number;
+}
+
+/**
+ * 快照聚合结果行接口
+ */
+export interface SnapshotAggregate {
+  /** 分组键：深度、所有者 uid、时间桶起点（毫秒）、扩展名（无扩展名为 ''）或类型；不分组时为 null */
+  key: number | string | null;
+  /** 匹配的项目数 */
+  count: number;
+  /** 匹配项目的自身大小之和（字符串形式的数字） */
+  size: string;
+  /** 匹配项目的总大小之和，目录包含子项（字符串形式的数字） */
+  totalSize: string;
+}
+
+/**
+ * 快照聚合查询结果接口
+ */
+export interface SnapshotQueryResult {
+  /** 结果行（按键升序，扩展名按大小降序） */
+  rows: SnapshotAggregate[];
+  /** 扫描的行数 */
+  scannedRows: number;
+  /** 匹配的行数 */
+  matchedRows: number;
+  /** pathPrefix 是否存在于快照中 */
+  prefixFound: boolean;
+  /** 耗时（毫秒） */
+  durationMs: number;
+}
+
+/**
+ * 快照路径查找结果接口
+ */
+export interface SnapshotNode {
+  /** 查找的路径 */
+  path: string;
+  /** 项目类型 */
+  type: ItemType;
+  /** 自身大小（字符串形式的数字） */
+  size: string;
+  /** 子树总大小（字符串形式的数字） */
+  totalSize: string;
+  /** 子孙节点数（文件为 0） */
+  descendants: number;
+  /** 修改时间（字符串形式的时间戳） */
+  modifiedTime: string;
+  /** 子树的元数据指纹（字符串形式的数字） */
+  fingerprint: string;
+}
+
+/**
+ * 内容摘要选项接口
+ */
+export interface ContentDigestOptions {
+  /** 读取线程数，默认为 CPU 数（至少 4） */
+  threads?: number;
+  /** 单次 pread 的字节数，默认 1 MiB */
+  readSize?: number;
+  /** 是否包含隐藏文件，默认 true */
+  includeHidden?: boolean;
+  /** 忽略模式（匹配完整路径） */
+  ignorePatterns?: string[];
+  /** entries 中是否包含文件（目录总是包含），默认 false */
+  includeFiles?: boolean;
+  /** 读取后是否丢弃对应的页缓存，默认 true */
+  dropCache?: boolean;
+}
+
+/**
+ * 单个项目的内容摘要接口
+ */
+export interface ContentDigestEntry {
+  /** 相对根目录的路径（根目录为 '.'） */
+  path: string;
+  /** 项目类型 */
+  type: ItemType;
+  /** 文件大小（目录为子树内文件大小之和） */
+  size: number;
+  /** BLAKE3 摘要（十六进制） */
+  digest: string;
+}
+
+/**
+ * 内容摘要结果接口
+ */
+export interface ContentDigestResult {
+  /** 摘要算法 */
+  algorithm: 'blake3';
+  /** 根摘要（十六进制） */
+  digest: string;
+  /** 各目录（及文件）的摘要，按路径先序排列 */
+  entries: ContentDigestEntry[];
+  /** 文件数 */
+  fileCount: number;
+  /** 目录数 */
+  directoryCount: number;
+  /** 符号链接数 */
+  linkCount: number;
+  /** 读取并哈希的字节数 */
+  bytesHashed: number;
+  /** 读取线程数 */
+  threads: number;
+  /** 使用的向量指令集：'avx512' | 'avx2' | 'vector' | 'portable' */
+  simd: string;
+  /** 耗时（毫秒） */
+  durationMs: number;
+  /** 错误（出错的项目在摘要中以失败标记代替，不会出现在 entries 中） */
+  errors: string[];
+}
+
+/**
+ * 目录树比较结果接口
+ */
+export interface TreeChanges {
+  /** 新增的路径 */
+  added: string[];
+  /** 删除的路径 */
+  removed: string[];
+  /** 修改的路径 */
+  modified: string[];
+}
+
 /**
  * 平台类型
  */
@@ -100,6 +556,38 @@ export declare class NativeAccelerator {
    */
   calculateFolderSize(path: string, options?: CalculationOptions): CalculationResult;
 
+  /**
+   * 异步计算文件夹大小（在工作线程中执行）
+   * @param path 文件夹路径
+   * @param options 配置选项
+   * @returns 计算结果
+   */
+  calculateFolderSizeAsync(path: string, options?: CalculationOptions): Promise<CalculationResult>;
+
+  /**
+   * 获取进行中扫描的内存用量
+   * @returns 当前用量合计与各扫描的用量
+   */
+  getMemoryUsage(): ActiveMemoryUsage;
+
+  /**
+   * 设置所有扫描共享的执行槽位数（进程级）
+   * @param capacity 槽位数
+   */
+  setSchedulerCapacity(capacity: number): void;
+
+  /**
+   * 获取扫描调度器状态
+   * @returns 调度器状态
+   */
+  getSchedulerStats(): SchedulerStats;
+
+  /**
+   * 获取进程级累计指标（扫描次数与耗时分布、项目数、字节数、按类型的错误数、系统调用次数）
+   * @returns OpenMetrics 文本格式
+   */
+  getMetrics(): string;
+
   /**
    * 构建目录树
    * @param path 目录路径
@@ -108,6 +596,16 @@ export declare class NativeAccelerator {
    */
   buildDirectoryTree(path: string, options?: CalculationOptions): TreeNode | null;
 
+  /**
+   * 异步将目录树流式导出到文件，不构建 JS 对象树
+   * @param path 目录路径
+   * @param destination 目标文件路径（先写入临时文件，导出成功后原子替换，失败时保持不变），或已打开的文件描述符（不会被关闭）
+   * @param options 导出选项
+   * @returns 导出结果
+   * @throws {TypeError} exportFormat 不是 'json'、'ndjson' 或 'snapshot'
+   */
+  exportDirectoryTreeAsync(path: string, destination: string | number, options?: ExportOptions): Promise<ExportResult>;
+
   /**
    * 检查路径是否存在
    * @param path 文件路径
@@ -147,13 +645,55 @@ export declare function isNativeAccelerationSupported(): boolean;
  */
 export declare function createAccelerator(): NativeAccelerator;
 
+/**
+ * 比较两次扫描得到的目录树，只沿指纹不一致的分支向下比较
+ * @param previous 上一次的目录树
+ * @param current 当前的目录树
+ * @returns 变化的路径
+ */
+export declare function compareTrees(previous: TreeNode | null, current: TreeNode | null): TreeChanges;
+
+/**
+ * 对列式快照执行聚合查询
+ * @param snapshotPath 快照文件路径（exportFormat: 'snapshot' 导出）
+ * @param query 查询
+ * @returns 查询结果
+ */
+export declare function querySnapshotAsync(snapshotPath: string, query?: SnapshotQuery): Promise<SnapshotQueryResult>;
+
+/**
+ * 在列式快照中查找路径，返回节点信息与子树汇总（路径不存在时为 null）
+ * @param snapshotPath 快照文件路径（exportFormat: 'snapshot' 导出）
+ * @param paths 要查找的路径
+ * @returns 查找结果，paths 为数组时返回等长数组
+ */
+export declare function lookupSnapshotPaths(snapshotPath: string, paths: string): SnapshotNode | null;
+export declare function lookupSnapshotPaths(snapshotPath: string, paths: string[]): Array<SnapshotNode | null>;
+
+/**
+ * 计算目录树（或单个文件）的内容摘要（BLAKE3 Merkle 树，目前仅支持 Linux）
+ * @param path 根路径
+ * @param options 选项
+ * @returns 摘要结果
+ */
+export declare function contentDigestAsync(path: string, options?: ContentDigestOptions): Promise<ContentDigestResult>;
+
 /**
  * 原生绑定对象（用于高级用例）
  */
 export declare const nativeBinding: {
   initializeAccelerator(): boolean;
   calculateFolderSize(path: string, options: CalculationOptions): any;
+  calculateFolderSizeAsync(path: string, options: CalculationOptions): Promise<any>;
+  getMemoryUsage(): ActiveMemoryUsage;
+  setSchedulerCapacity(capacity: number): void;
+  getSchedulerStats(): SchedulerStats;
+  getMetrics(): string;
   buildDirectoryTree(path: string, options: CalculationOptions): any;
+  exportDirectoryTreeAsync(path: string, destination: string | number, options: ExportOptions): Promise<ExportResult>;
+  querySnapshotAsync(snapshotPath: string, query: SnapshotQuery): Promise<any>;
+  lookupSnapshotPaths(snapshotPath: string, paths: string[]): any[];
+  contentDigestAsync(path: string, options: ContentDigestOptions): Promise<ContentDigestResult>;
   pathExists(path: string): boolean;
   getItemInfo(path: string, followSymlinks: boolean): any;
   cleanupAccelerator(): boolean;
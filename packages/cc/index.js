@@ -35,6 +35,25 @@ class NativeAccelerator {
    * @param {string[]} [options.ignorePatterns=[]] 忽略模式
    * @param {boolean} [options.inodeCheck=false] 是否启用硬链接检测，关闭将大幅度提升效率
    * @param {boolean} [options.includeLink=true] 是否包含符号链接大小
+   * @param {boolean} [options.detectDuplicates=false] 是否检测相同子树（Linux/macOS）
+   * @param {boolean} [options.duplicateContentHash=false] 相同子树检测是否比较文件内容
+   * @param {boolean} [options.aggregatePackages=false] 是否按 node_modules 中的 npm 包汇总（Linux/macOS）
+   * @param {number} [options.slowDirectoryLimit=0] 报告最慢目录的数量，0 为不统计（Linux/macOS）
+   * @param {boolean} [options.latencyHistograms=false] 是否统计各系统调用的延迟直方图（Linux/macOS）
+   * @param {boolean} [options.shapeProfile=false] 是否统计目录树形状（深度、扇出、路径长度分布，Linux/macOS）
+   * @param {number} [options.shapeProfileLimit=10] 形状统计中保留的最大目录与最长路径数量
+   * @param {number} [options.memoryLimit=0] 扫描器内存上限（字节），超出后降级为仅汇总模式，0 为不限制
+   * @param {number[]} [options.cpuAffinity=[]] 工作线程绑定的 CPU 列表（Linux）
+   * @param {boolean} [options.numaAware=false] 未指定 CPU 时按 NUMA 节点放置工作线程（Linux）
+   * @param {boolean} [options.includeDirectorySize=false] 目录自身大小是否计入总大小，与 get-folder 的 JS 实现口径一致（Linux/macOS）
+   * @param {number} [options.pipelineListers=0] 流水线模式的列目录线程数，0 为按目录递归遍历（Linux）
+   * @param {number} [options.pipelineStatWorkers=0] 流水线模式的 stat 线程数，0 为自动（Linux）
+   * @param {number} [options.pipelineQueueDepth=64] 流水线模式目录项批次队列的容量（Linux）
+   * @param {number} [options.operationTimeoutMs=0] 单次文件系统操作的超时时间（毫秒），超时后放弃该子树并记入 timedOut，0 为不限制（Linux，不能与 detectDuplicates、aggregatePackages、slowDirectoryLimit 同时使用）
+   * @param {boolean} [options.coalesce=false] 与进行中的相同请求（规范化路径与选项相同）合并，共享同一次扫描的结果
+   * @param {number} [options.coalesceTtlMs=0] 合并时结果的缓存时间（毫秒），期间的相同请求直接返回缓存结果
+   * @param {string} [options.priority='normal'] 与并发扫描共享执行槽位时的优先级：'interactive' | 'normal' | 'batch'
+   * @param {boolean} [options.projectQuota=false] 根目录为项目配额目录时直接读取配额用量，不遍历（Linux，需同时设置 inodeCheck 与 includeDirectorySize；结果中各项数量为 0）
    * @returns {Object} 计算结果
    */
   calculateFolderSize(path, options = {}) {
@@ -42,30 +61,65 @@ class NativeAccelerator {
       throw new Error('Accelerator not initialized');
     }
 
-    // 设置默认选项
-    const defaultOptions = {
-      includeHidden: true,
-      maxDepth: 4294967295, // UINT32_MAX
-      ignorePatterns: [],
-      inodeCheck: false,
-      includeLink: true
-    };
+    try {
+      const result = nativeBinding.calculateFolderSize(path, this._mergeCalculationOptions(options));
+      return this._convertCalculationResultBigInts(result);
+    } catch (error) {
+      throw new Error(`Failed to calculate folder size: ${error.message}`);
+    }
+  }
 
-    const mergedOptions = { ...defaultOptions, ...options };
+  /**
+   * 异步计算文件夹大小（在工作线程中执行，不阻塞事件循环）
+   * @param {string} path 文件夹路径
+   * @param {Object} [options] 配置选项，同 calculateFolderSize
+   * @returns {Promise<Object>} 计算结果
+   */
+  async calculateFolderSizeAsync(path, options = {}) {
+    if (!this.initialized) {
+      throw new Error('Accelerator not initialized');
+    }
 
     try {
-      const result = nativeBinding.calculateFolderSize(path, mergedOptions);
-      
-      // 转换 BigInt 为字符串以便 JSON 序列化
-      return {
-        ...result,
-        totalSize: result.totalSize.toString()
-      };
+      const result = await nativeBinding.calculateFolderSizeAsync(path, this._mergeCalculationOptions(options));
+      return this._convertCalculationResultBigInts(result);
     } catch (error) {
       throw new Error(`Failed to calculate folder size: ${error.message}`);
     }
   }
 
+  /**
+   * 获取进行中扫描的内存用量，可在异步扫描过程中实时查询
+   * @returns {Object} 当前用量合计 current 与各扫描的用量 scans（字节）
+   */
+  getMemoryUsage() {
+    return nativeBinding.getMemoryUsage();
+  }
+
+  /**
+   * 设置所有扫描共享的执行槽位数（进程级，默认为硬件线程数的两倍且不少于 16）
+   * @param {number} capacity 槽位数
+   */
+  setSchedulerCapacity(capacity) {
+    nativeBinding.setSchedulerCapacity(capacity);
+  }
+
+  /**
+   * 获取扫描调度器状态
+   * @returns {Object} 槽位数、已占用槽位数与等待中的线程数
+   */
+  getSchedulerStats() {
+    return nativeBinding.getSchedulerStats();
+  }
+
+  /**
+   * 获取进程级累计指标（扫描次数与耗时分布、项目数、字节数、按类型的错误数、系统调用次数）
+   * @returns {string} OpenMetrics 文本格式，可直接作为 Prometheus 抓取端点的响应
+   */
+  getMetrics() {
+    return nativeBinding.getMetrics();
+  }
+
   /**
    * 构建目录树
    * @param {string} path 目录路径
@@ -85,6 +139,30 @@ class NativeAccelerator {
     }
   }
 
+  /**
+   * 异步将目录树流式导出到文件（边遍历边写出，不构建 JS 对象树，内存用量与树的规模无关）
+   * @param {string} path 目录路径
+   * @param {string|number} destination 目标文件路径（先写入临时文件，导出成功后原子替换，失败时保持不变），或已打开的文件描述符（不会被关闭）
+   * @param {Object} [options] 配置选项，同 buildDirectoryTree
+   * @param {string} [options.exportFormat='json'] 导出格式：'json' 为与 JSON.stringify(buildDirectoryTree()) 结构一致的嵌套 JSON，'ndjson' 为每行一个节点（不含 children，目录在其子项之后），'snapshot' 为可由 querySnapshotAsync 查询的列式快照
+   * @returns {Promise<Object>} 导出的节点数、写出的字节数、耗时与内存用量
+   * @throws {TypeError} exportFormat 不是 'json'、'ndjson' 或 'snapshot'
+   */
+  async exportDirectoryTreeAsync(path, destination, options = {}) {
+    if (!this.initialized) {
+      throw new Error('Accelerator not initialized');
+    }
+
+    try {
+      return await nativeBinding.exportDirectoryTreeAsync(path, destination, options);
+    } catch (error) {
+      if (error instanceof TypeError) {
+        throw error;
+      }
+      throw new Error(`Failed to export directory tree: ${error.message}`);
+    }
+  }
+
   /**
    * 检查路径是否存在
    * @param {string} path 文件路径
@@ -135,6 +213,51 @@ class NativeAccelerator {
     }
   }
 
+  /**
+   * 合并计算选项的默认值
+   * @private
+   */
+  _mergeCalculationOptions(options) {
+    const defaultOptions = {
+      includeHidden: true,
+      maxDepth: 4294967295, // UINT32_MAX
+      ignorePatterns: [],
+      inodeCheck: false,
+      includeLink: true
+    };
+
+    return { ...defaultOptions, ...options };
+  }
+
+  /**
+   * 转换计算结果中的 BigInt 为字符串以便 JSON 序列化
+   * @private
+   */
+  _convertCalculationResultBigInts(result) {
+    return {
+      ...result,
+      totalSize: result.totalSize.toString(),
+      redundantSize: result.redundantSize.toString(),
+      newestModifiedTime: result.newestModifiedTime.toString(),
+      newestAccessedTime: result.newestAccessedTime.toString(),
+      duplicateGroups: result.duplicateGroups.map(group => ({
+        ...group,
+        size: group.size.toString(),
+        redundantSize: group.redundantSize.toString()
+      })),
+      packages: result.packages.map(pkg => ({
+        ...pkg,
+        size: pkg.size.toString(),
+        newestModifiedTime: pkg.newestModifiedTime.toString(),
+        newestAccessedTime: pkg.newestAccessedTime.toString()
+      })),
+      quota: result.quota && {
+        ...result.quota,
+        spaceBytes: result.quota.spaceBytes.toString()
+      }
+    };
+  }
+
   /**
    * 转换树节点中的 BigInt 为字符串
    * @private
@@ -145,6 +268,8 @@ class NativeAccelerator {
     const converted = {
       ...node,
       totalSize: node.totalSize.toString(),
+      newestModifiedTime: node.newestModifiedTime.toString(),
+      newestAccessedTime: node.newestAccessedTime.toString(),
       item: this._convertFileSystemItemBigInts(node.item),
       children: node.children.map(child => this._convertTreeNodeBigInts(child))
     };
@@ -168,6 +293,164 @@ class NativeAccelerator {
   }
 }
 
+/**
+ * 对列式快照（exportFormat: 'snapshot' 导出的文件）执行聚合查询
+ *
+ * 快照以只读方式内存映射，路径前缀先定位为连续的行区间，区间内的行组由多个线程并行扫描。
+ * @param {string} snapshotPath 快照文件路径
+ * @param {Object} [query] 查询
+ * @param {string} [query.groupBy='none'] 分组方式：'none' | 'depth' | 'extension' | 'owner' | 'mtime' | 'type'
+ * @param {number} [query.timeBucketMs=86400000] groupBy 为 'mtime' 时的分桶宽度（毫秒）
+ * @param {string} [query.pathPrefix] 只统计该路径及其子树
+ * @param {number} [query.minSize] 自身大小下限（含）
+ * @param {number} [query.maxSize] 自身大小上限（含）
+ * @param {string} [query.type] 只统计该类型：'file' | 'directory' | 'symlink'
+ * @param {number} [query.threads] 线程数（默认为 CPU 数）
+ * @returns {Promise<Object>} 各分组的行数与大小之和，以及扫描行数、匹配行数与耗时
+ * @throws {TypeError} groupBy 或 type 不是上述取值之一
+ */
+async function querySnapshotAsync(snapshotPath, query = {}) {
+  if (!nativeBinding) {
+    throw new Error('Native binding not available');
+  }
+
+  try {
+    const result = await nativeBinding.querySnapshotAsync(snapshotPath, query);
+    result.rows = result.rows.map(row => ({
+      key: row.key,
+      count: row.count,
+      size: row.size.toString(),
+      totalSize: row.totalSize.toString()
+    }));
+    return result;
+  } catch (error) {
+    if (error instanceof TypeError) {
+      throw error;
+    }
+    throw new Error(`Failed to query snapshot: ${error.message}`);
+  }
+}
+
+/**
+ * 在列式快照中查找路径，返回节点信息与子树汇总
+ *
+ * 快照中每个目录保存按名称排序的子项表，查找时逐级二分，不扫描快照；
+ * 打开的快照按路径缓存并内存映射，文件被替换后自动重新加载。
+ * @param {string} snapshotPath 快照文件路径
+ * @param {string|string[]} paths 要查找的路径
+ * @returns {Object|null|Array<Object|null>} 节点信息（路径不存在时为 null），paths 为数组时返回等长数组
+ */
+function lookupSnapshotPaths(snapshotPath, paths) {
+  if (!nativeBinding) {
+    throw new Error('Native binding not available');
+  }
+
+  const single = !Array.isArray(paths);
+  try {
+    const results = nativeBinding.lookupSnapshotPaths(snapshotPath, single ? [paths] : paths).map(node => node && {
+      path: node.path,
+      type: node.type,
+      size: node.size.toString(),
+      totalSize: node.totalSize.toString(),
+      descendants: node.descendants,
+      modifiedTime: node.modifiedTime.toString(),
+      fingerprint: node.fingerprint.toString()
+    });
+    return single ? results[0] : results;
+  } catch (error) {
+    throw new Error(`Failed to look up snapshot: ${error.message}`);
+  }
+}
+
+/**
+ * 计算目录树（或单个文件）的内容摘要（BLAKE3 Merkle 树，目前仅支持 Linux）
+ *
+ * 文件摘要为文件内容的 BLAKE3（与 b3sum 一致），符号链接为链接目标的 BLAKE3，
+ * 目录摘要由按名称排序的子项 (类型, 名称, 摘要) 组成，与遍历顺序和线程数无关。
+ * 多个线程以大块 pread 并行读取文件，大文件切成片段分给不同线程，读取后丢弃页缓存。
+ * @param {string} path 根路径
+ * @param {Object} [options] 选项
+ * @param {number} [options.threads] 读取线程数（默认为 CPU 数，至少 4）
+ * @param {number} [options.readSize=1048576] 单次读取的字节数
+ * @param {boolean} [options.includeHidden=true] 是否包含隐藏文件
+ * @param {string[]} [options.ignorePatterns] 忽略模式（匹配完整路径）
+ * @param {boolean} [options.includeFiles=false] entries 中是否包含文件（目录总是包含）
+ * @param {boolean} [options.dropCache=true] 读取后是否丢弃对应的页缓存
+ * @returns {Promise<Object>} 根摘要、各目录（及文件）的摘要与统计；errors 非空时出错的项目在摘要中以失败标记代替
+ */
+async function contentDigestAsync(path, options = {}) {
+  if (!nativeBinding) {
+    throw new Error('Native binding not available');
+  }
+
+  try {
+    return await nativeBinding.contentDigestAsync(path, options);
+  } catch (error) {
+    throw new Error(`Failed to compute content digest: ${error.message}`);
+  }
+}
+
+/**
+ * 比较两次扫描得到的目录树
+ *
+ * 利用节点的元数据指纹（Merkle 结构），只沿指纹不一致的分支向下比较，
+ * 指纹相同的子树直接跳过。目录树可序列化保存，作为下次比较的快照。
+ * @param {Object} previous 上一次的目录树
+ * @param {Object} current 当前的目录树
+ * @returns {{added: string[], removed: string[], modified: string[]}} 变化的路径
+ */
+function compareTrees(previous, current) {
+  const changes = { added: [], removed: [], modified: [] };
+
+  const collect = (node, target) => {
+    target.push(node.item.path);
+  };
+
+  const visit = (before, after) => {
+    if (before.fingerprint === after.fingerprint) {
+      return;
+    }
+
+    // 类型变化或非目录节点，直接视为修改
+    if (before.item.type !== after.item.type || after.item.type !== 'directory') {
+      changes.modified.push(after.item.path);
+      return;
+    }
+
+    const beforeChildren = new Map(before.children.map(child => [child.item.name, child]));
+    const changedCount = changes.added.length + changes.removed.length + changes.modified.length;
+
+    for (const child of after.children) {
+      const match = beforeChildren.get(child.item.name);
+      if (match) {
+        beforeChildren.delete(child.item.name);
+        visit(match, child);
+      } else {
+        collect(child, changes.added);
+      }
+    }
+
+    for (const child of beforeChildren.values()) {
+      collect(child, changes.removed);
+    }
+
+    // 子项均未变化，说明目录自身元数据发生变化
+    if (changes.added.length + changes.removed.length + changes.modified.length === changedCount) {
+      changes.modified.push(after.item.path);
+    }
+  };
+
+  if (previous && current) {
+    visit(previous, current);
+  } else if (current) {
+    collect(current, changes.added);
+  } else if (previous) {
+    collect(previous, changes.removed);
+  }
+
+  return changes;
+}
+
 /**
  * 获取平台信息
  * @returns {string} 平台名称
@@ -219,6 +502,10 @@ module.exports = {
   createAccelerator,
   getPlatform,
   isNativeAccelerationSupported,
+  compareTrees,
+  querySnapshotAsync,
+  lookupSnapshotPaths,
+  contentDigestAsync,
   
   // 直接导出原生绑定（用于高级用例）
   nativeBinding
@@ -0,0 +1,91 @@
+#!/usr/bin/env node
+
+/**
+ * 编译并运行 test/native 下的 C++ 单元测试（不依赖 Node，只链接 binding.gyp 中 main.cpp 以外的源文件）
+ *
+ * 用法: node scripts/test-native.js [测试名...]
+ * 环境变量 CXX 指定编译器，默认为 c++
+ */
+
+const { execFileSync } = require('child_process');
+const path = require('path');
+const fs = require('fs');
+const os = require('os');
+
+const ROOT = path.join(__dirname, '..');
+const TEST_DIR = path.join(ROOT, 'test', 'native');
+
+function log(message) {
+  console.log(`[CC Native Test] ${message}`);
+}
+
+/**
+ * 读取 binding.gyp 中的源文件（不含 N-API 入口）
+ */
+function librarySources() {
+  const gyp = JSON.parse(fs.readFileSync(path.join(ROOT, 'binding.gyp'), 'utf8'));
+  return gyp.targets[0].sources.filter(source => source !== 'src/main.cpp');
+}
+
+function platformDefine() {
+  switch (process.platform) {
+    case 'linux': return 'PLATFORM_LINUX';
+    case 'darwin': return 'PLATFORM_MACOS';
+    default: return null;
+  }
+}
+
+function main() {
+  const define = platformDefine();
+  if (!define) {
+    log(`⚠️  ${process.platform} 暂不支持原生单元测试，跳过`);
+    return;
+  }
+
+  const filter = process.argv.slice(2);
+  const tests = fs.readdirSync(TEST_DIR)
+    .filter(file => file.endsWith('_test.cpp'))
+    .filter(file => filter.length === 0 || filter.includes(path.basename(file, '.cpp')));
+
+  const compiler = process.env.CXX || 'c++';
+  const outDir = fs.mkdtempSync(path.join(os.tmpdir(), 'brisk-cc-native-test-'));
+  let failed = 0;
+
+  try {
+    for (const file of tests) {
+      const name = path.basename(file, '.cpp');
+      const binary = path.join(outDir, name);
+
+      log(`🔨 编译 ${name}...`);
+      execFileSync(compiler, [
+        '-std=c++17', '-O1', '-g', `-D${define}`, '-pthread',
+        '-Isrc', '-Isrc/common', '-Itest/native',
+        path.join('test', 'native', file),
+        ...librarySources(),
+        '-o', binary
+      ], { stdio: 'inherit', cwd: ROOT });
+
+      log(`🧪 运行 ${name}...`);
+      try {
+        execFileSync(binary, [], { stdio: 'inherit', cwd: ROOT });
+        log(`✅ ${name} 通过`);
+      } catch (error) {
+        log(`❌ ${name} 失败`);
+        failed++;
+      }
+    }
+  } finally {
+    fs.rmSync(outDir, { recursive: true, force: true });
+  }
+
+  if (failed > 0) {
+    process.exit(1);
+  }
+  log('🎉 全部原生单元测试通过');
+}
+
+if (require.main === module) {
+  main();
+}
+
+module.exports = { librarySources };
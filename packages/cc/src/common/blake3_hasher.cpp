@@ -0,0 +1,545 @@
+#include "blake3_hasher.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define BLAKE3_VECTOR 1
+#define BLAKE3_INLINE inline __attribute__((always_inline))
+#else
+#define BLAKE3_VECTOR 0
+#define BLAKE3_INLINE inline
+#endif
+
+#if BLAKE3_VECTOR && (defined(__x86_64__) || defined(__i386__))
+#define BLAKE3_DISPATCH_AVX2 1
+#else
+#define BLAKE3_DISPATCH_AVX2 0
+#endif
+
+// 完全展开 7 轮，使消息字下标成为常量、状态留在寄存器中
+#if defined(__GNUC__) || defined(__clang__)
+#define BLAKE3_UNROLL_ROUNDS _Pragma("GCC unroll 7")
+#else
+#define BLAKE3_UNROLL_ROUNDS
+#endif
+
+namespace brisk {
+namespace filesystem {
+
+namespace {
+
+const uint32_t IV[8] = {
+    0x6A09E667UL, 0xBB67AE85UL, 0x3C6EF372UL, 0xA54FF53AUL,
+    0x510E527FUL, 0x9B05688CUL, 0x1F83D9ABUL, 0x5BE0CD19UL
+};
+
+// 每一轮使用的消息字顺序（第 0 轮为原始顺序，之后每轮按固定置换）
+const uint8_t MSG_SCHEDULE[7][16] = {
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+    {2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8},
+    {3, 4, 10, 12, 13, 2, 7, 14, 6, 5, 9, 0, 11, 15, 8, 1},
+    {10, 7, 12, 9, 14, 3, 13, 15, 4, 0, 11, 2, 5, 8, 1, 6},
+    {12, 13, 9, 11, 15, 10, 14, 8, 7, 2, 5, 3, 0, 1, 6, 4},
+    {9, 14, 11, 5, 8, 12, 15, 1, 13, 3, 0, 10, 2, 6, 4, 7},
+    {11, 15, 5, 0, 1, 9, 8, 6, 14, 10, 2, 12, 3, 4, 7, 13},
+};
+
+enum : uint8_t {
+    CHUNK_START = 1 << 0,
+    CHUNK_END = 1 << 1,
+    PARENT = 1 << 2,
+    ROOT = 1 << 3
+};
+
+constexpr size_t BLOCKS_PER_CHUNK = Blake3Hasher::CHUNK_LEN / Blake3Hasher::BLOCK_LEN;
+constexpr size_t BATCH_CHUNKS = 64;     // 一次并行压缩的最大分块数
+
+BLAKE3_INLINE uint32_t load32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+BLAKE3_INLINE void loadBlock(const uint8_t* block, uint32_t m[16]) {
+    for (int i = 0; i < 16; ++i) {
+        m[i] = load32(block + i * 4);
+    }
+}
+
+BLAKE3_INLINE uint32_t rotr(uint32_t x, int n) {
+    return (x >> n) | (x << (32 - n));
+}
+
+BLAKE3_INLINE void g(uint32_t* v, int a, int b, int c, int d, uint32_t x, uint32_t y) {
+    v[a] = v[a] + v[b] + x;
+    v[d] = rotr(v[d] ^ v[a], 16);
+    v[c] = v[c] + v[d];
+    v[b] = rotr(v[b] ^ v[c], 12);
+    v[a] = v[a] + v[b] + y;
+    v[d] = rotr(v[d] ^ v[a], 8);
+    v[c] = v[c] + v[d];
+    v[b] = rotr(v[b] ^ v[c], 7);
+}
+
+/**
+ * 压缩函数（标量）
+ * @param cv 输入链值
+ * @param m 消息字
+ * @param counter 计数器
+ * @param block_len 块内有效字节数
+ * @param flags 域标志
+ * @param out 输出（前 8 字为新链值）
+ */
+void compress(const uint32_t cv[8], const uint32_t m[16], uint64_t counter, uint32_t block_len,
+              uint32_t flags, uint32_t out[16]) {
+    uint32_t v[16] = {
+        cv[0], cv[1], cv[2], cv[3], cv[4], cv[5], cv[6], cv[7],
+        IV[0], IV[1], IV[2], IV[3],
+        static_cast<uint32_t>(counter), static_cast<uint32_t>(counter >> 32), block_len, flags
+    };
+    BLAKE3_UNROLL_ROUNDS
+    for (const auto& s : MSG_SCHEDULE) {
+        g(v, 0, 4, 8, 12, m[s[0]], m[s[1]]);
+        g(v, 1, 5, 9, 13, m[s[2]], m[s[3]]);
+        g(v, 2, 6, 10, 14, m[s[4]], m[s[5]]);
+        g(v, 3, 7, 11, 15, m[s[6]], m[s[7]]);
+        g(v, 0, 5, 10, 15, m[s[8]], m[s[9]]);
+        g(v, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+        g(v, 2, 7, 8, 13, m[s[12]], m[s[13]]);
+        g(v, 3, 4, 9, 14, m[s[14]], m[s[15]]);
+    }
+    for (int i = 0; i < 8; ++i) {
+        out[i] = v[i] ^ v[i + 8];
+        out[i + 8] = v[i + 8] ^ cv[i];
+    }
+}
+
+/**
+ * 计算父节点链值
+ */
+void parentValue(const uint32_t left[8], const uint32_t right[8], uint32_t cv[8]) {
+    uint32_t m[16];
+    std::memcpy(m, left, 8 * sizeof(uint32_t));
+    std::memcpy(m + 8, right, 8 * sizeof(uint32_t));
+    uint32_t out[16];
+    compress(IV, m, 0, Blake3Hasher::BLOCK_LEN, PARENT, out);
+    std::memcpy(cv, out, 8 * sizeof(uint32_t));
+}
+
+/**
+ * 压缩一个完整分块（标量）
+ */
+void hashChunk(const uint8_t* input, uint64_t counter, uint32_t cv[8]) {
+    std::memcpy(cv, IV, sizeof(IV));
+    for (size_t b = 0; b < BLOCKS_PER_CHUNK; ++b) {
+        uint32_t m[16];
+        loadBlock(input + b * Blake3Hasher::BLOCK_LEN, m);
+        uint32_t flags = (b == 0 ? CHUNK_START : 0) | (b == BLOCKS_PER_CHUNK - 1 ? CHUNK_END : 0);
+        uint32_t out[16];
+        compress(cv, m, counter, Blake3Hasher::BLOCK_LEN, flags, out);
+        std::memcpy(cv, out, 8 * sizeof(uint32_t));
+    }
+}
+
+#if BLAKE3_VECTOR
+
+typedef uint32_t u32x8 __attribute__((vector_size(32)));
+typedef uint32_t u32x16 __attribute__((vector_size(64)));
+
+#define BLAKE3_ROTR(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+template <typename V>
+BLAKE3_INLINE void gv(V* v, int a, int b, int c, int d, const V& x, const V& y) {
+    v[a] = v[a] + v[b] + x;
+    v[d] = BLAKE3_ROTR(v[d] ^ v[a], 16);
+    v[c] = v[c] + v[d];
+    v[b] = BLAKE3_ROTR(v[b] ^ v[c], 12);
+    v[a] = v[a] + v[b] + y;
+    v[d] = BLAKE3_ROTR(v[d] ^ v[a], 8);
+    v[c] = v[c] + v[d];
+    v[b] = BLAKE3_ROTR(v[b] ^ v[c], 7);
+}
+
+#if defined(__has_builtin) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#if __has_builtin(__builtin_shufflevector)
+#define BLAKE3_TRANSPOSE 1
+#endif
+#endif
+
+/**
+ * 读取 8 个分块中同一块的 8 个消息字：m[w] 的第 i 路为第 i 个分块的第 w 个字
+ * @param block 第一个分块中该块（或该块后半）的地址
+ * @param m 输出的 8 个向量
+ */
+BLAKE3_INLINE void loadWords(const uint8_t* block, u32x8* m) {
+#ifdef BLAKE3_TRANSPOSE
+    // 每个分块连续读 32 字节，再做 8x8 转置（32 位、64 位、128 位三级交错）
+    u32x8 r[8];
+    for (int lane = 0; lane < 8; ++lane) {
+        std::memcpy(&r[lane], block + lane * Blake3Hasher::CHUNK_LEN, sizeof(u32x8));
+    }
+    u32x8 t[8];
+    for (int i = 0; i < 8; i += 2) {
+        t[i] = __builtin_shufflevector(r[i], r[i + 1], 0, 8, 1, 9, 4, 12, 5, 13);
+        t[i + 1] = __builtin_shufflevector(r[i], r[i + 1], 2, 10, 3, 11, 6, 14, 7, 15);
+    }
+    u32x8 u[8];
+    for (int i = 0; i < 8; i += 4) {
+        u[i] = __builtin_shufflevector(t[i], t[i + 2], 0, 1, 8, 9, 4, 5, 12, 13);
+        u[i + 1] = __builtin_shufflevector(t[i], t[i + 2], 2, 3, 10, 11, 6, 7, 14, 15);
+        u[i + 2] = __builtin_shufflevector(t[i + 1], t[i + 3], 0, 1, 8, 9, 4, 5, 12, 13);
+        u[i + 3] = __builtin_shufflevector(t[i + 1], t[i + 3], 2, 3, 10, 11, 6, 7, 14, 15);
+    }
+    for (int i = 0; i < 4; ++i) {
+        m[i] = __builtin_shufflevector(u[i], u[i + 4], 0, 1, 2, 3, 8, 9, 10, 11);
+        m[i + 4] = __builtin_shufflevector(u[i], u[i + 4], 4, 5, 6, 7, 12, 13, 14, 15);
+    }
+#else
+    for (int w = 0; w < 8; ++w) {
+        for (int lane = 0; lane < 8; ++lane) {
+            m[w][lane] = load32(block + lane * Blake3Hasher::CHUNK_LEN + w * 4);
+        }
+    }
+#endif
+}
+
+/**
+ * 读取 16 个分块中同一块的 8 个消息字（前后 8 个分块分别转置后拼接）
+ */
+BLAKE3_INLINE void loadWords(const uint8_t* block, u32x16* m) {
+#ifdef BLAKE3_TRANSPOSE
+    u32x8 low[8];
+    u32x8 high[8];
+    loadWords(block, low);
+    loadWords(block + 8 * Blake3Hasher::CHUNK_LEN, high);
+    for (int w = 0; w < 8; ++w) {
+        m[w] = __builtin_shufflevector(low[w], high[w], 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    }
+#else
+    for (int w = 0; w < 8; ++w) {
+        for (int lane = 0; lane < 16; ++lane) {
+            m[w][lane] = load32(block + lane * Blake3Hasher::CHUNK_LEN + w * 4);
+        }
+    }
+#endif
+}
+
+/**
+ * 同时压缩 LANES 个相邻的完整分块：每个向量的第 i 路对应第 i 个分块
+ * @param input 分块的起始地址
+ * @param counter 第一个分块的序号
+ * @param cvs 输出的链值
+ */
+template <typename V, int LANES>
+BLAKE3_INLINE void hashChunksBody(const uint8_t* input, uint64_t counter, uint32_t cvs[][8]) {
+    V h[8];
+    for (int i = 0; i < 8; ++i) {
+        h[i] = V{} + IV[i];
+    }
+    V counter_low;
+    V counter_high;
+    for (int lane = 0; lane < LANES; ++lane) {
+        counter_low[lane] = static_cast<uint32_t>(counter + lane);
+        counter_high[lane] = static_cast<uint32_t>((counter + lane) >> 32);
+    }
+
+    for (size_t b = 0; b < BLOCKS_PER_CHUNK; ++b) {
+        V m[16];
+        const uint8_t* block = input + b * Blake3Hasher::BLOCK_LEN;
+        loadWords(block, m);
+        loadWords(block + 32, m + 8);
+
+        uint32_t flags = (b == 0 ? CHUNK_START : 0) | (b == BLOCKS_PER_CHUNK - 1 ? CHUNK_END : 0);
+        V v[16] = {
+            h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7],
+            V{} + IV[0], V{} + IV[1], V{} + IV[2], V{} + IV[3],
+            counter_low, counter_high,
+            V{} + static_cast<uint32_t>(Blake3Hasher::BLOCK_LEN), V{} + flags
+        };
+        BLAKE3_UNROLL_ROUNDS
+        for (const auto& s : MSG_SCHEDULE) {
+            gv(v, 0, 4, 8, 12, m[s[0]], m[s[1]]);
+            gv(v, 1, 5, 9, 13, m[s[2]], m[s[3]]);
+            gv(v, 2, 6, 10, 14, m[s[4]], m[s[5]]);
+            gv(v, 3, 7, 11, 15, m[s[6]], m[s[7]]);
+            gv(v, 0, 5, 10, 15, m[s[8]], m[s[9]]);
+            gv(v, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+            gv(v, 2, 7, 8, 13, m[s[12]], m[s[13]]);
+            gv(v, 3, 4, 9, 14, m[s[14]], m[s[15]]);
+        }
+        for (int i = 0; i < 8; ++i) {
+            h[i] = v[i] ^ v[i + 8];
+        }
+    }
+
+    for (int lane = 0; lane < LANES; ++lane) {
+        for (int i = 0; i < 8; ++i) {
+            cvs[lane][i] = h[i][lane];
+        }
+    }
+}
+
+void hashChunks8(const uint8_t* input, uint64_t counter, uint32_t cvs[][8]) {
+    hashChunksBody<u32x8, 8>(input, counter, cvs);
+}
+
+#if BLAKE3_DISPATCH_AVX2
+__attribute__((target("avx2"))) void hashChunks8Avx2(const uint8_t* input, uint64_t counter, uint32_t cvs[][8]) {
+    hashChunksBody<u32x8, 8>(input, counter, cvs);
+}
+
+__attribute__((target("avx512f"))) void hashChunks16Avx512(const uint8_t* input, uint64_t counter,
+                                                           uint32_t cvs[][8]) {
+    hashChunksBody<u32x16, 16>(input, counter, cvs);
+}
+
+/**
+ * 运行时检测的指令集等级（0 为通用向量，1 为 AVX2，2 为 AVX-512）
+ */
+int simdLevel() {
+    static const int level = []() {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) {
+            return 2;
+        }
+        return __builtin_cpu_supports("avx2") ? 1 : 0;
+    }();
+    return level;
+}
+#endif
+
+#endif
+
+/**
+ * 压缩若干相邻的完整分块：按指令集 16 个或 8 个一组并行处理，余下的逐个处理
+ * @param input 分块起始地址
+ * @param count 分块数
+ * @param counter 第一个分块的序号
+ * @param cvs 输出的链值
+ */
+void hashChunks(const uint8_t* input, size_t count, uint64_t counter, uint32_t cvs[][8]) {
+    size_t i = 0;
+#if BLAKE3_VECTOR
+    void (*hash8)(const uint8_t*, uint64_t, uint32_t[][8]) = hashChunks8;
+#if BLAKE3_DISPATCH_AVX2
+    int level = simdLevel();
+    if (level >= 2) {
+        for (; i + 16 <= count; i += 16) {
+            hashChunks16Avx512(input + i * Blake3Hasher::CHUNK_LEN, counter + i, cvs + i);
+        }
+    }
+    if (level >= 1) {
+        hash8 = hashChunks8Avx2;
+    }
+#endif
+    for (; i + 8 <= count; i += 8) {
+        hash8(input + i * Blake3Hasher::CHUNK_LEN, counter + i, cvs + i);
+    }
+#endif
+    for (; i < count; ++i) {
+        hashChunk(input + i * Blake3Hasher::CHUNK_LEN, counter + i, cvs[i]);
+    }
+}
+
+/**
+ * 以小端序输出前 8 个字
+ */
+void storeDigest(const uint32_t words[16], uint8_t out[Blake3Hasher::OUT_LEN]) {
+    for (size_t i = 0; i < 8; ++i) {
+        out[i * 4] = static_cast<uint8_t>(words[i]);
+        out[i * 4 + 1] = static_cast<uint8_t>(words[i] >> 8);
+        out[i * 4 + 2] = static_cast<uint8_t>(words[i] >> 16);
+        out[i * 4 + 3] = static_cast<uint8_t>(words[i] >> 24);
+    }
+}
+
+} // namespace
+
+Blake3Hasher::Blake3Hasher() : cv_stack_len_(0) {
+    resetChunk(0);
+}
+
+Blake3Hasher::Blake3Hasher(uint64_t chunk_counter) : cv_stack_len_(0) {
+    resetChunk(chunk_counter);
+}
+
+size_t Blake3Hasher::chunkBytes() const {
+    return static_cast<size_t>(blocks_compressed_) * BLOCK_LEN + block_len_;
+}
+
+void Blake3Hasher::resetChunk(uint64_t counter) {
+    std::memcpy(chunk_cv_, IV, sizeof(IV));
+    chunk_counter_ = counter;
+    std::memset(block_, 0, sizeof(block_));
+    block_len_ = 0;
+    blocks_compressed_ = 0;
+}
+
+void Blake3Hasher::updateChunk(const uint8_t* input, size_t length) {
+    while (length > 0) {
+        // 块已满且还有后续数据时才压缩，最后一块留到结束时带 CHUNK_END 压缩
+        if (block_len_ == BLOCK_LEN) {
+            uint32_t m[16];
+            loadBlock(block_, m);
+            uint32_t out[16];
+            compress(chunk_cv_, m, chunk_counter_, BLOCK_LEN, blocks_compressed_ == 0 ? CHUNK_START : 0, out);
+            std::memcpy(chunk_cv_, out, sizeof(chunk_cv_));
+            ++blocks_compressed_;
+            std::memset(block_, 0, sizeof(block_));
+            block_len_ = 0;
+        }
+        size_t take = std::min(BLOCK_LEN - block_len_, length);
+        std::memcpy(block_ + block_len_, input, take);
+        block_len_ = static_cast<uint8_t>(block_len_ + take);
+        input += take;
+        length -= take;
+    }
+}
+
+void Blake3Hasher::pushChunkValue(const uint32_t cv[8], uint64_t total_chunks) {
+    // total_chunks 末尾每有一个 0，就有一棵同样大小的左子树可以合并
+    uint32_t value[8];
+    std::memcpy(value, cv, sizeof(value));
+    while ((total_chunks & 1) == 0) {
+        --cv_stack_len_;
+        parentValue(cv_stack_[cv_stack_len_], value, value);
+        total_chunks >>= 1;
+    }
+    std::memcpy(cv_stack_[cv_stack_len_], value, sizeof(value));
+    ++cv_stack_len_;
+}
+
+void Blake3Hasher::update(const void* data, size_t length) {
+    const uint8_t* input = static_cast<const uint8_t*>(data);
+
+    while (length > 0) {
+        // 当前分块已满且还有后续数据：它不是最后一块，可以结束并入栈
+        if (chunkBytes() == CHUNK_LEN) {
+            uint32_t m[16];
+            loadBlock(block_, m);
+            uint32_t out[16];
+            compress(chunk_cv_, m, chunk_counter_, BLOCK_LEN, CHUNK_END, out);
+            pushChunkValue(out, chunk_counter_ + 1);
+            resetChunk(chunk_counter_ + 1);
+        }
+
+        // 分块边界上的整块数据批量并行压缩，至少留下 1 字节给最后的分块
+        if (chunkBytes() == 0 && length > CHUNK_LEN) {
+            size_t chunks = std::min((length - 1) / CHUNK_LEN, BATCH_CHUNKS);
+            uint32_t cvs[BATCH_CHUNKS][8];
+            hashChunks(input, chunks, chunk_counter_, cvs);
+            for (size_t i = 0; i < chunks; ++i) {
+                pushChunkValue(cvs[i], chunk_counter_ + i + 1);
+            }
+            resetChunk(chunk_counter_ + chunks);
+            input += chunks * CHUNK_LEN;
+            length -= chunks * CHUNK_LEN;
+            continue;
+        }
+
+        size_t take = std::min(CHUNK_LEN - chunkBytes(), length);
+        updateChunk(input, take);
+        input += take;
+        length -= take;
+    }
+}
+
+void Blake3Hasher::finalOutput(uint32_t cv[8], uint32_t m[16], uint32_t& block_len, uint32_t& flags) const {
+    // 从当前分块的输出开始，自右向左与栈中的子树合并，留下最后一次压缩的输入
+    std::memcpy(cv, chunk_cv_, sizeof(chunk_cv_));
+    loadBlock(block_, m);
+    block_len = block_len_;
+    flags = CHUNK_END | (blocks_compressed_ == 0 ? CHUNK_START : 0);
+    uint64_t counter = chunk_counter_;
+
+    for (size_t i = cv_stack_len_; i > 0; --i) {
+        uint32_t output[16];
+        compress(cv, m, counter, block_len, flags, output);
+        std::memcpy(m, cv_stack_[i - 1], 8 * sizeof(uint32_t));
+        std::memcpy(m + 8, output, 8 * sizeof(uint32_t));
+        std::memcpy(cv, IV, sizeof(IV));
+        block_len = BLOCK_LEN;
+        flags = PARENT;
+        counter = 0;
+    }
+}
+
+void Blake3Hasher::finalize(uint8_t out[OUT_LEN]) const {
+    uint32_t cv[8];
+    uint32_t m[16];
+    uint32_t block_len;
+    uint32_t flags;
+    finalOutput(cv, m, block_len, flags);
+
+    uint32_t root[16];
+    compress(cv, m, 0, block_len, flags | ROOT, root);
+    storeDigest(root, out);
+}
+
+void Blake3Hasher::finalizeSubtree(uint32_t cv[8]) const {
+    uint32_t input_cv[8];
+    uint32_t m[16];
+    uint32_t block_len;
+    uint32_t flags;
+    finalOutput(input_cv, m, block_len, flags);
+
+    // 未与栈合并时最后一次压缩属于当前分块，计数器为分块序号；父节点的计数器为 0
+    uint32_t output[16];
+    compress(input_cv, m, cv_stack_len_ == 0 ? chunk_counter_ : 0, block_len, flags, output);
+    std::memcpy(cv, output, 8 * sizeof(uint32_t));
+}
+
+void Blake3Hasher::combineSegments(const std::vector<std::array<uint32_t, 8>>& segments, const uint32_t tail[8],
+                                   uint8_t out[OUT_LEN]) {
+    // 片段大小相同且为 2 的幂时，以片段为叶子的合并方式与以分块为叶子一致：与 pushChunkValue 相同的栈式合并
+    std::vector<std::array<uint32_t, 8>> stack;
+    for (size_t i = 0; i < segments.size(); ++i) {
+        std::array<uint32_t, 8> value = segments[i];
+        for (uint64_t total = i + 1; (total & 1) == 0; total >>= 1) {
+            parentValue(stack.back().data(), value.data(), value.data());
+            stack.pop_back();
+        }
+        stack.push_back(value);
+    }
+
+    // 自右向左与尾部片段合并，最底层的父节点即根节点
+    uint32_t right[8];
+    std::memcpy(right, tail, sizeof(right));
+    for (size_t i = stack.size(); i > 1; --i) {
+        parentValue(stack[i - 1].data(), right, right);
+    }
+    uint32_t m[16];
+    std::memcpy(m, stack[0].data(), 8 * sizeof(uint32_t));
+    std::memcpy(m + 8, right, 8 * sizeof(uint32_t));
+    uint32_t root[16];
+    compress(IV, m, 0, BLOCK_LEN, PARENT | ROOT, root);
+    storeDigest(root, out);
+}
+
+void Blake3Hasher::hash(const void* data, size_t length, uint8_t out[OUT_LEN]) {
+    Blake3Hasher hasher;
+    hasher.update(data, length);
+    hasher.finalize(out);
+}
+
+std::string Blake3Hasher::toHex(const uint8_t digest[OUT_LEN]) {
+    static const char digits[] = "0123456789abcdef";
+    std::string hex(OUT_LEN * 2, '0');
+    for (size_t i = 0; i < OUT_LEN; ++i) {
+        hex[i * 2] = digits[digest[i] >> 4];
+        hex[i * 2 + 1] = digits[digest[i] & 0x0f];
+    }
+    return hex;
+}
+
+const char* Blake3Hasher::implementation() {
+#if BLAKE3_DISPATCH_AVX2
+    int level = simdLevel();
+    if (level > 0) {
+        return level == 2 ? "avx512" : "avx2";
+    }
+#endif
+    return BLAKE3_VECTOR ? "vector" : "portable";
+}
+
+} // namespace filesystem
+} // namespace brisk
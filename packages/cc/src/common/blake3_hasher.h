@@ -0,0 +1,104 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace brisk {
+namespace filesystem {
+
+/**
+ * BLAKE3 哈希（32 字节输出，无密钥模式）
+ *
+ * 输入按 1 KiB 分块，每块独立压缩后按二叉树合并。update 一次收到多个完整分块时，
+ * 用 GCC/Clang 向量扩展同时压缩 8 个分块（x86-64 上运行时检测 AVX2，支持 AVX-512 时每次 16 个），
+ * 其余情况（不足一组的分块、尾部分块、父节点）走标量实现。输出与官方参考实现一致。
+ *
+ * 按 2 的幂个分块对齐切分的片段是最终哈希树的子树，可以由不同线程分别计算
+ * （Blake3Hasher(chunk_counter) + finalizeSubtree），再由 combineSegments 合并为整体哈希。
+ */
+class Blake3Hasher {
+public:
+    static constexpr size_t OUT_LEN = 32;       // 输出长度（字节）
+    static constexpr size_t BLOCK_LEN = 64;     // 压缩块长度（字节）
+    static constexpr size_t CHUNK_LEN = 1024;   // 分块长度（字节）
+
+private:
+    static constexpr size_t MAX_DEPTH = 54;     // 链值栈深度上限（2^54 个分块）
+
+    uint32_t chunk_cv_[8];                      // 当前分块的链值
+    uint64_t chunk_counter_;                    // 当前分块序号
+    uint8_t block_[BLOCK_LEN];                  // 当前分块未压缩的数据
+    uint8_t block_len_;                         // block_ 中的字节数
+    uint8_t blocks_compressed_;                 // 当前分块已压缩的块数
+    uint32_t cv_stack_[MAX_DEPTH][8];           // 已完成子树的链值栈
+    uint8_t cv_stack_len_;                      // 栈中的链值数
+
+    size_t chunkBytes() const;
+    void resetChunk(uint64_t counter);
+    void updateChunk(const uint8_t* input, size_t length);
+    void pushChunkValue(const uint32_t cv[8], uint64_t total_chunks);
+    void finalOutput(uint32_t cv[8], uint32_t m[16], uint32_t& block_len, uint32_t& flags) const;
+
+public:
+    Blake3Hasher();
+
+    /**
+     * 从指定分块序号开始计算（用于片段）
+     * @param chunk_counter 片段第一个分块在整个输入中的序号
+     */
+    explicit Blake3Hasher(uint64_t chunk_counter);
+
+    /**
+     * 追加数据
+     * @param data 数据指针
+     * @param length 数据长度
+     */
+    void update(const void* data, size_t length);
+
+    /**
+     * 输出哈希值（不改变状态，可继续 update）
+     * @param out 输出缓冲区（OUT_LEN 字节）
+     */
+    void finalize(uint8_t out[OUT_LEN]) const;
+
+    /**
+     * 输出已追加的数据作为子树时的链值（不带根节点标志），至少需追加 1 字节
+     * @param cv 输出的链值
+     */
+    void finalizeSubtree(uint32_t cv[8]) const;
+
+    /**
+     * 合并并行计算的片段：前面各片段均为相同的 2 的幂个完整分块，最后一个片段为其余数据（至少 1 字节）
+     * @param segments 前面各片段的子树链值（至少一个）
+     * @param tail 最后一个片段的子树链值
+     * @param out 输出缓冲区（OUT_LEN 字节）
+     */
+    static void combineSegments(const std::vector<std::array<uint32_t, 8>>& segments, const uint32_t tail[8],
+                                uint8_t out[OUT_LEN]);
+
+    /**
+     * 一次性计算哈希
+     * @param data 数据指针
+     * @param length 数据长度
+     * @param out 输出缓冲区（OUT_LEN 字节）
+     */
+    static void hash(const void* data, size_t length, uint8_t out[OUT_LEN]);
+
+    /**
+     * 转换为小写十六进制字符串
+     * @param digest 哈希值（OUT_LEN 字节）
+     * @return 十六进制字符串
+     */
+    static std::string toHex(const uint8_t digest[OUT_LEN]);
+
+    /**
+     * 当前使用的并行压缩实现（"avx512"、"avx2"、"vector" 或 "portable"）
+     */
+    static const char* implementation();
+};
+
+} // namespace filesystem
+} // namespace brisk
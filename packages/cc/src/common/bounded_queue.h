@@ -0,0 +1,117 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+namespace brisk {
+namespace filesystem {
+
+/**
+ * 有界阻塞队列（多生产者、多消费者）
+ * 队列满时 push 阻塞以形成背压，关闭后 pop 取完剩余元素即返回 false
+ */
+template <typename T>
+class BoundedQueue {
+private:
+    std::deque<T> items_;                   // 队列元素
+    size_t capacity_;                       // 容量（0 为不限制）
+    bool closed_;                           // 是否已关闭
+    std::mutex mutex_;                      // 互斥锁
+    std::condition_variable not_empty_;     // 非空条件
+    std::condition_variable not_full_;      // 未满条件
+
+public:
+    /**
+     * 构造函数
+     * @param capacity 容量（0 为不限制）
+     */
+    explicit BoundedQueue(size_t capacity) : capacity_(capacity), closed_(false) {}
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    /**
+     * 放入元素，队列满时阻塞
+     * @param item 元素
+     * @return 是否成功（队列已关闭时为 false）
+     */
+    bool push(T item) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_full_.wait(lock, [this]() { return closed_ || capacity_ == 0 || items_.size() < capacity_; });
+        if (closed_) {
+            return false;
+        }
+
+        items_.push_back(std::move(item));
+        not_empty_.notify_one();
+        return true;
+    }
+
+    /**
+     * 尝试放入元素，队列满时不阻塞
+     * @param item 元素（队列满时不取走）
+     * @return 是否已处理（已放入，或队列已关闭而丢弃）
+     */
+    bool tryPush(T& item) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (closed_) {
+            return true;
+        }
+        if (capacity_ != 0 && items_.size() >= capacity_) {
+            return false;
+        }
+
+        items_.push_back(std::move(item));
+        not_empty_.notify_one();
+        return true;
+    }
+
+    /**
+     * 放入元素，忽略容量限制（用于不能阻塞的调用方）
+     * @param item 元素
+     * @return 是否成功（队列已关闭时为 false）
+     */
+    bool forcePush(T item) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (closed_) {
+            return false;
+        }
+
+        items_.push_back(std::move(item));
+        not_empty_.notify_one();
+        return true;
+    }
+
+    /**
+     * 取出元素，队列为空时阻塞
+     * @param item 取出的元素
+     * @return 是否取到（队列已关闭且为空时为 false）
+     */
+    bool pop(T& item) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_empty_.wait(lock, [this]() { return closed_ || !items_.empty(); });
+        if (items_.empty()) {
+            return false;
+        }
+
+        item = std::move(items_.front());
+        items_.pop_front();
+        not_full_.notify_one();
+        return true;
+    }
+
+    /**
+     * 关闭队列，唤醒所有等待的生产者与消费者
+     */
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        not_empty_.notify_all();
+        not_full_.notify_all();
+    }
+};
+
+} // namespace filesystem
+} // namespace brisk
@@ -0,0 +1,201 @@
+#include "cpu_topology.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+
+#ifdef PLATFORM_LINUX
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace brisk {
+namespace filesystem {
+
+CpuTopology::CpuTopology() {
+#ifdef PLATFORM_LINUX
+    // 进程允许使用的 CPU（容器、taskset 限制）
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    bool has_allowed = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+
+    auto isAllowed = [&](uint32_t cpu) {
+        return !has_allowed || (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed));
+    };
+
+    DIR* dir = opendir("/sys/devices/system/node");
+    if (dir) {
+        std::vector<std::pair<uint32_t, std::vector<uint32_t>>> nodes;
+
+        while (struct dirent* entry = readdir(dir)) {
+            std::string name = entry->d_name;
+            if (name.compare(0, 4, "node") != 0 || name.size() == 4 ||
+                name.find_first_not_of("0123456789", 4) != std::string::npos) {
+                continue;
+            }
+
+            std::ifstream file("/sys/devices/system/node/" + name + "/cpulist");
+            std::string list;
+            std::getline(file, list);
+
+            std::vector<uint32_t> cpus;
+            for (uint32_t cpu : parseCpuList(list)) {
+                if (isAllowed(cpu)) {
+                    cpus.push_back(cpu);
+                }
+            }
+
+            // 只有内存没有可用 CPU 的节点不参与放置
+            if (!cpus.empty()) {
+                nodes.emplace_back(static_cast<uint32_t>(std::strtoul(name.c_str() + 4, nullptr, 10)), std::move(cpus));
+            }
+        }
+        closedir(dir);
+
+        std::sort(nodes.begin(), nodes.end());
+        for (auto& node : nodes) {
+            node_cpus_.push_back(std::move(node.second));
+        }
+    }
+
+    if (node_cpus_.empty() && has_allowed) {
+        std::vector<uint32_t> cpus;
+        for (uint32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &allowed)) {
+                cpus.push_back(cpu);
+            }
+        }
+        node_cpus_.push_back(std::move(cpus));
+    }
+#endif
+
+    if (node_cpus_.empty()) {
+        node_cpus_.emplace_back();
+    }
+
+    for (size_t node = 0; node < node_cpus_.size(); ++node) {
+        for (uint32_t cpu : node_cpus_[node]) {
+            if (cpu >= cpu_nodes_.size()) {
+                cpu_nodes_.resize(cpu + 1, -1);
+            }
+            cpu_nodes_[cpu] = static_cast<int>(node);
+        }
+    }
+}
+
+const CpuTopology& CpuTopology::instance() {
+    static const CpuTopology topology;
+    return topology;
+}
+
+std::vector<uint32_t> CpuTopology::parseCpuList(const std::string& list) {
+    std::vector<uint32_t> cpus;
+    size_t pos = 0;
+
+    while (pos < list.size()) {
+        size_t comma = list.find(',', pos);
+        std::string range = list.substr(pos, comma == std::string::npos ? std::string::npos : comma - pos);
+        pos = comma == std::string::npos ? list.size() : comma + 1;
+
+        char* end = nullptr;
+        unsigned long first = std::strtoul(range.c_str(), &end, 10);
+        if (end == range.c_str()) {
+            continue;
+        }
+
+        unsigned long last = first;
+        if (*end == '-') {
+            const char* second = end + 1;
+            last = std::strtoul(second, &end, 10);
+            if (end == second || last < first) {
+                continue;
+            }
+        }
+
+        for (unsigned long cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(static_cast<uint32_t>(cpu));
+        }
+    }
+
+    return cpus;
+}
+
+bool CpuTopology::pinCurrentThread(const std::vector<uint32_t>& cpus) {
+#ifdef PLATFORM_LINUX
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (uint32_t cpu : cpus) {
+        if (cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &set);
+        }
+    }
+
+    if (CPU_COUNT(&set) == 0) {
+        return false;
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    // macOS 不支持硬绑定，Windows 引擎为单线程遍历
+    (void)cpus;
+    return false;
+#endif
+}
+
+uint32_t CpuTopology::nodeOf(uint32_t cpu) const {
+    if (cpu < cpu_nodes_.size() && cpu_nodes_[cpu] >= 0) {
+        return static_cast<uint32_t>(cpu_nodes_[cpu]);
+    }
+    return 0;
+}
+
+uint32_t CpuTopology::currentNode() const {
+#ifdef PLATFORM_LINUX
+    int cpu = sched_getcpu();
+    if (cpu >= 0) {
+        return nodeOf(static_cast<uint32_t>(cpu));
+    }
+#endif
+    return 0;
+}
+
+void WorkerPlacement::configure(const std::vector<uint32_t>& cpu_affinity, bool numa_aware) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    slots_.clear();
+    next_.store(0, std::memory_order_relaxed);
+
+    if (!cpu_affinity.empty()) {
+        // 按节点分组排列指定的 CPU，轮流领取时相邻线程分布到不同节点
+        const CpuTopology& topology = CpuTopology::instance();
+        std::vector<std::vector<uint32_t>> by_node(topology.nodeCount());
+        for (uint32_t cpu : cpu_affinity) {
+            by_node[topology.nodeOf(cpu)].push_back(cpu);
+        }
+
+        for (size_t round = 0; slots_.size() < cpu_affinity.size(); ++round) {
+            for (const auto& cpus : by_node) {
+                if (round < cpus.size()) {
+                    slots_.push_back({cpus[round]});
+                }
+            }
+        }
+    } else if (numa_aware) {
+        const CpuTopology& topology = CpuTopology::instance();
+        if (topology.nodeCount() > 1) {
+            for (uint32_t node = 0; node < topology.nodeCount(); ++node) {
+                slots_.push_back(topology.cpusOf(node));
+            }
+        }
+    }
+}
+
+void WorkerPlacement::placeCurrentThread() {
+    if (slots_.empty()) {
+        return;
+    }
+
+    size_t slot = next_.fetch_add(1, std::memory_order_relaxed) % slots_.size();
+    CpuTopology::pinCurrentThread(slots_[slot]);
+}
+
+} // namespace filesystem
+} // namespace brisk
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace brisk {
+namespace filesystem {
+
+/**
+ * CPU 与 NUMA 拓扑
+ * Linux 下读取 /sys/devices/system/node 中各节点的 cpulist，其他平台视为单节点
+ */
+class CpuTopology {
+private:
+    std::vector<std::vector<uint32_t>> node_cpus_;  // 各 NUMA 节点上允许使用的 CPU
+    std::vector<int> cpu_nodes_;                    // CPU 编号 -> 节点编号（-1 为未知）
+
+    CpuTopology();
+
+public:
+    /**
+     * 获取进程级拓扑（首次调用时读取）
+     * @return 拓扑
+     */
+    static const CpuTopology& instance();
+
+    /**
+     * 解析 cpulist 格式（如 "0-3,8,10-11"）
+     * @param list cpulist 字符串
+     * @return CPU 编号列表，格式错误的片段会被忽略
+     */
+    static std::vector<uint32_t> parseCpuList(const std::string& list);
+
+    /**
+     * 将当前线程绑定到指定 CPU 集合
+     * @param cpus CPU 编号列表
+     * @return 是否成功（不支持的平台返回 false）
+     */
+    static bool pinCurrentThread(const std::vector<uint32_t>& cpus);
+
+    /**
+     * 获取 NUMA 节点数量（至少为 1）
+     * @return 节点数量
+     */
+    uint32_t nodeCount() const { return static_cast<uint32_t>(node_cpus_.size()); }
+
+    /**
+     * 获取节点上允许使用的 CPU
+     * @param node 节点编号
+     * @return CPU 编号列表
+     */
+    const std::vector<uint32_t>& cpusOf(uint32_t node) const { return node_cpus_[node]; }
+
+    /**
+     * 获取 CPU 所在节点
+     * @param cpu CPU 编号
+     * @return 节点编号，未知时为 0
+     */
+    uint32_t nodeOf(uint32_t cpu) const;
+
+    /**
+     * 获取当前线程所在节点
+     * @return 节点编号，无法获取时为 0
+     */
+    uint32_t currentNode() const;
+};
+
+/**
+ * 工作线程放置策略
+ * 扫描开始时根据选项生成放置槽位，各工作线程启动时依次领取一个槽位并绑定，
+ * 绑定后在线程内首次写入的缓冲区与线程结果会按首次访问策略分配在本地节点
+ */
+class WorkerPlacement {
+private:
+    std::vector<std::vector<uint32_t>> slots_;  // 放置槽位（每个槽位为一组 CPU）
+    std::atomic<size_t> next_;                  // 下一个领取的槽位
+    std::mutex mutex_;                          // 配置的互斥锁
+
+public:
+    WorkerPlacement() : next_(0) {}
+
+    /**
+     * 配置放置策略
+     * @param cpu_affinity 指定的 CPU 列表，非空时各线程依次绑定到单个 CPU
+     * @param numa_aware 未指定 CPU 时，是否将线程轮流绑定到各 NUMA 节点的 CPU 集合
+     */
+    void configure(const std::vector<uint32_t>& cpu_affinity, bool numa_aware);
+
+    /**
+     * 是否启用了放置
+     * @return 是否启用
+     */
+    bool enabled() const { return !slots_.empty(); }
+
+    /**
+     * 为当前线程领取槽位并绑定（未启用时不做任何操作）
+     */
+    void placeCurrentThread();
+};
+
+} // namespace filesystem
+} // namespace brisk
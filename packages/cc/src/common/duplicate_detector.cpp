@@ -0,0 +1,71 @@
+#include "duplicate_detector.h"
+#include <algorithm>
+#include <unordered_set>
+
+namespace brisk {
+namespace filesystem {
+
+void DuplicateSubtreeCollector::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    subtrees_.clear();
+}
+
+void DuplicateSubtreeCollector::record(uint64_t structure_hash, const std::string& path,
+                                       uint64_t size, uint32_t file_count) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto& entry = subtrees_[structure_hash];
+    if (entry.paths.empty()) {
+        entry.size = size;
+        entry.file_count = file_count;
+    }
+    entry.paths.push_back(path);
+}
+
+std::vector<DuplicateGroup> DuplicateSubtreeCollector::buildGroups() {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // 所有重复子树的路径
+    std::unordered_set<std::string> duplicated_paths;
+    for (const auto& pair : subtrees_) {
+        if (pair.second.paths.size() > 1) {
+            duplicated_paths.insert(pair.second.paths.begin(), pair.second.paths.end());
+        }
+    }
+
+    std::vector<DuplicateGroup> groups;
+    for (auto& pair : subtrees_) {
+        Entry& entry = pair.second;
+        if (entry.paths.size() < 2) {
+            continue;
+        }
+
+        // 所有副本的父目录也都是重复子树时，由外层分组报告即可
+        bool nested = std::all_of(entry.paths.begin(), entry.paths.end(), [&](const std::string& path) {
+            size_t slash = path.find_last_of("/\\");
+            return slash != std::string::npos && duplicated_paths.count(path.substr(0, slash)) > 0;
+        });
+        if (nested) {
+            continue;
+        }
+
+        DuplicateGroup group;
+        group.structure_hash = pair.first;
+        group.size = entry.size;
+        group.file_count = entry.file_count;
+        group.redundant_size = entry.size * (entry.paths.size() - 1);
+        group.paths = std::move(entry.paths);
+        std::sort(group.paths.begin(), group.paths.end());
+        groups.push_back(std::move(group));
+    }
+
+    std::sort(groups.begin(), groups.end(), [](const DuplicateGroup& a, const DuplicateGroup& b) {
+        return a.redundant_size > b.redundant_size;
+    });
+
+    subtrees_.clear();
+    return groups;
+}
+
+} // namespace filesystem
+} // namespace brisk
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "filesystem_common.h"
+#include <mutex>
+#include <unordered_map>
+
+namespace brisk {
+namespace filesystem {
+
+/**
+ * 相同子树收集器
+ * 遍历线程在完成每个目录时记录其结构哈希，遍历结束后按哈希分组，
+ * 只保留最外层的重复子树（内部的子目录必然随之重复，不再单独报告）
+ */
+class DuplicateSubtreeCollector {
+private:
+    /**
+     * 同一结构哈希下的子树记录
+     */
+    struct Entry {
+        uint64_t size;                      // 单个副本大小
+        uint32_t file_count;                // 单个副本文件数量
+        std::vector<std::string> paths;     // 各副本路径
+    };
+
+    std::unordered_map<uint64_t, Entry> subtrees_;  // 结构哈希 -> 子树记录
+    std::mutex mutex_;                              // 记录的互斥锁
+
+public:
+    /**
+     * 清空已记录的子树
+     */
+    void clear();
+
+    /**
+     * 记录一个目录子树（线程安全）
+     * @param structure_hash 结构哈希
+     * @param path 目录路径
+     * @param size 子树大小
+     * @param file_count 子树文件数量
+     */
+    void record(uint64_t structure_hash, const std::string& path, uint64_t size, uint32_t file_count);
+
+    /**
+     * 生成相同子树分组，按可回收大小降序排列
+     * @return 分组列表
+     */
+    std::vector<DuplicateGroup> buildGroups();
+};
+
+} // namespace filesystem
+} // namespace brisk
@@ -1,4 +1,5 @@
 #include "filesystem_common.h"
+#include "tree_sink.h"
 #include <algorithm>
 #include <chrono>
 #include <regex>
@@ -13,6 +14,11 @@
 namespace brisk {
 namespace filesystem {
 
+void FilesystemAccelerator::exportDirectoryTree(const std::string& path, const CalculationOptions& options,
+                                                TreeSink& sink) {
+    sink.writeTree(buildDirectoryTree(path, options));
+}
+
 std::string Utils::normalizePath(const std::string& path) {
     std::string normalized = path;
     
@@ -121,5 +127,11 @@ uint64_t Utils::getCurrentTimestamp() {
     return static_cast<uint64_t>(millis.count());
 }
 
+uint64_t Utils::getMonotonicMicros() {
+    auto now = std::chrono::steady_clock::now();
+    auto micros = std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch());
+    return static_cast<uint64_t>(micros.count());
+}
+
 } // namespace filesystem
 } // namespace brisk 
\ No newline at end of file
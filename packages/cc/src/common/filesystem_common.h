@@ -5,9 +5,16 @@
 #include <memory>
 #include <cstdint>
 
+#include "latency_histogram.h"
+#include "memory_accounting.h"
+#include "scan_scheduler.h"
+#include "tree_shape.h"
+
 namespace brisk {
 namespace filesystem {
 
+class TreeSink;
+
 /**
  * 文件系统项目类型枚举
  */
@@ -42,10 +49,11 @@ struct FileSystemItem {
     uint64_t modified_time;         // 修改时间（时间戳）
     uint64_t accessed_time;         // 访问时间（时间戳）
     uint64_t inode;                 // inode 号（Unix系统）或文件索引
+    uint32_t owner;                 // 所有者（Unix 系统的 uid，其他平台为 0）
     
     FileSystemItem() : type(ItemType::UNKNOWN), size(0), 
                       created_time(0), modified_time(0), 
-                      accessed_time(0), inode(0) {}
+                      accessed_time(0), inode(0), owner(0) {}
 };
 
 /**
@@ -56,8 +64,66 @@ struct TreeNode {
     std::vector<std::shared_ptr<TreeNode>> children;  // 子节点
     uint64_t total_size;                    // 总大小（包含子项目）
     int depth;                              // 深度
+    uint64_t fingerprint;                   // 元数据指纹（Merkle，包含全部子项）
+    uint64_t newest_modified_time;          // 子树中最新的修改时间（毫秒，含自身）
+    uint64_t newest_accessed_time;          // 子树中文件与链接最新的访问时间（毫秒，不含目录）
+    
+    TreeNode() : total_size(0), depth(0), fingerprint(0), newest_modified_time(0), newest_accessed_time(0) {}
+};
+
+/**
+ * 相同子树分组结构
+ */
+struct DuplicateGroup {
+    uint64_t structure_hash;                // 结构哈希
+    uint64_t size;                          // 单个副本大小
+    uint32_t file_count;                    // 单个副本文件数量
+    std::vector<std::string> paths;         // 各副本路径
+    uint64_t redundant_size;                // 可回收大小（除保留一份外的副本总大小）
     
-    TreeNode() : total_size(0), depth(0) {}
+    DuplicateGroup() : structure_hash(0), size(0), file_count(0), redundant_size(0) {}
+};
+
+/**
+ * npm 包统计结构
+ */
+struct PackageInfo {
+    std::string name;                       // 包名（pkg 或 @scope/pkg）
+    std::string version;                    // 版本号（来自 package.json）
+    std::string path;                       // 包目录路径
+    uint64_t size;                          // 包大小（不含内部嵌套的 node_modules）
+    uint32_t file_count;                    // 文件数量（不含内部嵌套的 node_modules）
+    uint32_t depth;                         // 嵌套深度（路径中 node_modules 的层数）
+    uint64_t newest_modified_time;          // 包内最新的修改时间（毫秒，含内部嵌套的 node_modules）
+    uint64_t newest_accessed_time;          // 包内文件最新的访问时间（毫秒，含内部嵌套的 node_modules）
+    
+    PackageInfo() : size(0), file_count(0), depth(0), newest_modified_time(0), newest_accessed_time(0) {}
+};
+
+/**
+ * 慢目录记录结构
+ */
+struct SlowDirectory {
+    std::string path;                       // 目录路径
+    uint64_t list_us;                       // 列目录耗时（微秒，含 open）
+    uint64_t stat_us;                       // 子项 stat 耗时（微秒）
+    uint32_t entry_count;                   // 子项数量
+    
+    SlowDirectory() : list_us(0), stat_us(0), entry_count(0) {}
+    
+    uint64_t totalMicros() const { return list_us + stat_us; }
+};
+
+/**
+ * 项目配额用量（ext4 / XFS 项目配额，由内核精确统计）
+ */
+struct ProjectQuotaUsage {
+    bool used;                              // 结果是否取自项目配额（为 false 时为完整遍历）
+    uint32_t project_id;                    // 项目 ID
+    uint64_t space_bytes;                   // 已占用空间（字节，按分配的块计算）
+    uint64_t inodes;                        // 已使用的 inode 数（文件、目录、链接等合计）
+    
+    ProjectQuotaUsage() : used(false), project_id(0), space_bytes(0), inodes(0) {}
 };
 
 /**
@@ -68,9 +134,24 @@ struct CalculationResult {
     uint32_t file_count;                    // 文件数量
     uint32_t directory_count;               // 目录数量
     uint32_t link_count;                    // 链接数量
+    std::vector<std::string> errors;        // 错误信息
+    uint64_t duration_ms;                   // 耗时（毫秒）
+    std::vector<DuplicateGroup> duplicate_groups; // 相同子树分组
+    uint64_t redundant_size;                // 相同子树可回收总大小
+    std::vector<PackageInfo> packages;      // npm 包统计
+    std::vector<SlowDirectory> slow_directories; // 最慢的目录（按耗时降序）
+    SyscallLatency syscall_latency;         // 各系统调用延迟直方图
+    TreeShape shape;                        // 目录树形状统计
+    MemoryUsage memory;                     // 扫描器自身内存用量
+    std::vector<std::string> timed_out;     // 操作超时而放弃的路径（其子树未统计）
+    ProjectQuotaUsage quota;                // 项目配额快速路径的用量
+    bool coalesced;                         // 是否复用了相同请求的扫描结果（合并或缓存）
+    uint64_t newest_modified_time;          // 统计范围内最新的修改时间（毫秒）
+    uint64_t newest_accessed_time;          // 统计范围内文件与链接最新的访问时间（毫秒）
     
     CalculationResult() : total_size(0), file_count(0), 
-                         directory_count(0), link_count(0) {}
+                         directory_count(0), link_count(0), duration_ms(0), redundant_size(0), coalesced(false),
+                         newest_modified_time(0), newest_accessed_time(0) {}
 };
 
 /**
@@ -82,17 +163,59 @@ struct CalculationOptions {
     std::vector<std::string> ignore_patterns; // 忽略模式
     bool inode_check;                       // 是否启用硬链接检测
     bool include_link;                      // 是否包含符号链接大小
+    bool follow_symlinks;                   // 是否跟随符号链接
+    uint32_t max_threads;                   // 最大线程数（0 为自动）
+    bool detect_duplicates;                 // 是否检测相同子树
+    bool duplicate_content_hash;            // 相同子树检测是否比较文件内容
+    bool aggregate_packages;                // 是否按 npm 包汇总
+    uint32_t slow_directory_limit;          // 报告最慢目录的数量（0 为不统计）
+    bool latency_histograms;                // 是否统计系统调用延迟直方图
+    bool shape_profile;                     // 是否统计目录树形状（深度、扇出、路径长度分布）
+    uint32_t shape_profile_limit;           // 形状统计中最大目录与最长路径的保留数量
+    uint64_t memory_limit;                  // 内存上限（字节，0 为不限制），超出后降级为仅汇总模式
+    std::vector<uint32_t> cpu_affinity;     // 工作线程绑定的 CPU 列表（空为不绑定）
+    bool numa_aware;                        // 未指定 CPU 时，是否将工作线程按 NUMA 节点放置
+    bool include_directory_size;            // 目录自身大小是否计入总大小（与 core 包 JS 实现的统计口径一致）
+    uint32_t pipeline_listers;              // 流水线模式的列目录线程数（0 为不使用流水线，按目录递归遍历）
+    uint32_t pipeline_stat_workers;         // 流水线模式的 stat 线程数（0 为自动）
+    uint32_t pipeline_queue_depth;          // 流水线模式目录项批次队列的容量（批次数，0 为默认）
+    uint32_t operation_timeout_ms;          // 单次文件系统操作的超时时间（毫秒，0 为不限制），超时后放弃该子树
+    bool coalesce;                          // 是否与进行中的相同请求合并（调用层使用，不影响扫描）
+    uint32_t coalesce_ttl_ms;               // 合并时结果的缓存时间（毫秒，0 为不缓存）
+    ScanPriority priority;                  // 与其他并发扫描共享执行槽位时的优先级
+    bool project_quota;                     // 根目录为项目配额目录时，是否直接读取配额用量而不遍历（Linux）
     
-    CalculationOptions() : include_hidden(true), max_depth(UINT32_MAX), inode_check(true), include_link(true) {}
+    CalculationOptions() : include_hidden(true), max_depth(UINT32_MAX), inode_check(true), include_link(true),
+                           follow_symlinks(false), max_threads(0),
+                           detect_duplicates(false), duplicate_content_hash(false),
+                           aggregate_packages(false), slow_directory_limit(0),
+                           latency_histograms(false), shape_profile(false), shape_profile_limit(10),
+                           memory_limit(0),
+                           numa_aware(false), include_directory_size(false),
+                           pipeline_listers(0), pipeline_stat_workers(0), pipeline_queue_depth(0),
+                           operation_timeout_ms(0), coalesce(false), coalesce_ttl_ms(0),
+                           priority(ScanPriority::NORMAL), project_quota(false) {}
 };
 
 /**
  * 抽象基类：文件系统加速器
  */
 class FilesystemAccelerator {
+protected:
+    MemoryAccounting memory_;               // 扫描器自身内存统计
+    ScanClient* scan_client_ = nullptr;     // 当前扫描的调度客户端（不在扫描中时为空）
+
 public:
     virtual ~FilesystemAccelerator() = default;
     
+    /**
+     * 获取当前（或最近一次）扫描的内存用量
+     * @return 内存用量快照
+     */
+    MemoryUsage getMemoryUsage() const {
+        return memory_.snapshot();
+    }
+    
     /**
      * 计算文件夹大小
      * @param path 文件夹路径
@@ -115,6 +238,19 @@ public:
         const CalculationOptions& options = CalculationOptions()
     ) = 0;
     
+    /**
+     * 以流式方式导出目录树（节点结构与 buildDirectoryTree 一致）
+     * 默认实现先构建完整目录树再写出，平台实现可在遍历时逐个节点写出，不保留整棵树
+     * @param path 文件夹路径
+     * @param options 配置选项
+     * @param sink 导出目标（调用方负责 finish）
+     */
+    virtual void exportDirectoryTree(
+        const std::string& path,
+        const CalculationOptions& options,
+        TreeSink& sink
+    );
+    
     /**
      * 检查路径是否存在
      * @param path 文件路径
@@ -178,6 +314,12 @@ public:
      * @return 时间戳
      */
     static uint64_t getCurrentTimestamp();
+    
+    /**
+     * 获取单调时钟时间（微秒），用于耗时统计
+     * @return 单调时间
+     */
+    static uint64_t getMonotonicMicros();
 };
 
 /**
@@ -0,0 +1,68 @@
+#include "fingerprint.h"
+
+namespace brisk {
+namespace filesystem {
+
+uint64_t Fingerprint::hashBytes(const void* data, size_t length, uint64_t seed) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    uint64_t hash = seed;
+
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+
+    return mix(hash ^ length);
+}
+
+uint64_t Fingerprint::mix(uint64_t value) {
+    value += 0x9e3779b97f4a7c15ULL;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+uint64_t Fingerprint::ofEntry(const std::string& name, ItemType type, uint64_t size,
+                              uint64_t modified_time, uint64_t children) {
+    uint64_t fields[4] = {
+        static_cast<uint64_t>(type),
+        size,
+        modified_time,
+        children
+    };
+
+    uint64_t hash = hashBytes(name.data(), name.size());
+    return hashBytes(fields, sizeof(fields), hash);
+}
+
+std::string Fingerprint::toHex(uint64_t fingerprint) {
+    static const char digits[] = "0123456789abcdef";
+    std::string hex(16, '0');
+
+    for (int i = 15; i >= 0; --i) {
+        hex[i] = digits[fingerprint & 0xf];
+        fingerprint >>= 4;
+    }
+
+    return hex;
+}
+
+void FingerprintAccumulator::add(uint64_t fingerprint) {
+    uint64_t mixed = Fingerprint::mix(fingerprint);
+    sum_ += mixed;
+    xor_ ^= mixed;
+    count_++;
+}
+
+void FingerprintAccumulator::merge(const FingerprintAccumulator& other) {
+    sum_ += other.sum_;
+    xor_ ^= other.xor_;
+    count_ += other.count_;
+}
+
+uint64_t FingerprintAccumulator::finish() const {
+    return Fingerprint::mix(sum_ ^ Fingerprint::mix(xor_ + count_));
+}
+
+} // namespace filesystem
+} // namespace brisk
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "filesystem_common.h"
+
+namespace brisk {
+namespace filesystem {
+
+/**
+ * 元数据指纹工具
+ * 对目录项的 (名称, 类型, 大小, 修改时间) 进行哈希，目录指纹再合并全部子项指纹，
+ * 形成 Merkle 结构：两次扫描只需沿指纹不一致的分支向下比较即可定位变化
+ */
+class Fingerprint {
+public:
+    /**
+     * 对字节序列进行 64 位哈希（FNV-1a + 末端混合）
+     * @param data 数据指针
+     * @param length 数据长度
+     * @param seed 初始种子
+     * @return 哈希值
+     */
+    static uint64_t hashBytes(const void* data, size_t length, uint64_t seed = 0xcbf29ce484222325ULL);
+
+    /**
+     * 64 位整数混合（splitmix64 末端），用于打散合并后的哈希
+     * @param value 输入值
+     * @return 混合后的值
+     */
+    static uint64_t mix(uint64_t value);
+
+    /**
+     * 计算单个目录项的指纹
+     * @param name 名称
+     * @param type 项目类型
+     * @param size 大小
+     * @param modified_time 修改时间
+     * @param children 子项合并指纹（非目录为 0）
+     * @return 指纹
+     */
+    static uint64_t ofEntry(const std::string& name, ItemType type, uint64_t size,
+                            uint64_t modified_time, uint64_t children = 0);
+
+    /**
+     * 转换为 16 位十六进制字符串
+     * @param fingerprint 指纹
+     * @return 十六进制字符串
+     */
+    static std::string toHex(uint64_t fingerprint);
+};
+
+/**
+ * 子项指纹累加器
+ * 合并方式与子项顺序无关，便于在并行遍历中按任意顺序累加
+ */
+class FingerprintAccumulator {
+private:
+    uint64_t sum_;      // 混合后指纹之和
+    uint64_t xor_;      // 混合后指纹异或
+    uint64_t count_;    // 子项数量
+
+public:
+    FingerprintAccumulator() : sum_(0), xor_(0), count_(0) {}
+
+    /**
+     * 累加一个子项指纹
+     * @param fingerprint 子项指纹
+     */
+    void add(uint64_t fingerprint);
+
+    /**
+     * 合并另一个累加器（用于合并线程结果）
+     * @param other 其他累加器
+     */
+    void merge(const FingerprintAccumulator& other);
+
+    /**
+     * 获取合并结果
+     * @return 全部子项的合并指纹
+     */
+    uint64_t finish() const;
+};
+
+} // namespace filesystem
+} // namespace brisk
@@ -0,0 +1,36 @@
+#include "ignore_patterns.h"
+
+namespace brisk {
+namespace filesystem {
+
+void IgnorePatternSet::compile(const std::vector<std::string>& patterns) {
+    regexes_.clear();
+    literals_.clear();
+
+    for (const auto& pattern : patterns) {
+        try {
+            regexes_.emplace_back(pattern, std::regex::ECMAScript | std::regex::optimize);
+        } catch (const std::regex_error&) {
+            literals_.push_back(pattern);
+        }
+    }
+}
+
+bool IgnorePatternSet::matches(const std::string& path) const {
+    for (const auto& regex : regexes_) {
+        if (std::regex_search(path, regex)) {
+            return true;
+        }
+    }
+
+    for (const auto& literal : literals_) {
+        if (path.find(literal) != std::string::npos) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} // namespace filesystem
+} // namespace brisk
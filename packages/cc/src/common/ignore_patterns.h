@@ -0,0 +1,42 @@
+#pragma once
+
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace brisk {
+namespace filesystem {
+
+/**
+ * 预编译的忽略模式集合
+ * 与 Utils::matchesIgnorePattern 语义一致（ECMAScript 正则搜索，无效的正则按子串匹配），
+ * 但只在扫描开始时编译一次，避免对每个路径重复构造正则
+ */
+class IgnorePatternSet {
+private:
+    std::vector<std::regex> regexes_;       // 编译成功的正则
+    std::vector<std::string> literals_;     // 编译失败、按子串匹配的模式
+
+public:
+    /**
+     * 编译忽略模式（替换已有的模式）
+     * @param patterns 忽略模式列表
+     */
+    void compile(const std::vector<std::string>& patterns);
+
+    /**
+     * 检查路径是否匹配任一模式（线程安全，只读）
+     * @param path 文件路径
+     * @return 是否匹配
+     */
+    bool matches(const std::string& path) const;
+
+    /**
+     * 是否没有任何模式
+     * @return 是否为空
+     */
+    bool empty() const { return regexes_.empty() && literals_.empty(); }
+};
+
+} // namespace filesystem
+} // namespace brisk
@@ -0,0 +1,119 @@
+#include "latency_histogram.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace brisk {
+namespace filesystem {
+
+namespace {
+
+/**
+ * 获取最高有效位的位置
+ */
+uint32_t highestBit(uint64_t value) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return static_cast<uint32_t>(index);
+#else
+    return 63 - static_cast<uint32_t>(__builtin_clzll(value));
+#endif
+}
+
+} // namespace
+
+uint32_t LatencyHistogram::bucketIndex(uint64_t value) {
+    // 小于 2 * SUB_BUCKET_COUNT 的值精确记录
+    if (value < 2 * SUB_BUCKET_COUNT) {
+        return static_cast<uint32_t>(value);
+    }
+
+    if (value >= (1ULL << MAX_MAGNITUDE)) {
+        value = (1ULL << MAX_MAGNITUDE) - 1;
+    }
+
+    uint32_t magnitude = highestBit(value);
+    uint32_t shift = magnitude - SUB_BUCKET_BITS;
+    uint32_t top = static_cast<uint32_t>(value >> shift);  // [SUB_BUCKET_COUNT, 2 * SUB_BUCKET_COUNT)
+
+    return 2 * SUB_BUCKET_COUNT + (shift - 1) * SUB_BUCKET_COUNT + (top - SUB_BUCKET_COUNT);
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(uint32_t index) {
+    if (index < 2 * SUB_BUCKET_COUNT) {
+        return index;
+    }
+
+    uint32_t offset = index - 2 * SUB_BUCKET_COUNT;
+    uint32_t shift = offset / SUB_BUCKET_COUNT + 1;
+    uint64_t top = offset % SUB_BUCKET_COUNT + SUB_BUCKET_COUNT;
+
+    return ((top + 1) << shift) - 1;
+}
+
+uint32_t LatencyHistogram::bucketCount() {
+    return bucketIndex((1ULL << MAX_MAGNITUDE) - 1) + 1;
+}
+
+void LatencyHistogram::record(uint64_t value_ns) {
+    if (counts_.empty()) {
+        counts_.resize(bucketCount(), 0);
+    }
+
+    counts_[bucketIndex(value_ns)]++;
+    total_count_++;
+    sum_ += value_ns;
+    if (value_ns > max_) {
+        max_ = value_ns;
+    }
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    if (other.total_count_ == 0) {
+        return;
+    }
+
+    if (counts_.empty()) {
+        counts_.resize(bucketCount(), 0);
+    }
+
+    for (size_t i = 0; i < other.counts_.size(); ++i) {
+        counts_[i] += other.counts_[i];
+    }
+    total_count_ += other.total_count_;
+    sum_ += other.sum_;
+    if (other.max_ > max_) {
+        max_ = other.max_;
+    }
+}
+
+uint64_t LatencyHistogram::percentile(double percentile) const {
+    if (total_count_ == 0) {
+        return 0;
+    }
+
+    // 目标名次（至少为 1）
+    uint64_t rank = static_cast<uint64_t>(percentile / 100.0 * static_cast<double>(total_count_) + 0.5);
+    if (rank < 1) {
+        rank = 1;
+    }
+    if (rank >= total_count_) {
+        return max_;
+    }
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < counts_.size(); ++i) {
+        seen += counts_[i];
+        if (seen >= rank) {
+            uint64_t upper = bucketUpperBound(static_cast<uint32_t>(i));
+            return upper < max_ ? upper : max_;
+        }
+    }
+
+    return max_;
+}
+
+} // namespace filesystem
+} // namespace brisk
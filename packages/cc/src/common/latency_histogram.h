@@ -0,0 +1,134 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace brisk {
+namespace filesystem {
+
+/**
+ * 高动态范围（HDR）延迟直方图
+ * 采用对数-线性分桶：每个 2 的幂区间再等分为 32 个子桶，相对误差约 3%，
+ * 覆盖 1 纳秒到数小时，内存固定且记录开销为常数
+ */
+class LatencyHistogram {
+public:
+    static constexpr uint32_t SUB_BUCKET_BITS = 5;                      // 子桶位数
+    static constexpr uint32_t SUB_BUCKET_COUNT = 1u << SUB_BUCKET_BITS; // 每个区间的子桶数
+    static constexpr uint32_t MAX_MAGNITUDE = 44;                      // 最大记录值为 2^44 纳秒
+
+private:
+    std::vector<uint64_t> counts_;  // 各桶计数（首次记录时分配）
+    uint64_t total_count_;          // 记录总数
+    uint64_t sum_;                  // 记录值之和
+    uint64_t max_;                  // 最大值
+
+public:
+    LatencyHistogram() : total_count_(0), sum_(0), max_(0) {}
+
+    /**
+     * 记录一个延迟值
+     * @param value_ns 延迟（纳秒）
+     */
+    void record(uint64_t value_ns);
+
+    /**
+     * 合并另一个直方图
+     * @param other 其他直方图
+     */
+    void merge(const LatencyHistogram& other);
+
+    /**
+     * 获取百分位数
+     * @param percentile 百分位（0 - 100）
+     * @return 对应的延迟（纳秒，桶的上界）
+     */
+    uint64_t percentile(double percentile) const;
+
+    uint64_t count() const { return total_count_; }
+    uint64_t max() const { return max_; }
+    double mean() const { return total_count_ > 0 ? static_cast<double>(sum_) / total_count_ : 0.0; }
+
+private:
+    /**
+     * 计算值对应的桶下标
+     */
+    static uint32_t bucketIndex(uint64_t value);
+
+    /**
+     * 计算桶内的最大值
+     */
+    static uint64_t bucketUpperBound(uint32_t index);
+
+    /**
+     * 桶总数
+     */
+    static uint32_t bucketCount();
+};
+
+/**
+ * 系统调用类型
+ */
+enum class SyscallType {
+    GETDENTS,
+    STAT,
+    OPEN,
+    CLOSE,
+    COUNT
+};
+
+/**
+ * 各系统调用的延迟直方图（每个遍历线程一份，结束时合并）
+ */
+struct SyscallLatency {
+    LatencyHistogram histograms[static_cast<int>(SyscallType::COUNT)];
+
+    LatencyHistogram& of(SyscallType type) { return histograms[static_cast<int>(type)]; }
+    const LatencyHistogram& of(SyscallType type) const { return histograms[static_cast<int>(type)]; }
+
+    void merge(const SyscallLatency& other) {
+        for (int i = 0; i < static_cast<int>(SyscallType::COUNT); ++i) {
+            histograms[i].merge(other.histograms[i]);
+        }
+    }
+};
+
+/**
+ * 将一次系统调用计入进程级指标（写入当前线程的计数分片，实现位于 process_metrics.cpp）
+ * @param type 系统调用类型
+ */
+void countProcessSyscall(SyscallType type);
+
+/**
+ * 系统调用计时器（RAII）
+ * 直方图为空指针时不读取时钟，未启用统计时只增加当前线程的系统调用计数
+ */
+class SyscallTimer {
+private:
+    LatencyHistogram* histogram_;                       // 目标直方图
+    std::chrono::steady_clock::time_point start_;       // 开始时间
+
+public:
+    SyscallTimer(LatencyHistogram* histogram, SyscallType type) : histogram_(histogram) {
+        countProcessSyscall(type);
+        if (histogram_) {
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~SyscallTimer() {
+        if (histogram_) {
+            auto elapsed = std::chrono::steady_clock::now() - start_;
+            histogram_->record(static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        }
+    }
+
+    SyscallTimer(const SyscallTimer&) = delete;
+    SyscallTimer& operator=(const SyscallTimer&) = delete;
+};
+
+} // namespace filesystem
+} // namespace brisk
@@ -0,0 +1,120 @@
+#include "memory_accounting.h"
+#include <string>
+
+namespace brisk {
+namespace filesystem {
+
+namespace {
+
+/**
+ * 原子地更新峰值
+ */
+void updatePeak(std::atomic<uint64_t>& peak, uint64_t value) {
+    uint64_t previous = peak.load(std::memory_order_relaxed);
+    while (value > previous &&
+           !peak.compare_exchange_weak(previous, value, std::memory_order_relaxed)) {
+    }
+}
+
+/**
+ * 原子地减少计数（不低于 0）
+ */
+uint64_t subtractSaturating(std::atomic<uint64_t>& counter, uint64_t bytes) {
+    uint64_t previous = counter.load(std::memory_order_relaxed);
+    uint64_t next;
+    do {
+        next = previous > bytes ? previous - bytes : 0;
+    } while (!counter.compare_exchange_weak(previous, next, std::memory_order_relaxed));
+    return next;
+}
+
+} // namespace
+
+std::mutex MemoryAccounting::registry_mutex_;
+std::set<const MemoryAccounting*> MemoryAccounting::registry_;
+
+MemoryAccounting::MemoryAccounting()
+    : total_current_(0), total_peak_(0), limit_(0), degraded_(false) {
+    for (int i = 0; i < static_cast<int>(MemorySubsystem::COUNT); ++i) {
+        current_[i].store(0);
+        peak_[i].store(0);
+    }
+}
+
+MemoryAccounting::~MemoryAccounting() {
+    deactivate();
+}
+
+void MemoryAccounting::activate() {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    registry_.insert(this);
+}
+
+void MemoryAccounting::deactivate() {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    registry_.erase(this);
+}
+
+void MemoryAccounting::reset(uint64_t limit) {
+    for (int i = 0; i < static_cast<int>(MemorySubsystem::COUNT); ++i) {
+        current_[i].store(0, std::memory_order_relaxed);
+        peak_[i].store(0, std::memory_order_relaxed);
+    }
+    total_current_.store(0, std::memory_order_relaxed);
+    total_peak_.store(0, std::memory_order_relaxed);
+    limit_.store(limit, std::memory_order_relaxed);
+    degraded_.store(false, std::memory_order_relaxed);
+}
+
+void MemoryAccounting::allocate(MemorySubsystem subsystem, uint64_t bytes) {
+    int index = static_cast<int>(subsystem);
+    uint64_t current = current_[index].fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    updatePeak(peak_[index], current);
+
+    uint64_t total = total_current_.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    updatePeak(total_peak_, total);
+
+    uint64_t limit = limit_.load(std::memory_order_relaxed);
+    if (limit > 0 && total > limit) {
+        degraded_.store(true, std::memory_order_relaxed);
+    }
+}
+
+void MemoryAccounting::release(MemorySubsystem subsystem, uint64_t bytes) {
+    subtractSaturating(current_[static_cast<int>(subsystem)], bytes);
+    subtractSaturating(total_current_, bytes);
+}
+
+MemoryUsage MemoryAccounting::snapshot() const {
+    MemoryUsage usage;
+    for (int i = 0; i < static_cast<int>(MemorySubsystem::COUNT); ++i) {
+        usage.subsystems[i].current = current_[i].load(std::memory_order_relaxed);
+        usage.subsystems[i].peak = peak_[i].load(std::memory_order_relaxed);
+    }
+    usage.total.current = total_current_.load(std::memory_order_relaxed);
+    usage.total.peak = total_peak_.load(std::memory_order_relaxed);
+    usage.limit = limit_.load(std::memory_order_relaxed);
+    usage.degraded = degraded();
+    return usage;
+}
+
+std::vector<MemoryUsage> MemoryAccounting::snapshotActive() {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+
+    // 峰值与上限只对单次扫描有意义，逐个扫描返回而不相加
+    std::vector<MemoryUsage> usages;
+    usages.reserve(registry_.size());
+    for (const MemoryAccounting* accounting : registry_) {
+        usages.push_back(accounting->snapshot());
+    }
+    return usages;
+}
+
+uint64_t MemoryAccounting::stringBytes(size_t length) {
+    // 短字符串存放在对象内部（SSO），超出时额外占用堆内存
+    const size_t sso_capacity = 15;
+    return sizeof(std::string) + (length > sso_capacity ? length + 1 : 0);
+}
+
+} // namespace filesystem
+} // namespace brisk
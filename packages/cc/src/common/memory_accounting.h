@@ -0,0 +1,183 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <vector>
+
+namespace brisk {
+namespace filesystem {
+
+/**
+ * 内存统计子系统
+ */
+enum class MemorySubsystem {
+    INODE_SET,      // 硬链接去重集合
+    TREE_NODES,     // 目录树节点
+    STRINGS,        // 路径、错误等字符串
+    BUFFERS,        // 目录读取与文件读取缓冲区
+    QUEUES,         // 待处理目录队列
+    COUNT
+};
+
+/**
+ * 单个子系统的内存用量
+ */
+struct MemoryFigure {
+    uint64_t current;   // 当前字节数
+    uint64_t peak;      // 峰值字节数
+
+    MemoryFigure() : current(0), peak(0) {}
+};
+
+/**
+ * 内存用量快照
+ */
+struct MemoryUsage {
+    MemoryFigure subsystems[static_cast<int>(MemorySubsystem::COUNT)];  // 各子系统用量
+    MemoryFigure total;                                                   // 合计用量
+    uint64_t limit;                                                       // 内存上限（0 为不限制）
+    bool degraded;                                                        // 是否因超出上限降级为仅汇总模式
+
+    MemoryUsage() : limit(0), degraded(false) {}
+
+    const MemoryFigure& of(MemorySubsystem subsystem) const { return subsystems[static_cast<int>(subsystem)]; }
+};
+
+/**
+ * 扫描器自身内存统计
+ * 按子系统记录估算的当前与峰值用量（原子计数，可在扫描过程中从其他线程读取），
+ * 超出上限后标记为降级，遍历据此停止保留可选的明细数据，只统计汇总值
+ */
+class MemoryAccounting {
+private:
+    std::atomic<uint64_t> current_[static_cast<int>(MemorySubsystem::COUNT)];  // 各子系统当前用量
+    std::atomic<uint64_t> peak_[static_cast<int>(MemorySubsystem::COUNT)];     // 各子系统峰值
+    std::atomic<uint64_t> total_current_;                                       // 合计当前用量
+    std::atomic<uint64_t> total_peak_;                                          // 合计峰值
+    std::atomic<uint64_t> limit_;                                               // 内存上限
+    std::atomic<bool> degraded_;                                                // 是否已降级
+
+    static std::mutex registry_mutex_;                   // 进行中扫描的注册表互斥锁
+    static std::set<const MemoryAccounting*> registry_;  // 进行中扫描的注册表
+
+public:
+    MemoryAccounting();
+    ~MemoryAccounting();
+
+    MemoryAccounting(const MemoryAccounting&) = delete;
+    MemoryAccounting& operator=(const MemoryAccounting&) = delete;
+
+    /**
+     * 重置统计并设置上限（每次扫描开始时调用）
+     * @param limit 内存上限（字节，0 为不限制）
+     */
+    void reset(uint64_t limit);
+
+    /**
+     * 记录分配
+     * @param subsystem 子系统
+     * @param bytes 字节数
+     */
+    void allocate(MemorySubsystem subsystem, uint64_t bytes);
+
+    /**
+     * 记录释放
+     * @param subsystem 子系统
+     * @param bytes 字节数
+     */
+    void release(MemorySubsystem subsystem, uint64_t bytes);
+
+    /**
+     * 是否已超出上限并降级为仅汇总模式
+     * @return 是否降级
+     */
+    bool degraded() const { return degraded_.load(std::memory_order_relaxed); }
+
+    /**
+     * 获取当前用量快照
+     * @return 用量快照
+     */
+    MemoryUsage snapshot() const;
+
+    /**
+     * 登记为进行中的扫描（扫描开始时调用）
+     */
+    void activate();
+
+    /**
+     * 取消登记（扫描结束时调用）
+     */
+    void deactivate();
+
+    /**
+     * 获取每个进行中扫描的用量（用于异步扫描过程中的实时查询；
+     * 空闲实例保留着上一次扫描的数据，不在其中）
+     * @return 各扫描的用量快照
+     */
+    static std::vector<MemoryUsage> snapshotActive();
+
+    /**
+     * 估算字符串占用的字节数
+     * @param length 字符串长度
+     * @return 字节数
+     */
+    static uint64_t stringBytes(size_t length);
+};
+
+/**
+ * 进行中扫描的作用域（RAII），在作用域内可由 snapshotActive 查询
+ */
+class ActiveMemoryScope {
+private:
+    MemoryAccounting& accounting_;
+
+public:
+    explicit ActiveMemoryScope(MemoryAccounting& accounting) : accounting_(accounting) {
+        accounting_.activate();
+    }
+
+    ~ActiveMemoryScope() {
+        accounting_.deactivate();
+    }
+
+    ActiveMemoryScope(const ActiveMemoryScope&) = delete;
+    ActiveMemoryScope& operator=(const ActiveMemoryScope&) = delete;
+};
+
+/**
+ * 作用域内存记录（RAII），用于临时缓冲区与队列
+ */
+class ScopedMemory {
+private:
+    MemoryAccounting& accounting_;
+    MemorySubsystem subsystem_;
+    uint64_t bytes_;
+
+public:
+    ScopedMemory(MemoryAccounting& accounting, MemorySubsystem subsystem, uint64_t bytes)
+        : accounting_(accounting), subsystem_(subsystem), bytes_(bytes) {
+        accounting_.allocate(subsystem_, bytes_);
+    }
+
+    ~ScopedMemory() {
+        accounting_.release(subsystem_, bytes_);
+    }
+
+    /**
+     * 追加记录字节数
+     * @param bytes 字节数
+     */
+    void grow(uint64_t bytes) {
+        accounting_.allocate(subsystem_, bytes);
+        bytes_ += bytes;
+    }
+
+    ScopedMemory(const ScopedMemory&) = delete;
+    ScopedMemory& operator=(const ScopedMemory&) = delete;
+};
+
+} // namespace filesystem
+} // namespace brisk
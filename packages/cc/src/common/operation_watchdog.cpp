@@ -0,0 +1,51 @@
+#include "operation_watchdog.h"
+#include "filesystem_common.h"
+
+namespace brisk {
+namespace filesystem {
+
+WatchedWorker::WatchedWorker(bool watching)
+    : watching_(watching), op_start_us_(0), op_path_(nullptr), abandoned_(false) {
+}
+
+void WatchedWorker::begin(const std::string& path) {
+    if (!watching_) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    // 单调时钟从 0 开始时避免与空闲标记冲突
+    op_start_us_ = Utils::getMonotonicMicros() | 1;
+    op_path_ = &path;
+}
+
+bool WatchedWorker::end() {
+    if (!watching_) {
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    op_start_us_ = 0;
+    op_path_ = nullptr;
+    return !abandoned_;
+}
+
+bool WatchedWorker::expire(uint64_t now_us, uint64_t timeout_us, std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (abandoned_ || op_start_us_ == 0 || now_us < op_start_us_ || now_us - op_start_us_ < timeout_us) {
+        return false;
+    }
+
+    // 线程仍阻塞在系统调用中，路径所在的栈帧有效
+    path = *op_path_;
+    abandoned_ = true;
+    return true;
+}
+
+bool WatchedWorker::abandoned() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return abandoned_;
+}
+
+} // namespace filesystem
+} // namespace brisk
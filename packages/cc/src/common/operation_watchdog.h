@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace brisk {
+namespace filesystem {
+
+/**
+ * 受看门狗监视的工作线程
+ *
+ * 工作线程在可能无限阻塞的系统调用（如失联 NFS 上的 stat）前后调用 begin/end，
+ * 看门狗定期调用 expire 检查超时的操作并将线程标记为已放弃。
+ * 系统调用无法中断，被放弃的线程返回后 end 得到 false，此后不得再访问任何扫描状态
+ */
+class WatchedWorker {
+private:
+    std::mutex mutex_;                  // 互斥锁
+    bool watching_;                     // 是否启用监视（未启用时 begin/end 不加锁）
+    uint64_t op_start_us_;              // 进行中操作的开始时间（0 为空闲）
+    const std::string* op_path_;        // 进行中操作的路径
+    bool abandoned_;                    // 是否已被放弃
+
+public:
+    /**
+     * 构造函数
+     * @param watching 是否启用监视
+     */
+    explicit WatchedWorker(bool watching);
+
+    /**
+     * 开始一次可能阻塞的操作
+     * @param path 操作的路径（操作结束前必须保持有效）
+     */
+    void begin(const std::string& path);
+
+    /**
+     * 结束操作
+     * @return 是否继续工作（已被放弃时为 false）
+     */
+    bool end();
+
+    /**
+     * 检查进行中的操作是否超时，超时则将线程标记为已放弃（由看门狗调用）
+     * @param now_us 当前单调时间（微秒）
+     * @param timeout_us 超时时间（微秒）
+     * @param path 输出超时操作的路径
+     * @return 是否本次被放弃
+     */
+    bool expire(uint64_t now_us, uint64_t timeout_us, std::string& path);
+
+    /**
+     * 是否已被放弃
+     * @return 是否已被放弃
+     */
+    bool abandoned();
+};
+
+} // namespace filesystem
+} // namespace brisk
@@ -0,0 +1,182 @@
+#include "package_manifest.h"
+
+namespace brisk {
+namespace filesystem {
+
+namespace {
+
+/**
+ * 是否为路径分隔符
+ */
+bool isSeparator(char c) {
+    return c == '/' || c == '\\';
+}
+
+/**
+ * 获取路径中倒数第 index 段（从 0 开始），不存在时为空字符串
+ */
+std::string pathSegmentFromEnd(const std::string& path, size_t index) {
+    size_t end = path.size();
+
+    for (size_t i = 0; ; ++i) {
+        while (end > 0 && isSeparator(path[end - 1])) {
+            end--;
+        }
+
+        size_t begin = end;
+        while (begin > 0 && !isSeparator(path[begin - 1])) {
+            begin--;
+        }
+
+        if (i == index) {
+            return path.substr(begin, end - begin);
+        }
+        if (begin == 0) {
+            return "";
+        }
+        end = begin;
+    }
+}
+
+/**
+ * 读取从 begin（左引号）开始的 JSON 字符串，处理反斜杠转义
+ * @param content 文件内容
+ * @param begin 左引号位置
+ * @param end 输出的右引号位置
+ * @param text 输出的字符串内容（\uXXXX 保持原样）
+ * @return 字符串完整时为 true（内容被截断时为 false）
+ */
+bool readString(const std::string& content, size_t begin, size_t& end, std::string& text) {
+    text.clear();
+    for (size_t i = begin + 1; i < content.size(); ++i) {
+        char c = content[i];
+        if (c == '"') {
+            end = i;
+            return true;
+        }
+        if (c == '\\') {
+            if (++i >= content.size()) {
+                return false;
+            }
+            char escaped = content[i];
+            switch (escaped) {
+                case 'n': text += '\n'; break;
+                case 't': text += '\t'; break;
+                case 'r': text += '\r'; break;
+                case 'b': text += '\b'; break;
+                case 'f': text += '\f'; break;
+                case 'u': text += "\\u"; break;
+                default: text += escaped; break;
+            }
+            continue;
+        }
+        text += c;
+    }
+    return false;
+}
+
+} // namespace
+
+bool PackageManifest::isPackageLocation(const std::string& path) {
+    std::string name = pathSegmentFromEnd(path, 0);
+    std::string parent = pathSegmentFromEnd(path, 1);
+
+    if (name.empty() || name[0] == '.') {
+        return false;
+    }
+
+    if (parent == "node_modules") {
+        return name[0] != '@';
+    }
+
+    return parent.size() > 1 && parent[0] == '@' && pathSegmentFromEnd(path, 2) == "node_modules";
+}
+
+std::string PackageManifest::packageName(const std::string& path) {
+    std::string name = pathSegmentFromEnd(path, 0);
+    std::string parent = pathSegmentFromEnd(path, 1);
+
+    if (!parent.empty() && parent[0] == '@') {
+        return parent + "/" + name;
+    }
+    return name;
+}
+
+uint32_t PackageManifest::nestingDepth(const std::string& path) {
+    static const std::string segment = "node_modules";
+    uint32_t depth = 0;
+
+    for (size_t pos = path.find(segment); pos != std::string::npos; pos = path.find(segment, pos + 1)) {
+        bool starts = pos == 0 || isSeparator(path[pos - 1]);
+        size_t after = pos + segment.size();
+        bool ends = after == path.size() || isSeparator(path[after]);
+        if (starts && ends) {
+            depth++;
+        }
+    }
+
+    return depth;
+}
+
+std::string PackageManifest::extractVersion(const std::string& content) {
+    // 只识别顶层对象的键：scripts、engines 等嵌套对象中的 "version" 不是包版本
+    int depth = 0;
+    bool expect_key = false;
+
+    for (size_t i = 0; i < content.size(); ++i) {
+        char c = content[i];
+
+        if (c == '{' || c == '[') {
+            depth++;
+            expect_key = c == '{' && depth == 1;
+            continue;
+        }
+        if (c == '}' || c == ']') {
+            depth--;
+            continue;
+        }
+        if (c == ',') {
+            expect_key = depth == 1;
+            continue;
+        }
+        if (c != '"') {
+            continue;
+        }
+
+        size_t end;
+        std::string text;
+        if (!readString(content, i, end, text)) {
+            return "";
+        }
+        i = end;
+
+        if (!expect_key) {
+            continue;
+        }
+        expect_key = false;
+
+        size_t colon = content.find_first_not_of(" \t\r\n", end + 1);
+        if (colon == std::string::npos || content[colon] != ':') {
+            return "";
+        }
+        if (text != "version") {
+            i = colon;
+            continue;
+        }
+
+        size_t quote = content.find_first_not_of(" \t\r\n", colon + 1);
+        if (quote == std::string::npos || content[quote] != '"') {
+            return "";
+        }
+        std::string version;
+        if (!readString(content, quote, end, version)) {
+            return "";
+        }
+        return version;
+    }
+
+    return "";
+}
+
+} // namespace filesystem
+} // namespace brisk
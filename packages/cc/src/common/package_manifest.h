@@ -0,0 +1,49 @@
+#pragma once
+
+#include "filesystem_common.h"
+
+namespace brisk {
+namespace filesystem {
+
+/**
+ * npm 包识别工具
+ * 用于在遍历中识别 node_modules 下的包边界（含 @scope/pkg 形式）
+ */
+class PackageManifest {
+public:
+    /**
+     * 读取 package.json 时的最大字节数（version 字段通常位于文件开头）
+     */
+    static constexpr size_t MAX_MANIFEST_BYTES = 16384;
+
+    /**
+     * 检查目录路径是否位于包位置：父目录为 node_modules，或父目录为 node_modules 下的 @scope
+     * @param path 目录路径
+     * @return 是否为包位置
+     */
+    static bool isPackageLocation(const std::string& path);
+
+    /**
+     * 根据目录路径获取包名（pkg 或 @scope/pkg）
+     * @param path 包目录路径
+     * @return 包名
+     */
+    static std::string packageName(const std::string& path);
+
+    /**
+     * 计算包的嵌套深度（路径中 node_modules 的层数）
+     * @param path 包目录路径
+     * @return 嵌套深度
+     */
+    static uint32_t nestingDepth(const std::string& path);
+
+    /**
+     * 从 package.json 内容（可能被截断）中提取顶层对象的 version 字段
+     * @param content 文件内容
+     * @return 版本号，未找到时为空字符串
+     */
+    static std::string extractVersion(const std::string& content);
+};
+
+} // namespace filesystem
+} // namespace brisk
@@ -0,0 +1,53 @@
+#include "partitioned_inode_set.h"
+#include "fingerprint.h"
+
+namespace brisk {
+namespace filesystem {
+
+namespace {
+
+/**
+ * 文件标识的 64 位哈希（相邻 inode 号往往连续分配，先混合再使用）
+ */
+uint64_t hashKey(const InodeKey& key) {
+    return Fingerprint::mix(key.inode ^ Fingerprint::mix(key.device));
+}
+
+} // namespace
+
+PartitionedInodeSet::PartitionedInodeSet(size_t partition_count) {
+    reset(partition_count);
+}
+
+void PartitionedInodeSet::reset(size_t partition_count) {
+    partitions_.clear();
+    for (size_t i = 0; i < (partition_count == 0 ? 1 : partition_count); ++i) {
+        partitions_.push_back(std::make_unique<Partition>());
+    }
+}
+
+size_t PartitionedInodeSet::InodeKeyHash::operator()(const InodeKey& key) const {
+    return static_cast<size_t>(hashKey(key));
+}
+
+PartitionedInodeSet::Partition& PartitionedInodeSet::partitionOf(const InodeKey& key) {
+    // 取哈希的高位选择分区，分区内的哈希表使用低位，避免同一分区内桶分布不均
+    return *partitions_[(hashKey(key) >> 32) % partitions_.size()];
+}
+
+bool PartitionedInodeSet::checkAndInsert(uint64_t device, uint64_t inode, bool record) {
+    InodeKey key{device, inode};
+    Partition& partition = partitionOf(key);
+    std::lock_guard<std::mutex> lock(partition.mutex);
+
+    if (partition.inodes.count(key)) {
+        return false;
+    }
+    if (record) {
+        partition.inodes.insert(key);
+    }
+    return true;
+}
+
+} // namespace filesystem
+} // namespace brisk
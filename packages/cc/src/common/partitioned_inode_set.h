@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace brisk {
+namespace filesystem {
+
+/**
+ * 文件标识（设备号 + inode 号；inode 号只在单个文件系统内唯一）
+ */
+struct InodeKey {
+    uint64_t device;    // 设备号
+    uint64_t inode;     // inode 号
+
+    bool operator==(const InodeKey& other) const { return device == other.device && inode == other.inode; }
+};
+
+/**
+ * 哈希分区 inode 集合（硬链接去重）
+ * 按 (设备号, inode 号) 的哈希分散到多个分区，每个分区独占缓存行并有独立的锁，
+ * 避免所有工作线程争用同一把锁、同一条缓存行在 CPU 插槽之间来回迁移
+ */
+class PartitionedInodeSet {
+private:
+    /**
+     * 文件标识哈希（混合后取值，相邻 inode 号分布均匀）
+     */
+    struct InodeKeyHash {
+        size_t operator()(const InodeKey& key) const;
+    };
+
+    /**
+     * 单个分区
+     */
+    struct alignas(64) Partition {
+        std::mutex mutex;                                   // 分区互斥锁
+        std::unordered_set<InodeKey, InodeKeyHash> inodes;  // 分区内的文件标识
+    };
+
+    std::vector<std::unique_ptr<Partition>> partitions_;  // 分区列表
+
+    /**
+     * 获取文件标识所属分区
+     * @param key 文件标识
+     * @return 分区
+     */
+    Partition& partitionOf(const InodeKey& key);
+
+public:
+    /**
+     * 构造函数
+     * @param partition_count 分区数量
+     */
+    explicit PartitionedInodeSet(size_t partition_count = 1);
+
+    /**
+     * 清空并重新分区（扫描开始时调用）
+     * @param partition_count 分区数量
+     */
+    void reset(size_t partition_count);
+
+    /**
+     * 检查并记录文件（线程安全）
+     * @param device 设备号
+     * @param inode inode 号
+     * @param record 未记录过时是否加入集合（为 false 时只检查）
+     * @return 是否为首次出现
+     */
+    bool checkAndInsert(uint64_t device, uint64_t inode, bool record = true);
+};
+
+} // namespace filesystem
+} // namespace brisk
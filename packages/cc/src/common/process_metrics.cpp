@@ -0,0 +1,310 @@
+#include "process_metrics.h"
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+namespace brisk {
+namespace filesystem {
+
+const uint64_t ProcessMetrics::DURATION_BUCKETS_MS[DURATION_BUCKET_COUNT] = {
+    1, 5, 10, 50, 100, 500, 1000, 5000, 10000, 30000, 60000, 300000
+};
+
+namespace {
+
+constexpr int SYSCALL_TYPES = static_cast<int>(SyscallType::COUNT);
+
+/**
+ * 单个线程的系统调用计数分片（只由所属线程写入）
+ */
+struct SyscallShard {
+    std::atomic<uint64_t> counts[SYSCALL_TYPES];
+
+    SyscallShard() {
+        for (auto& count : counts) {
+            count.store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+/**
+ * 分片登记表：活动分片供读取时汇总，退出线程的分片并入累计值后放入空闲列表复用
+ */
+struct ShardRegistry {
+    std::mutex mutex;
+    std::vector<SyscallShard*> active;      // 活动线程的分片
+    std::vector<SyscallShard*> idle;        // 可复用的分片
+    uint64_t retired[SYSCALL_TYPES] = {};   // 已退出线程的累计值
+
+    SyscallShard* acquire() {
+        std::lock_guard<std::mutex> lock(mutex);
+        SyscallShard* shard;
+        if (idle.empty()) {
+            shard = new SyscallShard();
+        } else {
+            shard = idle.back();
+            idle.pop_back();
+        }
+        active.push_back(shard);
+        return shard;
+    }
+
+    void retire(SyscallShard* shard) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (int i = 0; i < SYSCALL_TYPES; ++i) {
+            retired[i] += shard->counts[i].exchange(0, std::memory_order_relaxed);
+        }
+        for (size_t i = 0; i < active.size(); ++i) {
+            if (active[i] == shard) {
+                active[i] = active.back();
+                active.pop_back();
+                break;
+            }
+        }
+        idle.push_back(shard);
+    }
+
+    void totals(uint64_t* counts) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (int i = 0; i < SYSCALL_TYPES; ++i) {
+            counts[i] = retired[i];
+        }
+        for (SyscallShard* shard : active) {
+            for (int i = 0; i < SYSCALL_TYPES; ++i) {
+                counts[i] += shard->counts[i].load(std::memory_order_relaxed);
+            }
+        }
+    }
+};
+
+ShardRegistry& shardRegistry() {
+    // 不析构：线程局部分片可能在静态对象析构后才退出
+    static ShardRegistry* registry = new ShardRegistry();
+    return *registry;
+}
+
+/**
+ * 线程局部的分片句柄，线程退出时归还分片
+ */
+struct ShardHandle {
+    SyscallShard* shard = nullptr;
+
+    ~ShardHandle() {
+        if (shard) {
+            shardRegistry().retire(shard);
+        }
+    }
+};
+
+thread_local ShardHandle t_shard;
+
+const char* const OPERATION_NAMES[] = {"calculate", "tree", "export"};
+const char* const ERROR_TYPE_NAMES[] = {"access", "open", "list", "not_found", "timeout", "memory_limit",
+                                        "thread", "other"};
+const char* const SYSCALL_NAMES[] = {"getdents", "stat", "open", "close"};
+
+/**
+ * 追加一行 "name{labels} value"
+ */
+void appendSample(std::string& out, const char* name, const std::string& labels, uint64_t value) {
+    out += name;
+    if (!labels.empty()) {
+        out += '{';
+        out += labels;
+        out += '}';
+    }
+    out += ' ';
+    out += std::to_string(value);
+    out += '\n';
+}
+
+/**
+ * 追加 TYPE / HELP（/ UNIT）元数据
+ */
+void appendFamily(std::string& out, const char* name, const char* type, const char* unit, const char* help) {
+    out += "# TYPE ";
+    out += name;
+    out += ' ';
+    out += type;
+    out += '\n';
+    if (unit) {
+        out += "# UNIT ";
+        out += name;
+        out += ' ';
+        out += unit;
+        out += '\n';
+    }
+    out += "# HELP ";
+    out += name;
+    out += ' ';
+    out += help;
+    out += '\n';
+}
+
+/**
+ * 毫秒转换为秒的文本
+ */
+std::string millisecondsToSeconds(uint64_t ms) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%llu.%03llu", static_cast<unsigned long long>(ms / 1000),
+                  static_cast<unsigned long long>(ms % 1000));
+    return buffer;
+}
+
+} // namespace
+
+void countProcessSyscall(SyscallType type) {
+    ProcessMetrics::countSyscall(type);
+}
+
+ProcessMetrics::ProcessMetrics() {
+    for (auto& operation : operations_) {
+        operation.scans.store(0);
+        operation.failures.store(0);
+        operation.duration_ms_sum.store(0);
+        for (auto& bucket : operation.duration_buckets) {
+            bucket.store(0);
+        }
+    }
+    files_.store(0);
+    directories_.store(0);
+    symlinks_.store(0);
+    bytes_.store(0);
+    for (auto& error : errors_) {
+        error.store(0);
+    }
+    coalesced_.store(0);
+}
+
+ProcessMetrics& ProcessMetrics::instance() {
+    static ProcessMetrics* metrics = new ProcessMetrics();
+    return *metrics;
+}
+
+void ProcessMetrics::countSyscall(SyscallType type) {
+    SyscallShard* shard = t_shard.shard;
+    if (!shard) {
+        shard = t_shard.shard = shardRegistry().acquire();
+    }
+    // 单写者：读-改-写无需原子指令，读取端只需看到完整的值
+    std::atomic<uint64_t>& count = shard->counts[static_cast<int>(type)];
+    count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+void ProcessMetrics::recordScan(MetricOperation operation, uint64_t duration_ms, bool failed) {
+    OperationStats& stats = operations_[static_cast<int>(operation)];
+    stats.scans.fetch_add(1, std::memory_order_relaxed);
+    if (failed) {
+        stats.failures.fetch_add(1, std::memory_order_relaxed);
+    }
+    stats.duration_ms_sum.fetch_add(duration_ms, std::memory_order_relaxed);
+    for (size_t i = 0; i < DURATION_BUCKET_COUNT; ++i) {
+        if (duration_ms <= DURATION_BUCKETS_MS[i]) {
+            stats.duration_buckets[i].fetch_add(1, std::memory_order_relaxed);
+            break;
+        }
+    }
+}
+
+void ProcessMetrics::recordResult(const CalculationResult& result) {
+    files_.fetch_add(result.file_count, std::memory_order_relaxed);
+    directories_.fetch_add(result.directory_count, std::memory_order_relaxed);
+    symlinks_.fetch_add(result.link_count, std::memory_order_relaxed);
+    bytes_.fetch_add(result.total_size, std::memory_order_relaxed);
+    for (const auto& error : result.errors) {
+        errors_[static_cast<int>(classifyError(error))].fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void ProcessMetrics::recordCoalesced() {
+    coalesced_.fetch_add(1, std::memory_order_relaxed);
+}
+
+MetricErrorType ProcessMetrics::classifyError(const std::string& message) {
+    static const struct {
+        const char* prefix;
+        MetricErrorType type;
+    } prefixes[] = {
+        {"Cannot access", MetricErrorType::ACCESS},
+        {"Cannot open directory", MetricErrorType::OPEN},
+        {"Cannot list directory", MetricErrorType::LIST},
+        {"Path not found", MetricErrorType::NOT_FOUND},
+        {"Operation timed out", MetricErrorType::TIMEOUT},
+        {"Memory limit exceeded", MetricErrorType::MEMORY_LIMIT},
+        {"Thread error", MetricErrorType::THREAD},
+    };
+    for (const auto& entry : prefixes) {
+        if (message.compare(0, std::char_traits<char>::length(entry.prefix), entry.prefix) == 0) {
+            return entry.type;
+        }
+    }
+    return MetricErrorType::OTHER;
+}
+
+std::string ProcessMetrics::render() const {
+    std::string out;
+    out.reserve(4096);
+
+    appendFamily(out, "get_folder_scans", "counter", nullptr, "Scans executed by the native layer.");
+    for (int i = 0; i < static_cast<int>(MetricOperation::COUNT); ++i) {
+        appendSample(out, "get_folder_scans_total", std::string("operation=\"") + OPERATION_NAMES[i] + "\"",
+                     operations_[i].scans.load(std::memory_order_relaxed));
+    }
+
+    appendFamily(out, "get_folder_scan_failures", "counter", nullptr, "Scans that failed with an exception.");
+    for (int i = 0; i < static_cast<int>(MetricOperation::COUNT); ++i) {
+        appendSample(out, "get_folder_scan_failures_total", std::string("operation=\"") + OPERATION_NAMES[i] + "\"",
+                     operations_[i].failures.load(std::memory_order_relaxed));
+    }
+
+    appendFamily(out, "get_folder_scan_duration_seconds", "histogram", "seconds", "Wall-clock duration of scans.");
+    for (int i = 0; i < static_cast<int>(MetricOperation::COUNT); ++i) {
+        const OperationStats& stats = operations_[i];
+        std::string operation = std::string("operation=\"") + OPERATION_NAMES[i] + "\"";
+        uint64_t cumulative = 0;
+        for (size_t b = 0; b < DURATION_BUCKET_COUNT; ++b) {
+            cumulative += stats.duration_buckets[b].load(std::memory_order_relaxed);
+            appendSample(out, "get_folder_scan_duration_seconds_bucket",
+                         operation + ",le=\"" + millisecondsToSeconds(DURATION_BUCKETS_MS[b]) + "\"", cumulative);
+        }
+        // 计数取自同一快照之后读取，保证 +Inf 桶不小于各有限桶
+        uint64_t count = std::max(stats.scans.load(std::memory_order_relaxed), cumulative);
+        appendSample(out, "get_folder_scan_duration_seconds_bucket", operation + ",le=\"+Inf\"", count);
+        appendSample(out, "get_folder_scan_duration_seconds_count", operation, count);
+        out += "get_folder_scan_duration_seconds_sum{" + operation + "} " +
+               millisecondsToSeconds(stats.duration_ms_sum.load(std::memory_order_relaxed)) + "\n";
+    }
+
+    appendFamily(out, "get_folder_entries", "counter", nullptr, "Entries counted by folder size calculations.");
+    appendSample(out, "get_folder_entries_total", "type=\"file\"", files_.load(std::memory_order_relaxed));
+    appendSample(out, "get_folder_entries_total", "type=\"directory\"", directories_.load(std::memory_order_relaxed));
+    appendSample(out, "get_folder_entries_total", "type=\"symlink\"", symlinks_.load(std::memory_order_relaxed));
+
+    appendFamily(out, "get_folder_scanned_bytes", "counter", "bytes", "Bytes counted by folder size calculations.");
+    appendSample(out, "get_folder_scanned_bytes_total", "", bytes_.load(std::memory_order_relaxed));
+
+    appendFamily(out, "get_folder_errors", "counter", nullptr, "Errors reported by scans, by type.");
+    for (int i = 0; i < static_cast<int>(MetricErrorType::COUNT); ++i) {
+        appendSample(out, "get_folder_errors_total", std::string("type=\"") + ERROR_TYPE_NAMES[i] + "\"",
+                     errors_[i].load(std::memory_order_relaxed));
+    }
+
+    appendFamily(out, "get_folder_coalesced_requests", "counter", nullptr,
+                 "Requests served by an in-flight or cached identical scan.");
+    appendSample(out, "get_folder_coalesced_requests_total", "", coalesced_.load(std::memory_order_relaxed));
+
+    uint64_t syscalls[SYSCALL_TYPES];
+    shardRegistry().totals(syscalls);
+    appendFamily(out, "get_folder_syscalls", "counter", nullptr, "Filesystem system calls issued by traversals.");
+    for (int i = 0; i < SYSCALL_TYPES; ++i) {
+        appendSample(out, "get_folder_syscalls_total", std::string("syscall=\"") + SYSCALL_NAMES[i] + "\"",
+                     syscalls[i]);
+    }
+
+    out += "# EOF\n";
+    return out;
+}
+
+} // namespace filesystem
+} // namespace brisk
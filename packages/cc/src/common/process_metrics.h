@@ -0,0 +1,124 @@
+#pragma once
+
+#include "filesystem_common.h"
+#include "latency_histogram.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace brisk {
+namespace filesystem {
+
+/**
+ * 计入进程级指标的操作
+ */
+enum class MetricOperation {
+    CALCULATE,      // 计算文件夹大小
+    TREE,           // 构建目录树
+    EXPORT,         // 导出目录树
+    COUNT
+};
+
+/**
+ * 按类型统计的扫描错误
+ */
+enum class MetricErrorType {
+    ACCESS,         // 无法访问（stat 失败）
+    OPEN,           // 无法打开目录
+    LIST,           // 无法列出目录
+    NOT_FOUND,      // 路径不存在
+    TIMEOUT,        // 操作超时
+    MEMORY_LIMIT,   // 超出内存上限
+    THREAD,         // 工作线程异常
+    OTHER,          // 其他
+    COUNT
+};
+
+/**
+ * 进程级累计指标
+ *
+ * 在进程生命周期内累计所有扫描的次数、耗时分布、项目数、字节数、按类型的错误数与系统调用次数，
+ * 以 OpenMetrics 文本格式输出。系统调用计数位于遍历热路径上，由每个线程写入自己的分片
+ * （单写者，无锁前缀指令），线程退出时分片并入累计值后回收复用；其余指标在扫描结束时一次性累加。
+ */
+class ProcessMetrics {
+public:
+    static constexpr size_t DURATION_BUCKET_COUNT = 12;   // 耗时直方图的有限桶数
+
+    /**
+     * 耗时直方图各桶的上界（毫秒）
+     */
+    static const uint64_t DURATION_BUCKETS_MS[DURATION_BUCKET_COUNT];
+
+private:
+    /**
+     * 单个操作的扫描统计
+     */
+    struct OperationStats {
+        std::atomic<uint64_t> scans;                                    // 扫描次数
+        std::atomic<uint64_t> failures;                                 // 失败（抛出异常）次数
+        std::atomic<uint64_t> duration_ms_sum;                          // 耗时之和（毫秒）
+        std::atomic<uint64_t> duration_buckets[DURATION_BUCKET_COUNT];  // 各桶计数（不累积）
+    };
+
+    OperationStats operations_[static_cast<int>(MetricOperation::COUNT)];   // 各操作的统计
+    std::atomic<uint64_t> files_;                                           // 文件数
+    std::atomic<uint64_t> directories_;                                     // 目录数
+    std::atomic<uint64_t> symlinks_;                                        // 符号链接数
+    std::atomic<uint64_t> bytes_;                                           // 统计的字节数
+    std::atomic<uint64_t> errors_[static_cast<int>(MetricErrorType::COUNT)]; // 各类型错误数
+    std::atomic<uint64_t> coalesced_;                                       // 复用其他扫描结果的请求数
+
+    ProcessMetrics();
+
+public:
+    /**
+     * 获取全局实例
+     */
+    static ProcessMetrics& instance();
+
+    ProcessMetrics(const ProcessMetrics&) = delete;
+    ProcessMetrics& operator=(const ProcessMetrics&) = delete;
+
+    /**
+     * 记录一次系统调用（写入当前线程的分片）
+     * @param type 系统调用类型
+     */
+    static void countSyscall(SyscallType type);
+
+    /**
+     * 记录一次扫描
+     * @param operation 操作
+     * @param duration_ms 耗时（毫秒）
+     * @param failed 是否失败
+     */
+    void recordScan(MetricOperation operation, uint64_t duration_ms, bool failed);
+
+    /**
+     * 累加扫描结果中的项目数、字节数与错误数
+     * @param result 扫描结果
+     */
+    void recordResult(const CalculationResult& result);
+
+    /**
+     * 记录一次复用进行中或缓存的扫描结果的请求
+     */
+    void recordCoalesced();
+
+    /**
+     * 按错误信息归类错误
+     * @param message 错误信息
+     * @return 错误类型
+     */
+    static MetricErrorType classifyError(const std::string& message);
+
+    /**
+     * 以 OpenMetrics 文本格式输出全部指标（以 "# EOF" 结尾）
+     * @return 指标文本
+     */
+    std::string render() const;
+};
+
+} // namespace filesystem
+} // namespace brisk
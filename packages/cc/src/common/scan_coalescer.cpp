@@ -0,0 +1,155 @@
+#include "scan_coalescer.h"
+#include <sstream>
+
+#ifdef PLATFORM_WINDOWS
+#include <Windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace brisk {
+namespace filesystem {
+
+ScanCoalescer& ScanCoalescer::instance() {
+    static ScanCoalescer coalescer;
+    return coalescer;
+}
+
+std::string ScanCoalescer::canonicalPath(const std::string& path) {
+#ifdef PLATFORM_WINDOWS
+    // Win32 本身按词法解析 ".."（先于文件系统），GetFullPathName 的结果与打开时一致
+    char buffer[MAX_PATH];
+    DWORD length = GetFullPathNameA(path.c_str(), MAX_PATH, buffer, nullptr);
+    std::string absolute = (length > 0 && length < MAX_PATH) ? std::string(buffer, length) : path;
+    return Utils::normalizePath(absolute);
+#else
+    std::string absolute = path;
+    if (absolute.empty() || absolute[0] != '/') {
+        char cwd[4096];
+        if (getcwd(cwd, sizeof(cwd))) {
+            absolute = std::string(cwd) + "/" + absolute;
+        }
+    }
+
+    // 保留 ".."：前一段是符号链接时，"a/.." 并不等于当前目录，不访问文件系统无法消除
+    std::string canonical;
+    std::istringstream stream(absolute);
+    std::string segment;
+    while (std::getline(stream, segment, '/')) {
+        if (segment.empty() || segment == ".") {
+            continue;
+        }
+        canonical += "/" + segment;
+    }
+    return canonical.empty() ? "/" : canonical;
+#endif
+}
+
+std::string ScanCoalescer::makeKey(const std::string& path, const CalculationOptions& options) {
+    // 新增影响扫描结果的选项时需同步加入键中
+    std::ostringstream key;
+    key << canonicalPath(path) << '\0'
+        << options.include_hidden << options.inode_check << options.include_link << options.follow_symlinks
+        << options.detect_duplicates << options.duplicate_content_hash << options.aggregate_packages
+        << options.latency_histograms << options.shape_profile << options.project_quota << options.numa_aware << options.include_directory_size << ' '
+        << options.max_depth << ' ' << options.max_threads << ' ' << options.slow_directory_limit << ' '
+        << options.shape_profile_limit << ' '
+        << options.memory_limit << ' ' << options.pipeline_listers << ' ' << options.pipeline_stat_workers << ' '
+        << options.pipeline_queue_depth << ' ' << options.operation_timeout_ms;
+
+    // 带长度前缀，避免不同的列表拼接出相同的键
+    key << " i" << options.ignore_patterns.size();
+    for (const auto& pattern : options.ignore_patterns) {
+        key << ' ' << pattern.size() << ':' << pattern;
+    }
+    key << " c" << options.cpu_affinity.size();
+    for (uint32_t cpu : options.cpu_affinity) {
+        key << ' ' << cpu;
+    }
+    return key.str();
+}
+
+void ScanCoalescer::evictExpired(uint64_t now_us) {
+    for (auto it = cache_.begin(); it != cache_.end();) {
+        if (it->second.expires_at_us <= now_us) {
+            it = cache_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+bool ScanCoalescer::lookup(const std::string& key, CalculationResult& result) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    evictExpired(Utils::getMonotonicMicros());
+
+    auto it = cache_.find(key);
+    if (it == cache_.end()) {
+        return false;
+    }
+
+    result = it->second.result;
+    result.coalesced = true;
+    return true;
+}
+
+bool ScanCoalescer::joinOrLead(const std::string& key, Waiter waiter) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = in_flight_.find(key);
+    if (it == in_flight_.end()) {
+        in_flight_.emplace(key, std::vector<Waiter>());
+        return false;
+    }
+
+    it->second.push_back(std::move(waiter));
+    return true;
+}
+
+void ScanCoalescer::store(const std::string& key, const CalculationResult& result, uint32_t ttl_ms) {
+    if (ttl_ms == 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t now = Utils::getMonotonicMicros();
+    evictExpired(now);
+    cache_[key] = {result, now + static_cast<uint64_t>(ttl_ms) * 1000};
+}
+
+void ScanCoalescer::complete(const std::string& key, const CalculationResult* result, const std::string& error,
+                             uint32_t ttl_ms) {
+    std::vector<Waiter> waiters;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        uint64_t now = Utils::getMonotonicMicros();
+        evictExpired(now);
+
+        auto it = in_flight_.find(key);
+        if (it != in_flight_.end()) {
+            waiters = std::move(it->second);
+            in_flight_.erase(it);
+        }
+
+        if (result && ttl_ms > 0) {
+            cache_[key] = {*result, now + static_cast<uint64_t>(ttl_ms) * 1000};
+        }
+    }
+
+    // 在锁外通知，回调中可以发起新的请求
+    if (!result) {
+        for (const auto& waiter : waiters) {
+            waiter(nullptr, error);
+        }
+        return;
+    }
+
+    CalculationResult shared = *result;
+    shared.coalesced = true;
+    for (const auto& waiter : waiters) {
+        waiter(&shared, error);
+    }
+}
+
+} // namespace filesystem
+} // namespace brisk
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "filesystem_common.h"
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace brisk {
+namespace filesystem {
+
+/**
+ * 扫描请求合并（single-flight）
+ *
+ * 以（规范化路径, 配置选项）为键：扫描进行中到达的相同请求加入同一次扫描，完成后共享结果；
+ * 可选在完成后的 TTL 内直接返回缓存结果。路径只做词法规范化，不访问文件系统，
+ * 避免在调用线程上阻塞于失联的挂载点（经不同符号链接到达的同一目录不会合并）
+ */
+class ScanCoalescer {
+public:
+    /**
+     * 等待者回调
+     * @param result 扫描结果，扫描失败时为空
+     * @param error 扫描失败的错误信息
+     */
+    using Waiter = std::function<void(const CalculationResult* result, const std::string& error)>;
+
+private:
+    /**
+     * 缓存的结果
+     */
+    struct CachedResult {
+        CalculationResult result;             // 扫描结果
+        uint64_t expires_at_us;               // 过期时间（单调时钟，微秒）
+    };
+
+    std::mutex mutex_;                                              // 互斥锁
+    std::unordered_map<std::string, std::vector<Waiter>> in_flight_; // 进行中的扫描 -> 等待者
+    std::unordered_map<std::string, CachedResult> cache_;          // 已完成扫描的缓存结果
+
+    /**
+     * 移除过期的缓存结果（调用方持有锁）
+     * @param now_us 当前单调时间（微秒）
+     */
+    void evictExpired(uint64_t now_us);
+
+public:
+    /**
+     * 获取进程级实例
+     * @return 实例
+     */
+    static ScanCoalescer& instance();
+
+    /**
+     * 词法规范化路径：转为绝对路径，消除 "."、重复与末尾的斜杠（POSIX 上保留 ".."，Windows 上按系统规则消除）
+     * @param path 原始路径
+     * @return 规范化后的路径
+     */
+    static std::string canonicalPath(const std::string& path);
+
+    /**
+     * 生成合并键（包含所有影响扫描结果的选项，合并相关的选项除外）
+     * @param path 扫描路径
+     * @param options 配置选项
+     * @return 合并键
+     */
+    static std::string makeKey(const std::string& path, const CalculationOptions& options);
+
+    /**
+     * 查找未过期的缓存结果
+     * @param key 合并键
+     * @param result 输出缓存结果
+     * @return 是否命中
+     */
+    bool lookup(const std::string& key, CalculationResult& result);
+
+    /**
+     * 加入进行中的相同扫描，没有时登记为新的扫描
+     * @param key 合并键
+     * @param waiter 加入成功时，扫描完成后调用的回调
+     * @return 是否已加入（false 表示调用方需要发起扫描并在完成后调用 complete）
+     */
+    bool joinOrLead(const std::string& key, Waiter waiter);
+
+    /**
+     * 按 TTL 缓存结果（不影响进行中的扫描）
+     * @param key 合并键
+     * @param result 扫描结果
+     * @param ttl_ms 结果缓存时间（毫秒，0 为不缓存）
+     */
+    void store(const std::string& key, const CalculationResult& result, uint32_t ttl_ms);
+
+    /**
+     * 完成扫描：通知所有等待者，并按 TTL 缓存结果
+     * @param key 合并键
+     * @param result 扫描结果，扫描失败时为空
+     * @param error 扫描失败的错误信息
+     * @param ttl_ms 结果缓存时间（毫秒，0 为不缓存）
+     */
+    void complete(const std::string& key, const CalculationResult* result, const std::string& error,
+                  uint32_t ttl_ms);
+};
+
+} // namespace filesystem
+} // namespace brisk
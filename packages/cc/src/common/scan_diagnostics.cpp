@@ -0,0 +1,51 @@
+#include "scan_diagnostics.h"
+#include <algorithm>
+
+namespace brisk {
+namespace filesystem {
+
+namespace {
+
+/**
+ * 最小堆比较：耗时较大的排在后面
+ */
+bool slowerThan(const SlowDirectory& a, const SlowDirectory& b) {
+    return a.totalMicros() > b.totalMicros();
+}
+
+} // namespace
+
+void SlowDirectoryHeap::push(std::vector<SlowDirectory>& heap, SlowDirectory&& entry, size_t limit) {
+    if (limit == 0) {
+        return;
+    }
+
+    if (heap.size() < limit) {
+        heap.push_back(std::move(entry));
+        std::push_heap(heap.begin(), heap.end(), slowerThan);
+        return;
+    }
+
+    // 比堆顶（已记录中最快的）还快，直接丢弃
+    if (entry.totalMicros() <= heap.front().totalMicros()) {
+        return;
+    }
+
+    std::pop_heap(heap.begin(), heap.end(), slowerThan);
+    heap.back() = std::move(entry);
+    std::push_heap(heap.begin(), heap.end(), slowerThan);
+}
+
+void SlowDirectoryHeap::merge(std::vector<SlowDirectory>& heap, std::vector<SlowDirectory>& other, size_t limit) {
+    for (auto& entry : other) {
+        push(heap, std::move(entry), limit);
+    }
+    other.clear();
+}
+
+void SlowDirectoryHeap::finalize(std::vector<SlowDirectory>& heap) {
+    std::sort(heap.begin(), heap.end(), slowerThan);
+}
+
+} // namespace filesystem
+} // namespace brisk
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "filesystem_common.h"
+
+namespace brisk {
+namespace filesystem {
+
+/**
+ * 慢目录有界最小堆
+ * 每个遍历线程在自己的结果中维护容量为 N 的最小堆，堆顶为当前最快的记录，
+ * 新记录只需与堆顶比较，开销与目录数量成线性且与 N 的对数相关
+ */
+class SlowDirectoryHeap {
+public:
+    /**
+     * 加入一条记录，超出容量时淘汰最快的记录
+     * @param heap 堆（std::vector 存储）
+     * @param entry 目录记录
+     * @param limit 容量
+     */
+    static void push(std::vector<SlowDirectory>& heap, SlowDirectory&& entry, size_t limit);
+
+    /**
+     * 合并另一个堆（用于合并线程结果）
+     * @param heap 目标堆
+     * @param other 来源堆
+     * @param limit 容量
+     */
+    static void merge(std::vector<SlowDirectory>& heap, std::vector<SlowDirectory>& other, size_t limit);
+
+    /**
+     * 将堆转换为按耗时降序排列的列表
+     * @param heap 堆
+     */
+    static void finalize(std::vector<SlowDirectory>& heap);
+};
+
+} // namespace filesystem
+} // namespace brisk
@@ -0,0 +1,148 @@
+#include "scan_scheduler.h"
+#include <algorithm>
+#include <thread>
+
+namespace brisk {
+namespace filesystem {
+
+ScanClient::ScanClient(ScanPriority priority, ScanScheduler& scheduler)
+    : scheduler_(scheduler),
+      weight_(ScanScheduler::weightOf(priority)),
+      virtual_time_(0),
+      waiting_(0),
+      granted_(0) {
+    std::lock_guard<std::mutex> lock(scheduler_.mutex_);
+
+    // 新扫描从当前最小的虚拟时间开始，既不因迟到获得补偿，也不落后于已有扫描
+    if (!scheduler_.clients_.empty()) {
+        uint64_t start = UINT64_MAX;
+        for (const ScanClient* client : scheduler_.clients_) {
+            start = std::min(start, client->virtual_time_.load(std::memory_order_relaxed));
+        }
+        virtual_time_.store(start, std::memory_order_relaxed);
+    }
+    scheduler_.clients_.push_back(this);
+}
+
+ScanClient::~ScanClient() {
+    std::lock_guard<std::mutex> lock(scheduler_.mutex_);
+    auto& clients = scheduler_.clients_;
+    clients.erase(std::remove(clients.begin(), clients.end(), this), clients.end());
+}
+
+void ScanClient::acquire() {
+    virtual_time_.fetch_add(ScanScheduler::SERVICE_UNIT / weight_, std::memory_order_relaxed);
+
+    std::unique_lock<std::mutex> lock(scheduler_.mutex_);
+    if (scheduler_.in_use_ < scheduler_.capacity_ && scheduler_.waiting_.load(std::memory_order_relaxed) == 0) {
+        scheduler_.in_use_++;
+        return;
+    }
+    scheduler_.waitLocked(*this, lock);
+}
+
+void ScanClient::release() {
+    std::lock_guard<std::mutex> lock(scheduler_.mutex_);
+    scheduler_.in_use_--;
+    scheduler_.dispatchLocked();
+}
+
+void ScanClient::checkpoint() {
+    uint64_t now = virtual_time_.fetch_add(ScanScheduler::SERVICE_UNIT / weight_, std::memory_order_relaxed);
+
+    // 没有线程在等待时不加锁
+    if (scheduler_.waiting_.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(scheduler_.mutex_);
+    bool behind = false;
+    for (const ScanClient* client : scheduler_.clients_) {
+        if (client != this && client->waiting_ > client->granted_ &&
+            client->virtual_time_.load(std::memory_order_relaxed) < now) {
+            behind = true;
+            break;
+        }
+    }
+    if (!behind) {
+        return;
+    }
+
+    // 让出槽位给服务量更少的扫描，再按虚拟时间重新排队
+    scheduler_.in_use_--;
+    scheduler_.waitLocked(*this, lock);
+}
+
+ScanScheduler::ScanScheduler() : in_use_(0), waiting_(0) {
+    // 遍历以 I/O 为主，槽位数取硬件线程数的两倍
+    uint32_t hardware_threads = std::thread::hardware_concurrency();
+    capacity_ = std::max(hardware_threads * 2, 16u);
+}
+
+ScanScheduler& ScanScheduler::instance() {
+    static ScanScheduler scheduler;
+    return scheduler;
+}
+
+uint32_t ScanScheduler::weightOf(ScanPriority priority) {
+    switch (priority) {
+        case ScanPriority::INTERACTIVE:
+            return 16;
+        case ScanPriority::BATCH:
+            return 1;
+        default:
+            return 4;
+    }
+}
+
+void ScanScheduler::setCapacity(uint32_t capacity) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_ = std::max(capacity, 1u);
+    dispatchLocked();
+}
+
+uint32_t ScanScheduler::capacity() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return capacity_;
+}
+
+uint32_t ScanScheduler::active() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return in_use_;
+}
+
+void ScanScheduler::dispatchLocked() {
+    while (in_use_ < capacity_) {
+        ScanClient* next = nullptr;
+        uint64_t next_time = UINT64_MAX;
+        for (ScanClient* client : clients_) {
+            uint64_t time = client->virtual_time_.load(std::memory_order_relaxed);
+            if (client->waiting_ > client->granted_ && time < next_time) {
+                next = client;
+                next_time = time;
+            }
+        }
+        if (!next) {
+            return;
+        }
+
+        in_use_++;
+        next->granted_++;
+        next->granted_cv_.notify_one();
+    }
+}
+
+void ScanScheduler::waitLocked(ScanClient& client, std::unique_lock<std::mutex>& lock) {
+    client.waiting_++;
+    waiting_.fetch_add(1, std::memory_order_relaxed);
+    dispatchLocked();
+
+    client.granted_cv_.wait(lock, [&client]() { return client.granted_ > 0; });
+
+    client.granted_--;
+    client.waiting_--;
+    waiting_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+} // namespace filesystem
+} // namespace brisk
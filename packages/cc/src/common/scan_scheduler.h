@@ -0,0 +1,192 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace brisk {
+namespace filesystem {
+
+/**
+ * 扫描优先级
+ */
+enum class ScanPriority {
+    INTERACTIVE,    // 交互式（权重 16）
+    NORMAL,         // 普通（权重 4）
+    BATCH           // 批处理（权重 1）
+};
+
+class ScanScheduler;
+
+/**
+ * 参与调度的单次扫描
+ * 扫描的每个工作线程在处理目录前持有一个执行槽位，槽位在所有扫描之间共享
+ */
+class ScanClient {
+    friend class ScanScheduler;
+
+private:
+    ScanScheduler& scheduler_;              // 所属调度器
+    uint32_t weight_;                       // 权重
+    std::atomic<uint64_t> virtual_time_;    // 虚拟时间（已获得的服务量 / 权重）
+    uint32_t waiting_;                      // 等待槽位的线程数（调度器锁保护）
+    uint32_t granted_;                      // 已分配但尚未被领取的槽位数（调度器锁保护）
+    std::condition_variable granted_cv_;    // 槽位分配通知
+
+public:
+    /**
+     * 构造函数（加入调度）
+     * @param priority 优先级
+     * @param scheduler 调度器
+     */
+    explicit ScanClient(ScanPriority priority, ScanScheduler& scheduler);
+
+    /**
+     * 析构函数（退出调度）
+     */
+    ~ScanClient();
+
+    ScanClient(const ScanClient&) = delete;
+    ScanClient& operator=(const ScanClient&) = delete;
+
+    /**
+     * 获取执行槽位，没有空闲槽位时阻塞
+     */
+    void acquire();
+
+    /**
+     * 归还执行槽位
+     */
+    void release();
+
+    /**
+     * 调度点（每处理一个目录调用一次）：记录服务量，
+     * 有虚拟时间更小的扫描在等待时让出槽位并重新排队
+     */
+    void checkpoint();
+};
+
+/**
+ * 扫描调度器（进程级）
+ *
+ * 所有扫描共享固定数量的执行槽位，各扫描有独立的等待队列。
+ * 槽位空出时分配给虚拟时间最小的扫描（加权公平排队），虚拟时间按处理的目录数除以权重增长，
+ * 因此大扫描进行中启动的交互式小扫描几乎立即获得大部分槽位，以接近单独运行的耗时完成
+ */
+class ScanScheduler {
+    friend class ScanClient;
+
+private:
+    std::mutex mutex_;                      // 互斥锁
+    uint32_t capacity_;                     // 执行槽位数
+    uint32_t in_use_;                       // 已占用（含已分配未领取）的槽位数
+    std::atomic<uint32_t> waiting_;         // 所有扫描中等待槽位的线程数
+    std::vector<ScanClient*> clients_;      // 参与调度的扫描
+
+    static constexpr uint64_t SERVICE_UNIT = 1 << 20;  // 单位服务量（按权重折算为虚拟时间）
+
+    ScanScheduler();
+
+    /**
+     * 将空闲槽位分配给等待中虚拟时间最小的扫描（调用方持有锁）
+     */
+    void dispatchLocked();
+
+    /**
+     * 排队等待槽位（调用方持有锁）
+     * @param client 扫描
+     * @param lock 调度器锁
+     */
+    void waitLocked(ScanClient& client, std::unique_lock<std::mutex>& lock);
+
+public:
+    /**
+     * 获取进程级实例
+     * @return 调度器
+     */
+    static ScanScheduler& instance();
+
+    /**
+     * 获取优先级对应的权重
+     * @param priority 优先级
+     * @return 权重
+     */
+    static uint32_t weightOf(ScanPriority priority);
+
+    /**
+     * 设置执行槽位数
+     * @param capacity 槽位数（至少为 1）
+     */
+    void setCapacity(uint32_t capacity);
+
+    /**
+     * 获取执行槽位数
+     * @return 槽位数
+     */
+    uint32_t capacity();
+
+    /**
+     * 获取已占用的槽位数
+     * @return 槽位数
+     */
+    uint32_t active();
+
+    /**
+     * 获取等待槽位的线程数
+     * @return 线程数
+     */
+    uint32_t waiting() const { return waiting_.load(std::memory_order_relaxed); }
+};
+
+/**
+ * 执行槽位（RAII，扫描为空时不参与调度）
+ */
+class ScanSlot {
+private:
+    ScanClient* client_;                    // 扫描
+
+public:
+    explicit ScanSlot(ScanClient* client) : client_(client) {
+        if (client_) {
+            client_->acquire();
+        }
+    }
+
+    ~ScanSlot() {
+        if (client_) {
+            client_->release();
+        }
+    }
+
+    ScanSlot(const ScanSlot&) = delete;
+    ScanSlot& operator=(const ScanSlot&) = delete;
+};
+
+/**
+ * 暂时归还执行槽位（RAII），用于等待子任务或队列期间，结束时重新获取
+ */
+class ScanSlotRelease {
+private:
+    ScanClient* client_;                    // 扫描
+
+public:
+    explicit ScanSlotRelease(ScanClient* client) : client_(client) {
+        if (client_) {
+            client_->release();
+        }
+    }
+
+    ~ScanSlotRelease() {
+        if (client_) {
+            client_->acquire();
+        }
+    }
+
+    ScanSlotRelease(const ScanSlotRelease&) = delete;
+    ScanSlotRelease& operator=(const ScanSlotRelease&) = delete;
+};
+
+} // namespace filesystem
+} // namespace brisk
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace brisk {
+namespace filesystem {
+
+/**
+ * 列式快照文件格式
+ *
+ * 文件头 | 行组 0 | 行组 1 | ... | 扩展名字典 | 根路径 | 行组目录 | 文件尾
+ *
+ * 每行对应目录树中的一个节点，按后序排列（子项在前，目录在其全部子项之后），
+ * 因此第 r 行目录的子树恰好是 [r - descendants, r] 的连续行区间。
+ * 每个目录还记录按名称字节序排列的直接子项行号（子项表），
+ * 路径查找时逐级在子项表中二分查找，耗时与目录深度及各级子项数的对数成正比。
+ * 行组内各列连续存放并按 64 字节对齐，可直接内存映射后按列扫描；
+ * 除最后一个行组外每组恰好 ROW_GROUP_ROWS 行，行号到行组的换算为一次除法。
+ * 数值按本机字节序（小端）存放。
+ */
+namespace snapshot {
+
+constexpr char MAGIC[8] = {'G', 'F', 'S', 'N', 'A', 'P', '\0', '\1'};  // 文件头与文件尾的标识
+constexpr uint32_t VERSION = 2;                       // 格式版本
+constexpr uint32_t ROW_GROUP_ROWS = 65536;            // 每个行组的行数
+constexpr uint64_t COLUMN_ALIGNMENT = 64;             // 列起始偏移的对齐字节数
+constexpr uint32_t MAX_EXTENSIONS = 65535;            // 扩展名字典上限（超出的扩展名归入 OTHER_EXTENSION）
+constexpr uint32_t NO_EXTENSION = 0;                  // 无扩展名（目录、无扩展名的文件）
+constexpr uint32_t OTHER_EXTENSION = 0xffffffffu;     // 字典已满后出现的扩展名
+
+/**
+ * 列编号
+ */
+enum Column : uint32_t {
+    SIZE = 0,           // uint64 自身大小
+    TOTAL_SIZE,         // uint64 总大小（包含子项）
+    MODIFIED_TIME,      // uint64 修改时间（毫秒）
+    INODE,              // uint64 inode 号
+    FINGERPRINT,        // uint64 元数据指纹
+    DESCENDANTS,        // uint64 子孙节点数（文件为 0）
+    OWNER,              // uint32 所有者
+    DEPTH,              // uint32 深度
+    EXTENSION,          // uint32 扩展名字典编号
+    NAME_OFFSET,        // uint32 名称在行组名称区中的偏移（行数 + 1 项）
+    CHILD_OFFSET,       // uint32 子项表在行组子项区中的起始项（行数 + 1 项，非目录为空区间）
+    TYPE,               // uint8 ItemType
+    COLUMN_COUNT
+};
+
+/**
+ * 各列单个值的字节数
+ */
+constexpr size_t COLUMN_WIDTH[COLUMN_COUNT] = {8, 8, 8, 8, 8, 8, 4, 4, 4, 4, 4, 1};
+
+/**
+ * 文件头（64 字节）
+ */
+struct FileHeader {
+    char magic[8];              // MAGIC
+    uint32_t version;           // VERSION
+    uint32_t row_group_rows;    // 每个行组的行数
+    uint8_t reserved[48];       // 保留
+};
+
+/**
+ * 行组目录项
+ */
+struct RowGroupEntry {
+    uint64_t first_row;                 // 首行行号
+    uint32_t row_count;                 // 行数
+    uint32_t reserved;                  // 保留
+    uint64_t columns[COLUMN_COUNT];     // 各列起始偏移
+    uint64_t names_offset;              // 名称区起始偏移
+    uint64_t names_size;                // 名称区字节数
+    uint64_t children_offset;           // 子项区起始偏移（uint64 行号，各目录的子项按名称字节序排列）
+    uint64_t children_count;            // 子项区项数
+};
+
+/**
+ * 文件尾（位于文件末尾，64 字节）
+ */
+struct FileFooter {
+    uint64_t row_count;                 // 总行数
+    uint64_t group_count;               // 行组数
+    uint64_t groups_offset;             // 行组目录偏移
+    uint64_t dictionary_offset;         // 扩展名字典偏移（uint32 数量，随后每项 uint32 长度 + 字节）
+    uint64_t root_path_offset;          // 根路径偏移
+    uint64_t root_path_size;            // 根路径字节数
+    uint32_t version;                   // VERSION
+    uint32_t reserved;                  // 保留
+    char magic[8];                      // MAGIC
+};
+
+static_assert(sizeof(FileHeader) == 64, "snapshot header must be 64 bytes");
+static_assert(sizeof(FileFooter) == 64, "snapshot footer must be 64 bytes");
+
+} // namespace snapshot
+
+} // namespace filesystem
+} // namespace brisk
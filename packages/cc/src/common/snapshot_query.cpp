@@ -0,0 +1,386 @@
+#include "snapshot_query.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <system_error>
+#include <thread>
+
+namespace brisk {
+namespace filesystem {
+
+namespace {
+
+constexpr size_t BLOCK_ROWS = 1024;  // 计算过滤掩码的块大小
+constexpr uint32_t DENSE_DEPTH_LIMIT = 4096;  // 按下标聚合的深度上限（PATH_MAX 内的路径深度不超过 2048）
+
+/**
+ * 按任意 64 位键聚合的开放寻址哈希表（线性探测，负载超过一半时扩容）
+ */
+class KeyedAggregates {
+private:
+    std::vector<SnapshotAggregate> slots_;  // 槽位
+    std::vector<uint8_t> used_;             // 槽位是否已占用
+    size_t size_;                           // 已占用的槽位数
+
+public:
+    KeyedAggregates() : slots_(64), used_(64, 0), size_(0) {}
+
+    /**
+     * 获取键对应的聚合（不存在时插入）
+     */
+    SnapshotAggregate& at(uint64_t key) {
+        if ((size_ + 1) * 2 > slots_.size()) {
+            grow();
+        }
+        size_t mask = slots_.size() - 1;
+        size_t index = static_cast<size_t>((key * 0x9e3779b97f4a7c15ULL) >> 32) & mask;
+        while (used_[index] && slots_[index].key != key) {
+            index = (index + 1) & mask;
+        }
+        if (!used_[index]) {
+            used_[index] = 1;
+            slots_[index] = SnapshotAggregate();
+            slots_[index].key = key;
+            size_++;
+        }
+        return slots_[index];
+    }
+
+    /**
+     * 遍历已占用的聚合
+     */
+    template <typename Visitor>
+    void forEach(Visitor visit) const {
+        for (size_t i = 0; i < slots_.size(); ++i) {
+            if (used_[i]) {
+                visit(slots_[i]);
+            }
+        }
+    }
+
+private:
+    void grow() {
+        std::vector<SnapshotAggregate> old_slots;
+        std::vector<uint8_t> old_used;
+        old_slots.swap(slots_);
+        old_used.swap(used_);
+        slots_.resize(old_slots.size() * 2);
+        used_.assign(old_slots.size() * 2, 0);
+        size_ = 0;
+        for (size_t i = 0; i < old_slots.size(); ++i) {
+            if (old_used[i]) {
+                SnapshotAggregate& aggregate = at(old_slots[i].key);
+                aggregate = old_slots[i];
+            }
+        }
+    }
+};
+
+/**
+ * 单个线程的局部聚合结果
+ */
+struct PartialAggregate {
+    std::vector<SnapshotAggregate> dense;                       // 键范围较小的分组（按键下标）
+    KeyedAggregates sparse;                                     // 所有者、时间桶分组
+    uint64_t scanned;                                           // 扫描的行数
+    uint64_t matched;                                           // 匹配的行数
+
+    PartialAggregate() : scanned(0), matched(0) {}
+};
+
+/**
+ * 是否使用按键下标的稠密聚合
+ */
+bool isDense(SnapshotGroupBy group_by) {
+    return group_by != SnapshotGroupBy::OWNER && group_by != SnapshotGroupBy::MODIFIED_TIME;
+}
+
+/**
+ * 以掩码累加到稠密分组（掩码为 0 的行累加 0，无分支）
+ */
+void accumulateDense(std::vector<SnapshotAggregate>& dense, const uint32_t* keys, const uint8_t* mask,
+                     const uint64_t* size, const uint64_t* total_size, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        SnapshotAggregate& aggregate = dense[keys[i]];
+        uint64_t m = mask[i];
+        aggregate.count += m;
+        aggregate.size += size[i] * m;
+        aggregate.total_size += total_size[i] * m;
+    }
+}
+
+/**
+ * 扫描一个行组中的行区间
+ */
+void scanRange(const SnapshotReader& reader, const SnapshotQuery& query, size_t group_index,
+               size_t begin, size_t end, size_t extension_slots, PartialAggregate& partial) {
+    const uint64_t* size = reader.column<uint64_t>(group_index, snapshot::SIZE);
+    const uint64_t* total_size = reader.column<uint64_t>(group_index, snapshot::TOTAL_SIZE);
+    const uint64_t* modified_time = reader.column<uint64_t>(group_index, snapshot::MODIFIED_TIME);
+    const uint32_t* owner = reader.column<uint32_t>(group_index, snapshot::OWNER);
+    const uint32_t* depth = reader.column<uint32_t>(group_index, snapshot::DEPTH);
+    const uint32_t* extension = reader.column<uint32_t>(group_index, snapshot::EXTENSION);
+    const uint8_t* type = reader.column<uint8_t>(group_index, snapshot::TYPE);
+
+    const uint64_t min_size = query.min_size;
+    const uint64_t max_size = query.max_size;
+    const uint8_t type_filter = static_cast<uint8_t>(query.type);
+    const uint8_t match_any_type = query.filter_type ? 0 : 1;
+    const uint64_t bucket = query.time_bucket_ms > 0 ? query.time_bucket_ms : 1;
+
+    uint8_t mask[BLOCK_ROWS];
+    uint32_t keys[BLOCK_ROWS];
+
+    for (size_t block = begin; block < end; block += BLOCK_ROWS) {
+        size_t count = std::min(BLOCK_ROWS, end - block);
+        const uint64_t* block_size = size + block;
+        const uint64_t* block_total = total_size + block;
+
+        // 过滤掩码：按位与组合各条件，不产生分支
+        uint64_t matched = 0;
+        for (size_t i = 0; i < count; ++i) {
+            uint8_t m = static_cast<uint8_t>((block_size[i] >= min_size) & (block_size[i] <= max_size) &
+                                             ((type[block + i] == type_filter) | match_any_type));
+            mask[i] = m;
+            matched += m;
+        }
+        partial.scanned += count;
+        partial.matched += matched;
+        if (matched == 0) {
+            continue;
+        }
+
+        switch (query.group_by) {
+            case SnapshotGroupBy::NONE: {
+                SnapshotAggregate& aggregate = partial.dense[0];
+                uint64_t sum_size = 0;
+                uint64_t sum_total = 0;
+                for (size_t i = 0; i < count; ++i) {
+                    sum_size += block_size[i] * mask[i];
+                    sum_total += block_total[i] * mask[i];
+                }
+                aggregate.count += matched;
+                aggregate.size += sum_size;
+                aggregate.total_size += sum_total;
+                break;
+            }
+            case SnapshotGroupBy::DEPTH: {
+                uint32_t max_depth = 0;
+                for (size_t i = 0; i < count; ++i) {
+                    max_depth = std::max(max_depth, depth[block + i]);
+                }
+                if (max_depth < DENSE_DEPTH_LIMIT) {
+                    if (partial.dense.size() <= max_depth) {
+                        partial.dense.resize(static_cast<size_t>(max_depth) + 1);
+                    }
+                    accumulateDense(partial.dense, depth + block, mask, block_size, block_total, count);
+                    break;
+                }
+                // 深度来自文件，超出上限（损坏的快照）时不按深度分配数组，超出的深度逐行放入哈希表
+                for (size_t i = 0; i < count; ++i) {
+                    if (!mask[i]) {
+                        continue;
+                    }
+                    uint32_t key = depth[block + i];
+                    SnapshotAggregate* aggregate;
+                    if (key < DENSE_DEPTH_LIMIT) {
+                        if (partial.dense.size() <= key) {
+                            partial.dense.resize(static_cast<size_t>(key) + 1);
+                        }
+                        aggregate = &partial.dense[key];
+                    } else {
+                        aggregate = &partial.sparse.at(key);
+                    }
+                    aggregate->count++;
+                    aggregate->size += block_size[i];
+                    aggregate->total_size += block_total[i];
+                }
+                break;
+            }
+            case SnapshotGroupBy::EXTENSION: {
+                // 字典已满后的编号映射到最后一个槽位
+                for (size_t i = 0; i < count; ++i) {
+                    uint32_t id = extension[block + i];
+                    keys[i] = id < extension_slots - 1 ? id : static_cast<uint32_t>(extension_slots - 1);
+                }
+                accumulateDense(partial.dense, keys, mask, block_size, block_total, count);
+                break;
+            }
+            case SnapshotGroupBy::TYPE: {
+                for (size_t i = 0; i < count; ++i) {
+                    keys[i] = std::min<uint32_t>(type[block + i], static_cast<uint32_t>(ItemType::UNKNOWN));
+                }
+                accumulateDense(partial.dense, keys, mask, block_size, block_total, count);
+                break;
+            }
+            case SnapshotGroupBy::OWNER:
+            case SnapshotGroupBy::MODIFIED_TIME: {
+                // 相邻行的键通常相同，缓存上一次查找的结果
+                bool by_owner = query.group_by == SnapshotGroupBy::OWNER;
+                uint64_t last_key = UINT64_MAX;
+                SnapshotAggregate* aggregate = nullptr;
+                for (size_t i = 0; i < count; ++i) {
+                    if (!mask[i]) {
+                        continue;
+                    }
+                    uint64_t key = by_owner ? owner[block + i]
+                                            : modified_time[block + i] - modified_time[block + i] % bucket;
+                    if (key != last_key || !aggregate) {
+                        aggregate = &partial.sparse.at(key);
+                        last_key = key;
+                    }
+                    aggregate->count++;
+                    aggregate->size += block_size[i];
+                    aggregate->total_size += block_total[i];
+                }
+                break;
+            }
+        }
+    }
+}
+
+} // namespace
+
+SnapshotQueryResult SnapshotQueryEngine::execute(const SnapshotReader& reader, const SnapshotQuery& query) {
+    SnapshotQueryResult result;
+    uint64_t start_time = Utils::getMonotonicMicros();
+
+    // 确定行区间：路径前缀对应节点的子树在后序中连续
+    uint64_t lower = 0;
+    uint64_t upper = reader.rowCount();
+    if (!query.path_prefix.empty()) {
+        uint64_t row;
+        if (!reader.locate(query.path_prefix, row)) {
+            result.prefix_found = false;
+            result.duration_us = Utils::getMonotonicMicros() - start_time;
+            return result;
+        }
+        upper = row + 1;
+        lower = row - std::min(row, reader.value64(row, snapshot::DESCENDANTS));
+    }
+    if (lower >= upper) {
+        result.duration_us = Utils::getMonotonicMicros() - start_time;
+        return result;
+    }
+
+    size_t first_group = static_cast<size_t>(lower / snapshot::ROW_GROUP_ROWS);
+    size_t last_group = static_cast<size_t>((upper - 1) / snapshot::ROW_GROUP_ROWS);
+    size_t group_total = last_group - first_group + 1;
+
+    uint32_t thread_count = query.threads;
+    if (thread_count == 0) {
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+    thread_count = static_cast<uint32_t>(std::min<size_t>(thread_count, group_total));
+
+    // 稠密分组的槽位数：扩展名多留一个槽位给字典已满后的扩展名
+    size_t extension_slots = reader.extensionCount() + 2;
+    size_t dense_slots = 0;
+    switch (query.group_by) {
+        case SnapshotGroupBy::NONE: dense_slots = 1; break;
+        case SnapshotGroupBy::EXTENSION: dense_slots = extension_slots; break;
+        case SnapshotGroupBy::TYPE: dense_slots = static_cast<size_t>(ItemType::UNKNOWN) + 1; break;
+        default: break;
+    }
+
+    std::vector<PartialAggregate> partials(thread_count);
+    for (auto& partial : partials) {
+        partial.dense.resize(dense_slots);
+    }
+
+    // 各线程按行组领取任务
+    std::atomic<size_t> next_group(first_group);
+    auto work = [&](PartialAggregate& partial) {
+        size_t group_index;
+        while ((group_index = next_group.fetch_add(1)) <= last_group) {
+            const snapshot::RowGroupEntry& group = reader.group(group_index);
+            uint64_t group_begin = std::max(lower, group.first_row);
+            uint64_t group_end = std::min(upper, group.first_row + group.row_count);
+            scanRange(reader, query, group_index, static_cast<size_t>(group_begin - group.first_row),
+                      static_cast<size_t>(group_end - group.first_row), extension_slots, partial);
+        }
+    };
+
+    // 异常不能逃出线程（std::terminate），先记录，全部线程结束后在调用线程重新抛出
+    std::vector<std::exception_ptr> errors(thread_count);
+    auto guarded = [&](size_t index) {
+        try {
+            work(partials[index]);
+        } catch (...) {
+            errors[index] = std::current_exception();
+            next_group.store(last_group + 1);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (uint32_t i = 1; i < thread_count; ++i) {
+        try {
+            threads.emplace_back(guarded, i);
+        } catch (const std::system_error&) {
+            break;  // 已启动的线程与调用线程按行组领取任务，少几个线程不影响结果
+        }
+    }
+    guarded(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    // 合并局部结果
+    std::vector<SnapshotAggregate> dense;
+    KeyedAggregates sparse;
+    for (auto& partial : partials) {
+        result.scanned_rows += partial.scanned;
+        result.matched_rows += partial.matched;
+        if (dense.size() < partial.dense.size()) {
+            dense.resize(partial.dense.size());
+        }
+        for (size_t key = 0; key < partial.dense.size(); ++key) {
+            dense[key].count += partial.dense[key].count;
+            dense[key].size += partial.dense[key].size;
+            dense[key].total_size += partial.dense[key].total_size;
+        }
+        partial.sparse.forEach([&sparse](const SnapshotAggregate& item) {
+            SnapshotAggregate& aggregate = sparse.at(item.key);
+            aggregate.count += item.count;
+            aggregate.size += item.size;
+            aggregate.total_size += item.total_size;
+        });
+    }
+
+    if (isDense(query.group_by)) {
+        for (size_t key = 0; key < dense.size(); ++key) {
+            if (dense[key].count == 0) {
+                continue;
+            }
+            SnapshotAggregate aggregate = dense[key];
+            aggregate.key = key;
+            if (query.group_by == SnapshotGroupBy::EXTENSION && key == extension_slots - 1) {
+                aggregate.key = snapshot::OTHER_EXTENSION;
+            }
+            result.rows.push_back(aggregate);
+        }
+        // 超出稠密上限的深度
+        sparse.forEach([&result](const SnapshotAggregate& item) { result.rows.push_back(item); });
+    } else {
+        sparse.forEach([&result](const SnapshotAggregate& item) { result.rows.push_back(item); });
+    }
+
+    if (query.group_by == SnapshotGroupBy::EXTENSION) {
+        std::sort(result.rows.begin(), result.rows.end(),
+                  [](const SnapshotAggregate& a, const SnapshotAggregate& b) { return a.size > b.size; });
+    } else {
+        std::sort(result.rows.begin(), result.rows.end(),
+                  [](const SnapshotAggregate& a, const SnapshotAggregate& b) { return a.key < b.key; });
+    }
+
+    result.duration_us = Utils::getMonotonicMicros() - start_time;
+    return result;
+}
+
+} // namespace filesystem
+} // namespace brisk
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "filesystem_common.h"
+#include "snapshot_reader.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace brisk {
+namespace filesystem {
+
+/**
+ * 快照聚合的分组方式
+ */
+enum class SnapshotGroupBy {
+    NONE,           // 不分组（单行合计）
+    DEPTH,          // 按深度
+    EXTENSION,      // 按扩展名
+    OWNER,          // 按所有者
+    MODIFIED_TIME,  // 按修改时间分桶
+    TYPE            // 按项目类型
+};
+
+/**
+ * 快照聚合查询
+ */
+struct SnapshotQuery {
+    SnapshotGroupBy group_by;               // 分组方式
+    uint64_t time_bucket_ms;                // 修改时间分桶宽度（毫秒）
+    std::string path_prefix;                // 只统计该路径及其子树（为空时统计全部）
+    uint64_t min_size;                      // 自身大小下限（含）
+    uint64_t max_size;                      // 自身大小上限（含）
+    bool filter_type;                       // 是否按类型过滤
+    ItemType type;                          // 过滤的类型
+    uint32_t threads;                       // 线程数（0 为自动）
+
+    SnapshotQuery() : group_by(SnapshotGroupBy::NONE), time_bucket_ms(86400000ULL), min_size(0),
+                      max_size(UINT64_MAX), filter_type(false), type(ItemType::FILE), threads(0) {}
+};
+
+/**
+ * 聚合结果行
+ */
+struct SnapshotAggregate {
+    uint64_t key;                           // 分组键（深度、扩展名编号、所有者、时间桶起点或 ItemType）
+    uint64_t count;                         // 匹配的行数
+    uint64_t size;                          // 匹配行的自身大小之和
+    uint64_t total_size;                    // 匹配行的总大小之和（目录包含子项）
+
+    SnapshotAggregate() : key(0), count(0), size(0), total_size(0) {}
+};
+
+/**
+ * 聚合查询结果
+ */
+struct SnapshotQueryResult {
+    std::vector<SnapshotAggregate> rows;    // 结果行（按键升序，扩展名按大小降序）
+    uint64_t scanned_rows;                  // 扫描的行数
+    uint64_t matched_rows;                  // 匹配的行数
+    uint64_t duration_us;                   // 耗时（微秒）
+    bool prefix_found;                      // 路径前缀是否存在于快照中
+
+    SnapshotQueryResult() : scanned_rows(0), matched_rows(0), duration_us(0), prefix_found(true) {}
+};
+
+/**
+ * 快照聚合查询引擎
+ *
+ * 路径前缀先定位到对应节点，利用后序排列将过滤范围缩小为连续的行区间；
+ * 区间内的行组由多个线程领取，每个行组按块先计算过滤掩码，再以掩码做无分支累加，
+ * 内层循环只访问连续的列数据，便于编译器向量化。各线程的局部结果最后合并。
+ */
+class SnapshotQueryEngine {
+public:
+    /**
+     * 执行聚合查询
+     * @param reader 快照读取器
+     * @param query 查询
+     * @return 查询结果
+     */
+    static SnapshotQueryResult execute(const SnapshotReader& reader, const SnapshotQuery& query);
+};
+
+} // namespace filesystem
+} // namespace brisk
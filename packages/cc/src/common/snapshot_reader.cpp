@@ -0,0 +1,408 @@
+#include "snapshot_reader.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <sys/stat.h>
+
+#ifdef PLATFORM_WINDOWS
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace brisk {
+namespace filesystem {
+
+SnapshotReader::SnapshotReader(const std::string& path)
+    : data_(nullptr), size_(0),
+#ifdef PLATFORM_WINDOWS
+      file_handle_(INVALID_HANDLE_VALUE), mapping_handle_(nullptr),
+#endif
+      footer_(nullptr), groups_(nullptr) {
+#ifdef PLATFORM_WINDOWS
+    file_handle_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                               FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_handle_ == INVALID_HANDLE_VALUE) {
+        throw FilesystemException("Cannot open snapshot: " + path, Utils::errorCodeToType(GetLastError()));
+    }
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file_handle_, &file_size)) {
+        unmap();
+        throw FilesystemException("Cannot open snapshot: " + path, ErrorType::IO_ERROR);
+    }
+    size_ = static_cast<uint64_t>(file_size.QuadPart);
+    if (size_ > 0) {
+        mapping_handle_ = CreateFileMappingA(file_handle_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        void* view = mapping_handle_ ? MapViewOfFile(mapping_handle_, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (!view) {
+            unmap();
+            throw FilesystemException("Cannot map snapshot: " + path, ErrorType::IO_ERROR);
+        }
+        data_ = static_cast<const uint8_t*>(view);
+    }
+#else
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        throw FilesystemException("Cannot open snapshot: " + path + " (" + std::strerror(errno) + ")",
+                                  Utils::errorCodeToType(errno));
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        throw FilesystemException("Cannot open snapshot: " + path, ErrorType::IO_ERROR);
+    }
+    size_ = static_cast<uint64_t>(st.st_size);
+    if (size_ > 0) {
+        void* mapped = mmap(nullptr, static_cast<size_t>(size_), PROT_READ, MAP_SHARED, fd, 0);
+        if (mapped == MAP_FAILED) {
+            close(fd);
+            throw FilesystemException("Cannot map snapshot: " + path + " (" + std::strerror(errno) + ")",
+                                      ErrorType::IO_ERROR);
+        }
+        data_ = static_cast<const uint8_t*>(mapped);
+    }
+    // 映射建立后即可关闭文件描述符
+    close(fd);
+#endif
+
+    try {
+        validate(path);
+    } catch (...) {
+        unmap();
+        throw;
+    }
+}
+
+namespace {
+
+/**
+ * 缓存的共享读取器
+ */
+struct SharedReader {
+    std::string path;                               // 快照文件路径
+    uint64_t device;                                // 打开时的设备号
+    uint64_t inode;                                 // 打开时的 inode 号
+    uint64_t size;                                  // 打开时的文件大小
+    int64_t modified_time;                          // 打开时的修改时间（秒）
+    uint64_t last_used;                             // 最近使用的序号
+    std::shared_ptr<const SnapshotReader> reader;   // 读取器
+};
+
+std::mutex g_shared_mutex;
+std::vector<SharedReader> g_shared_readers;
+uint64_t g_shared_clock = 0;
+
+} // namespace
+
+std::shared_ptr<const SnapshotReader> SnapshotReader::openShared(const std::string& path) {
+#ifdef PLATFORM_WINDOWS
+    struct _stat64 st;
+    bool exists = _stat64(path.c_str(), &st) == 0;
+#else
+    struct stat st;
+    bool exists = stat(path.c_str(), &st) == 0;
+#endif
+    if (!exists) {
+        // 交由构造函数报告具体错误
+        return std::make_shared<const SnapshotReader>(path);
+    }
+
+    std::lock_guard<std::mutex> lock(g_shared_mutex);
+    for (auto& shared : g_shared_readers) {
+        if (shared.path != path) {
+            continue;
+        }
+        if (shared.device == static_cast<uint64_t>(st.st_dev) && shared.inode == static_cast<uint64_t>(st.st_ino) &&
+            shared.size == static_cast<uint64_t>(st.st_size) &&
+            shared.modified_time == static_cast<int64_t>(st.st_mtime)) {
+            shared.last_used = ++g_shared_clock;
+            return shared.reader;
+        }
+        // 文件已被替换，重新映射（正在使用旧映射的查询不受影响）
+        shared.reader = std::make_shared<const SnapshotReader>(path);
+        shared.device = static_cast<uint64_t>(st.st_dev);
+        shared.inode = static_cast<uint64_t>(st.st_ino);
+        shared.size = static_cast<uint64_t>(st.st_size);
+        shared.modified_time = static_cast<int64_t>(st.st_mtime);
+        shared.last_used = ++g_shared_clock;
+        return shared.reader;
+    }
+
+    SharedReader shared;
+    shared.path = path;
+    shared.device = static_cast<uint64_t>(st.st_dev);
+    shared.inode = static_cast<uint64_t>(st.st_ino);
+    shared.size = static_cast<uint64_t>(st.st_size);
+    shared.modified_time = static_cast<int64_t>(st.st_mtime);
+    shared.last_used = ++g_shared_clock;
+    shared.reader = std::make_shared<const SnapshotReader>(path);
+
+    if (g_shared_readers.size() >= MAX_SHARED_READERS) {
+        auto oldest = std::min_element(g_shared_readers.begin(), g_shared_readers.end(),
+                                       [](const SharedReader& a, const SharedReader& b) {
+                                           return a.last_used < b.last_used;
+                                       });
+        *oldest = std::move(shared);
+        return oldest->reader;
+    }
+    g_shared_readers.push_back(std::move(shared));
+    return g_shared_readers.back().reader;
+}
+
+SnapshotReader::~SnapshotReader() {
+    unmap();
+}
+
+void SnapshotReader::unmap() {
+#ifdef PLATFORM_WINDOWS
+    if (data_) {
+        UnmapViewOfFile(data_);
+    }
+    if (mapping_handle_) {
+        CloseHandle(mapping_handle_);
+        mapping_handle_ = nullptr;
+    }
+    if (file_handle_ != INVALID_HANDLE_VALUE) {
+        CloseHandle(file_handle_);
+        file_handle_ = INVALID_HANDLE_VALUE;
+    }
+#else
+    if (data_) {
+        munmap(const_cast<uint8_t*>(data_), static_cast<size_t>(size_));
+    }
+#endif
+    data_ = nullptr;
+}
+
+void SnapshotReader::validate(const std::string& path) {
+    auto invalid = [&path](const std::string& reason) {
+        return FilesystemException("Invalid snapshot: " + path + " (" + reason + ")", ErrorType::INVALID_PATH);
+    };
+    // 区间 [offset, offset + length) 是否位于文件内（避免加法溢出）
+    auto within = [this](uint64_t offset, uint64_t length) {
+        return offset <= size_ && length <= size_ - offset;
+    };
+
+    if (size_ < sizeof(snapshot::FileHeader) + sizeof(snapshot::FileFooter)) {
+        throw invalid("file too small");
+    }
+
+    const auto* header = reinterpret_cast<const snapshot::FileHeader*>(data_);
+    footer_ = reinterpret_cast<const snapshot::FileFooter*>(data_ + size_ - sizeof(snapshot::FileFooter));
+    if (std::memcmp(header->magic, snapshot::MAGIC, sizeof(header->magic)) != 0 ||
+        std::memcmp(footer_->magic, snapshot::MAGIC, sizeof(footer_->magic)) != 0) {
+        throw invalid("bad magic");
+    }
+    if (header->version != snapshot::VERSION || footer_->version != snapshot::VERSION ||
+        header->row_group_rows != snapshot::ROW_GROUP_ROWS) {
+        throw invalid("unsupported version");
+    }
+
+    uint64_t group_count = footer_->group_count;
+    uint64_t expected_groups = (footer_->row_count + snapshot::ROW_GROUP_ROWS - 1) / snapshot::ROW_GROUP_ROWS;
+    if (group_count != expected_groups || footer_->groups_offset % alignof(snapshot::RowGroupEntry) != 0 ||
+        group_count > size_ / sizeof(snapshot::RowGroupEntry) ||
+        !within(footer_->groups_offset, group_count * sizeof(snapshot::RowGroupEntry))) {
+        throw invalid("bad row group directory");
+    }
+    groups_ = reinterpret_cast<const snapshot::RowGroupEntry*>(data_ + footer_->groups_offset);
+
+    for (uint64_t i = 0; i < group_count; ++i) {
+        const snapshot::RowGroupEntry& group = groups_[i];
+        uint64_t expected_rows = i + 1 < group_count
+            ? snapshot::ROW_GROUP_ROWS
+            : footer_->row_count - i * snapshot::ROW_GROUP_ROWS;
+        if (group.first_row != i * snapshot::ROW_GROUP_ROWS || group.row_count != expected_rows) {
+            throw invalid("bad row group " + std::to_string(i));
+        }
+        for (uint32_t column = 0; column < snapshot::COLUMN_COUNT; ++column) {
+            bool has_sentinel = column == snapshot::NAME_OFFSET || column == snapshot::CHILD_OFFSET;
+            uint64_t values = group.row_count + (has_sentinel ? 1 : 0);
+            uint64_t offset = group.columns[column];
+            if (offset % snapshot::COLUMN_WIDTH[column] != 0 ||
+                !within(offset, values * snapshot::COLUMN_WIDTH[column])) {
+                throw invalid("bad column in row group " + std::to_string(i));
+            }
+        }
+        if (!within(group.names_offset, group.names_size)) {
+            throw invalid("bad names in row group " + std::to_string(i));
+        }
+        if (group.children_offset % sizeof(uint64_t) != 0 || group.children_count > size_ / sizeof(uint64_t) ||
+            !within(group.children_offset, group.children_count * sizeof(uint64_t))) {
+            throw invalid("bad child table in row group " + std::to_string(i));
+        }
+    }
+
+    if (!within(footer_->root_path_offset, footer_->root_path_size)) {
+        throw invalid("bad root path");
+    }
+    root_path_.assign(reinterpret_cast<const char*>(data_ + footer_->root_path_offset),
+                      static_cast<size_t>(footer_->root_path_size));
+
+    uint64_t offset = footer_->dictionary_offset;
+    uint32_t extension_count = 0;
+    if (!within(offset, sizeof(extension_count))) {
+        throw invalid("bad extension dictionary");
+    }
+    std::memcpy(&extension_count, data_ + offset, sizeof(extension_count));
+    offset += sizeof(extension_count);
+    // 每个扩展名至少占一个长度字段，数量不能超过字典之后剩余的字节数
+    if (extension_count > snapshot::MAX_EXTENSIONS || extension_count > (size_ - offset) / sizeof(uint32_t)) {
+        throw invalid("bad extension dictionary");
+    }
+    extensions_.reserve(extension_count);
+    for (uint32_t i = 0; i < extension_count; ++i) {
+        uint32_t length = 0;
+        if (!within(offset, sizeof(length))) {
+            throw invalid("bad extension dictionary");
+        }
+        std::memcpy(&length, data_ + offset, sizeof(length));
+        offset += sizeof(length);
+        if (!within(offset, length)) {
+            throw invalid("bad extension dictionary");
+        }
+        extensions_.emplace_back(reinterpret_cast<const char*>(data_ + offset), length);
+        offset += length;
+    }
+}
+
+std::string SnapshotReader::name(uint64_t row) const {
+    size_t index = groupOf(row);
+    const snapshot::RowGroupEntry& group = groups_[index];
+    const uint32_t* offsets = column<uint32_t>(index, snapshot::NAME_OFFSET);
+    size_t local = static_cast<size_t>(row % snapshot::ROW_GROUP_ROWS);
+    uint64_t begin = offsets[local];
+    uint64_t end = offsets[local + 1];
+    if (begin > end || end > group.names_size) {
+        return std::string();
+    }
+    return std::string(reinterpret_cast<const char*>(data_ + group.names_offset + begin),
+                       static_cast<size_t>(end - begin));
+}
+
+int SnapshotReader::compareName(uint64_t row, const char* name, size_t length) const {
+    size_t index = groupOf(row);
+    const snapshot::RowGroupEntry& group = groups_[index];
+    const uint32_t* offsets = column<uint32_t>(index, snapshot::NAME_OFFSET);
+    size_t local = static_cast<size_t>(row % snapshot::ROW_GROUP_ROWS);
+    uint64_t begin = offsets[local];
+    uint64_t end = offsets[local + 1];
+    if (begin > end || end > group.names_size) {
+        begin = end = 0;
+    }
+    size_t row_length = static_cast<size_t>(end - begin);
+    int result = std::memcmp(data_ + group.names_offset + begin, name, std::min(row_length, length));
+    if (result != 0) {
+        return result;
+    }
+    return row_length < length ? -1 : (row_length > length ? 1 : 0);
+}
+
+size_t SnapshotReader::children(uint64_t row, const uint64_t*& rows) const {
+    size_t index = groupOf(row);
+    const snapshot::RowGroupEntry& group = groups_[index];
+    const uint32_t* offsets = column<uint32_t>(index, snapshot::CHILD_OFFSET);
+    size_t local = static_cast<size_t>(row % snapshot::ROW_GROUP_ROWS);
+    uint64_t begin = offsets[local];
+    uint64_t end = offsets[local + 1];
+    rows = reinterpret_cast<const uint64_t*>(data_ + group.children_offset) + begin;
+    if (begin > end || end > group.children_count) {
+        return 0;
+    }
+    return static_cast<size_t>(end - begin);
+}
+
+std::string SnapshotReader::extensionName(uint32_t id) const {
+    if (id == snapshot::NO_EXTENSION) {
+        return "";
+    }
+    if (id == snapshot::OTHER_EXTENSION || id > extensions_.size()) {
+        return "*";
+    }
+    return extensions_[id - 1];
+}
+
+bool SnapshotReader::locate(const std::string& path, uint64_t& row) const {
+    if (rowCount() == 0) {
+        return false;
+    }
+
+    auto isSeparator = [](char c) {
+#ifdef PLATFORM_WINDOWS
+        return c == '/' || c == '\\';
+#else
+        return c == '/';
+#endif
+    };
+    // 忽略末尾的分隔符（根目录本身除外）
+    auto trimmedLength = [&isSeparator](const std::string& value) {
+        size_t length = value.size();
+        while (length > 1 && isSeparator(value[length - 1])) {
+            --length;
+        }
+        return length;
+    };
+
+    size_t root_length = trimmedLength(root_path_);
+    size_t path_length = trimmedLength(path);
+    if (path_length < root_length || path.compare(0, root_length, root_path_, 0, root_length) != 0) {
+        return false;
+    }
+    if (path_length > root_length && !isSeparator(path[root_length]) &&
+        !(root_length > 0 && isSeparator(root_path_[root_length - 1]))) {
+        return false;
+    }
+
+    // 根节点是后序的最后一行；逐级在按名称排序的子项表中二分查找
+    uint64_t current = rowCount() - 1;
+    size_t position = root_length;
+    while (position < path_length) {
+        while (position < path_length && isSeparator(path[position])) {
+            ++position;
+        }
+        size_t end = position;
+        while (end < path_length && !isSeparator(path[end])) {
+            ++end;
+        }
+        if (end == position) {
+            break;
+        }
+
+        const uint64_t* rows = nullptr;
+        size_t low = 0;
+        size_t high = children(current, rows);
+        bool found = false;
+        while (low < high) {
+            size_t middle = low + (high - low) / 2;
+            // 子项必须位于当前目录之前（损坏的快照不会导致越界或死循环）
+            if (rows[middle] >= current) {
+                return false;
+            }
+            int order = compareName(rows[middle], path.data() + position, end - position);
+            if (order == 0) {
+                current = rows[middle];
+                found = true;
+                break;
+            }
+            if (order < 0) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        if (!found) {
+            return false;
+        }
+
+        position = end;
+    }
+
+    row = current;
+    return true;
+}
+
+} // namespace filesystem
+} // namespace brisk
@@ -0,0 +1,189 @@
+#pragma once
+
+#include "filesystem_common.h"
+#include "snapshot_format.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace brisk {
+namespace filesystem {
+
+/**
+ * 列式快照读取器
+ *
+ * 以只读方式内存映射快照文件，打开时只校验文件头、文件尾与行组目录的边界并解析扩展名字典，
+ * 各列数据按需由操作系统换入，打开耗时与快照大小无关。读取接口均为只读，可被多个线程同时使用。
+ */
+class SnapshotReader {
+private:
+    const uint8_t* data_;                       // 映射的文件内容
+    uint64_t size_;                             // 文件大小
+#ifdef PLATFORM_WINDOWS
+    void* file_handle_;                         // 文件句柄
+    void* mapping_handle_;                      // 文件映射句柄
+#endif
+    const snapshot::FileFooter* footer_;        // 文件尾
+    const snapshot::RowGroupEntry* groups_;     // 行组目录
+    std::vector<std::string> extensions_;       // 扩展名字典（下标为编号 - 1）
+    std::string root_path_;                     // 根节点路径
+
+public:
+    /**
+     * 打开并映射快照文件
+     * @param path 快照文件路径
+     */
+    explicit SnapshotReader(const std::string& path);
+
+    /**
+     * 获取共享的快照读取器
+     *
+     * 已打开的快照按路径缓存（最多 MAX_SHARED_READERS 个，淘汰最久未使用的），
+     * 文件被替换（设备、inode、大小或修改时间变化）后重新映射，
+     * 重复查询同一快照时无需重新打开与校验。
+     * @param path 快照文件路径
+     * @return 读取器
+     */
+    static std::shared_ptr<const SnapshotReader> openShared(const std::string& path);
+
+    static constexpr size_t MAX_SHARED_READERS = 8;  // 共享读取器缓存上限
+
+    ~SnapshotReader();
+
+    SnapshotReader(const SnapshotReader&) = delete;
+    SnapshotReader& operator=(const SnapshotReader&) = delete;
+
+    /**
+     * 总行数
+     * @return 行数
+     */
+    uint64_t rowCount() const { return footer_->row_count; }
+
+    /**
+     * 行组数
+     * @return 行组数
+     */
+    size_t groupCount() const { return static_cast<size_t>(footer_->group_count); }
+
+    /**
+     * 获取行组目录项
+     * @param index 行组下标
+     * @return 目录项
+     */
+    const snapshot::RowGroupEntry& group(size_t index) const { return groups_[index]; }
+
+    /**
+     * 获取行组中一列的起始地址
+     * @param index 行组下标
+     * @param column 列编号
+     * @return 列数据
+     */
+    template <typename T>
+    const T* column(size_t index, snapshot::Column column) const {
+        return reinterpret_cast<const T*>(data_ + groups_[index].columns[column]);
+    }
+
+    /**
+     * 读取某行的 64 位列值
+     * @param row 行号
+     * @param column 列编号（SIZE 至 DESCENDANTS）
+     * @return 值
+     */
+    uint64_t value64(uint64_t row, snapshot::Column column) const {
+        return this->column<uint64_t>(groupOf(row), column)[row % snapshot::ROW_GROUP_ROWS];
+    }
+
+    /**
+     * 读取某行的 32 位列值
+     * @param row 行号
+     * @param column 列编号（OWNER 至 EXTENSION）
+     * @return 值
+     */
+    uint32_t value32(uint64_t row, snapshot::Column column) const {
+        return this->column<uint32_t>(groupOf(row), column)[row % snapshot::ROW_GROUP_ROWS];
+    }
+
+    /**
+     * 读取某行的 8 位列值
+     * @param row 行号
+     * @param column 列编号（TYPE）
+     * @return 值
+     */
+    uint8_t value8(uint64_t row, snapshot::Column column) const {
+        return this->column<uint8_t>(groupOf(row), column)[row % snapshot::ROW_GROUP_ROWS];
+    }
+
+    /**
+     * 读取某行的名称
+     * @param row 行号
+     * @return 名称
+     */
+    std::string name(uint64_t row) const;
+
+    /**
+     * 按字节序比较某行的名称
+     * @param row 行号
+     * @param name 名称
+     * @param length 名称字节数
+     * @return 行名称小于、等于、大于 name 时分别为负数、0、正数
+     */
+    int compareName(uint64_t row, const char* name, size_t length) const;
+
+    /**
+     * 获取目录的子项表
+     * @param row 目录行号
+     * @param rows 输出按名称字节序排列的子项行号
+     * @return 子项数（非目录为 0）
+     */
+    size_t children(uint64_t row, const uint64_t*& rows) const;
+
+    /**
+     * 根节点路径
+     * @return 路径
+     */
+    const std::string& rootPath() const { return root_path_; }
+
+    /**
+     * 扩展名字典编号对应的扩展名
+     * @param id 编号
+     * @return 扩展名（无扩展名为空字符串，字典已满后的扩展名为 "*"）
+     */
+    std::string extensionName(uint32_t id) const;
+
+    /**
+     * 扩展名字典大小
+     * @return 扩展名数量
+     */
+    size_t extensionCount() const { return extensions_.size(); }
+
+    /**
+     * 查找路径对应的行（从根节点沿路径逐级在子项表中二分查找）
+     * @param path 路径（须位于根节点路径之下）
+     * @param row 输出行号
+     * @return 是否找到
+     */
+    bool locate(const std::string& path, uint64_t& row) const;
+
+private:
+    /**
+     * 行号所在的行组下标
+     */
+    static size_t groupOf(uint64_t row) { return static_cast<size_t>(row / snapshot::ROW_GROUP_ROWS); }
+
+    /**
+     * 校验文件结构并解析扩展名字典与根路径
+     * @param path 快照文件路径（用于错误信息）
+     */
+    void validate(const std::string& path);
+
+    /**
+     * 释放映射
+     */
+    void unmap();
+};
+
+} // namespace filesystem
+} // namespace brisk
@@ -0,0 +1,228 @@
+#include "snapshot_writer.h"
+#include <algorithm>
+#include <cstring>
+
+namespace brisk {
+namespace filesystem {
+
+SnapshotWriter::SnapshotWriter(int fd) : file_(fd), row_count_(0), finished_(false) {
+    begin();
+}
+
+SnapshotWriter::SnapshotWriter(const std::string& path) : file_(path, true), row_count_(0), finished_(false) {
+    begin();
+}
+
+void SnapshotWriter::begin() {
+    size_.reserve(snapshot::ROW_GROUP_ROWS);
+    total_size_.reserve(snapshot::ROW_GROUP_ROWS);
+    modified_time_.reserve(snapshot::ROW_GROUP_ROWS);
+    inode_.reserve(snapshot::ROW_GROUP_ROWS);
+    fingerprint_.reserve(snapshot::ROW_GROUP_ROWS);
+    descendants_.reserve(snapshot::ROW_GROUP_ROWS);
+    owner_.reserve(snapshot::ROW_GROUP_ROWS);
+    depth_.reserve(snapshot::ROW_GROUP_ROWS);
+    extension_.reserve(snapshot::ROW_GROUP_ROWS);
+    name_offset_.reserve(snapshot::ROW_GROUP_ROWS + 1);
+    child_offset_.reserve(snapshot::ROW_GROUP_ROWS + 1);
+    type_.reserve(snapshot::ROW_GROUP_ROWS);
+
+    snapshot::FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, snapshot::MAGIC, sizeof(header.magic));
+    header.version = snapshot::VERSION;
+    header.row_group_rows = snapshot::ROW_GROUP_ROWS;
+    file_.write(&header, sizeof(header));
+}
+
+uint64_t SnapshotWriter::bufferBytes() const {
+    uint64_t row_bytes = 0;
+    for (size_t width : snapshot::COLUMN_WIDTH) {
+        row_bytes += width;
+    }
+    return row_bytes * snapshot::ROW_GROUP_ROWS + names_.capacity();
+}
+
+void SnapshotWriter::beginDirectory(const FileSystemItem&, int) {
+    OpenDirectory directory;
+    directory.first_row = row_count_;
+    open_directories_.push_back(std::move(directory));
+}
+
+void SnapshotWriter::endDirectory(const FileSystemItem& item, int depth, uint64_t total_size, uint64_t fingerprint,
+                                  uint64_t, uint64_t) {
+    OpenDirectory directory = std::move(open_directories_.back());
+    open_directories_.pop_back();
+    appendRow(item, depth, total_size, fingerprint, row_count_ - directory.first_row, &directory.children);
+}
+
+void SnapshotWriter::writeEntry(const FileSystemItem& item, int depth, uint64_t total_size, uint64_t fingerprint,
+                                uint64_t, uint64_t) {
+    appendRow(item, depth, total_size, fingerprint, 0, nullptr);
+}
+
+void SnapshotWriter::appendRow(const FileSystemItem& item, int depth, uint64_t total_size,
+                               uint64_t fingerprint, uint64_t descendants,
+                               std::vector<std::pair<std::string, uint64_t>>* children) {
+    if (open_directories_.empty()) {
+        root_path_ = item.path;
+    } else {
+        open_directories_.back().children.emplace_back(item.name, row_count_);
+    }
+
+    size_.push_back(item.size);
+    total_size_.push_back(total_size);
+    modified_time_.push_back(item.modified_time);
+    inode_.push_back(item.inode);
+    fingerprint_.push_back(fingerprint);
+    descendants_.push_back(descendants);
+    owner_.push_back(item.owner);
+    depth_.push_back(static_cast<uint32_t>(depth));
+    extension_.push_back(extensionId(item));
+    name_offset_.push_back(static_cast<uint32_t>(names_.size()));
+    child_offset_.push_back(static_cast<uint32_t>(children_.size()));
+    type_.push_back(static_cast<uint8_t>(item.type));
+    names_.append(item.name);
+    if (children) {
+        // std::string 的比较即按字节（unsigned char）比较，与读取端的二分查找一致
+        std::sort(children->begin(), children->end());
+        for (const auto& child : *children) {
+            children_.push_back(child.second);
+        }
+    }
+    row_count_++;
+
+    if (size_.size() == snapshot::ROW_GROUP_ROWS) {
+        flushGroup();
+    }
+}
+
+uint32_t SnapshotWriter::extensionId(const FileSystemItem& item) {
+    if (item.type == ItemType::DIRECTORY) {
+        return snapshot::NO_EXTENSION;
+    }
+
+    std::string extension = Utils::getFileExtension(item.name);
+    if (extension.empty()) {
+        return snapshot::NO_EXTENSION;
+    }
+
+    auto found = extension_ids_.find(extension);
+    if (found != extension_ids_.end()) {
+        return found->second;
+    }
+    if (extensions_.size() >= snapshot::MAX_EXTENSIONS) {
+        return snapshot::OTHER_EXTENSION;
+    }
+
+    extensions_.push_back(extension);
+    uint32_t id = static_cast<uint32_t>(extensions_.size());
+    extension_ids_.emplace(std::move(extension), id);
+    return id;
+}
+
+void SnapshotWriter::flushGroup() {
+    if (size_.empty()) {
+        return;
+    }
+
+    snapshot::RowGroupEntry group;
+    std::memset(&group, 0, sizeof(group));
+    group.first_row = row_count_ - size_.size();
+    group.row_count = static_cast<uint32_t>(size_.size());
+    name_offset_.push_back(static_cast<uint32_t>(names_.size()));
+    child_offset_.push_back(static_cast<uint32_t>(children_.size()));
+
+    group.columns[snapshot::SIZE] = writeColumn(size_.data(), size_.size() * sizeof(uint64_t));
+    group.columns[snapshot::TOTAL_SIZE] = writeColumn(total_size_.data(), total_size_.size() * sizeof(uint64_t));
+    group.columns[snapshot::MODIFIED_TIME] = writeColumn(modified_time_.data(),
+                                                         modified_time_.size() * sizeof(uint64_t));
+    group.columns[snapshot::INODE] = writeColumn(inode_.data(), inode_.size() * sizeof(uint64_t));
+    group.columns[snapshot::FINGERPRINT] = writeColumn(fingerprint_.data(), fingerprint_.size() * sizeof(uint64_t));
+    group.columns[snapshot::DESCENDANTS] = writeColumn(descendants_.data(), descendants_.size() * sizeof(uint64_t));
+    group.columns[snapshot::OWNER] = writeColumn(owner_.data(), owner_.size() * sizeof(uint32_t));
+    group.columns[snapshot::DEPTH] = writeColumn(depth_.data(), depth_.size() * sizeof(uint32_t));
+    group.columns[snapshot::EXTENSION] = writeColumn(extension_.data(), extension_.size() * sizeof(uint32_t));
+    group.columns[snapshot::NAME_OFFSET] = writeColumn(name_offset_.data(), name_offset_.size() * sizeof(uint32_t));
+    group.columns[snapshot::CHILD_OFFSET] = writeColumn(child_offset_.data(),
+                                                        child_offset_.size() * sizeof(uint32_t));
+    group.columns[snapshot::TYPE] = writeColumn(type_.data(), type_.size());
+    group.names_size = names_.size();
+    group.names_offset = writeColumn(names_.data(), names_.size());
+    group.children_count = children_.size();
+    group.children_offset = writeColumn(children_.data(), children_.size() * sizeof(uint64_t));
+    groups_.push_back(group);
+
+    size_.clear();
+    total_size_.clear();
+    modified_time_.clear();
+    inode_.clear();
+    fingerprint_.clear();
+    descendants_.clear();
+    owner_.clear();
+    depth_.clear();
+    extension_.clear();
+    name_offset_.clear();
+    child_offset_.clear();
+    type_.clear();
+    names_.clear();
+    children_.clear();
+}
+
+uint64_t SnapshotWriter::writeColumn(const void* data, size_t length) {
+    pad();
+    uint64_t offset = file_.offset();
+    file_.write(data, length);
+    return offset;
+}
+
+void SnapshotWriter::pad() {
+    static const char zeros[snapshot::COLUMN_ALIGNMENT] = {};
+    uint64_t remainder = file_.offset() % snapshot::COLUMN_ALIGNMENT;
+    if (remainder != 0) {
+        file_.write(zeros, static_cast<size_t>(snapshot::COLUMN_ALIGNMENT - remainder));
+    }
+}
+
+void SnapshotWriter::finish() {
+    if (finished_) {
+        return;
+    }
+    finished_ = true;
+
+    flushGroup();
+
+    snapshot::FileFooter footer;
+    std::memset(&footer, 0, sizeof(footer));
+
+    // 扩展名字典
+    pad();
+    footer.dictionary_offset = file_.offset();
+    uint32_t extension_count = static_cast<uint32_t>(extensions_.size());
+    file_.write(&extension_count, sizeof(extension_count));
+    for (const auto& extension : extensions_) {
+        uint32_t length = static_cast<uint32_t>(extension.size());
+        file_.write(&length, sizeof(length));
+        file_.write(extension.data(), extension.size());
+    }
+
+    footer.root_path_offset = file_.offset();
+    footer.root_path_size = root_path_.size();
+    file_.write(root_path_.data(), root_path_.size());
+
+    pad();
+    footer.groups_offset = file_.offset();
+    if (!groups_.empty()) {
+        file_.write(groups_.data(), groups_.size() * sizeof(snapshot::RowGroupEntry));
+    }
+
+    footer.row_count = row_count_;
+    footer.group_count = groups_.size();
+    footer.version = snapshot::VERSION;
+    std::memcpy(footer.magic, snapshot::MAGIC, sizeof(footer.magic));
+    file_.write(&footer, sizeof(footer));
+    file_.commit();
+}
+
+} // namespace filesystem
+} // namespace brisk
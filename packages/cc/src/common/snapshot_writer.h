@@ -0,0 +1,136 @@
+#pragma once
+
+#include "tree_sink.h"
+#include "snapshot_format.h"
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace brisk {
+namespace filesystem {
+
+/**
+ * 列式快照写入器
+ *
+ * 节点按后序追加到当前行组的各列缓冲，满 ROW_GROUP_ROWS 行后整组写出，
+ * 只缓冲一个行组与当前路径上各层目录的直接子项（名称与行号，用于生成子项表），
+ * 内存用量与树的规模无关。
+ * 扩展名字典与行组目录在 finish 时写在文件末尾。
+ */
+class SnapshotWriter : public TreeSink {
+private:
+    /**
+     * 尚未结束的目录
+     */
+    struct OpenDirectory {
+        uint64_t first_row;                                     // 开始时的行数
+        std::vector<std::pair<std::string, uint64_t>> children; // 直接子项的名称与行号
+    };
+
+
+    OutputFile file_;                                   // 输出文件
+    std::vector<uint64_t> size_;                        // SIZE 列缓冲
+    std::vector<uint64_t> total_size_;                  // TOTAL_SIZE 列缓冲
+    std::vector<uint64_t> modified_time_;               // MODIFIED_TIME 列缓冲
+    std::vector<uint64_t> inode_;                       // INODE 列缓冲
+    std::vector<uint64_t> fingerprint_;                 // FINGERPRINT 列缓冲
+    std::vector<uint64_t> descendants_;                 // DESCENDANTS 列缓冲
+    std::vector<uint32_t> owner_;                       // OWNER 列缓冲
+    std::vector<uint32_t> depth_;                       // DEPTH 列缓冲
+    std::vector<uint32_t> extension_;                   // EXTENSION 列缓冲
+    std::vector<uint32_t> name_offset_;                 // NAME_OFFSET 列缓冲
+    std::vector<uint32_t> child_offset_;                // CHILD_OFFSET 列缓冲
+    std::vector<uint8_t> type_;                         // TYPE 列缓冲
+    std::string names_;                                 // 当前行组的名称区
+    std::vector<uint64_t> children_;                    // 当前行组的子项区
+    std::vector<OpenDirectory> open_directories_;       // 当前路径上各层未结束的目录
+    std::unordered_map<std::string, uint32_t> extension_ids_; // 扩展名到字典编号
+    std::vector<std::string> extensions_;               // 扩展名字典（编号从 1 开始）
+    std::vector<snapshot::RowGroupEntry> groups_;       // 已写出的行组
+    std::string root_path_;                             // 根节点路径
+    uint64_t row_count_;                                // 已追加的行数
+    bool finished_;                                     // 是否已结束
+
+public:
+    /**
+     * 构造函数（写入已打开的文件描述符，不负责关闭）
+     * @param fd 文件描述符
+     */
+    explicit SnapshotWriter(int fd);
+
+    /**
+     * 构造函数（写入临时文件，finish 时原子替换目标文件，不影响正在映射旧快照的读取器）
+     * @param path 文件路径
+     */
+    explicit SnapshotWriter(const std::string& path);
+
+    void beginDirectory(const FileSystemItem& item, int depth) override;
+
+    /**
+     * 结束目录节点（快照不保存子树的最新修改 / 访问时间，忽略对应参数）
+     */
+    void endDirectory(const FileSystemItem& item, int depth, uint64_t total_size, uint64_t fingerprint,
+                      uint64_t newest_modified_time, uint64_t newest_accessed_time) override;
+
+    void writeEntry(const FileSystemItem& item, int depth, uint64_t total_size, uint64_t fingerprint,
+                    uint64_t newest_modified_time, uint64_t newest_accessed_time) override;
+
+    /**
+     * 写出最后一个行组、扩展名字典、行组目录与文件尾，并提交输出文件
+     */
+    void finish() override;
+
+    uint64_t entryCount() const override { return row_count_; }
+
+    uint64_t bytesWritten() const override { return file_.offset(); }
+
+    uint64_t bufferBytes() const override;
+
+private:
+    /**
+     * 初始化行组缓冲并写出文件头
+     */
+    void begin();
+
+    /**
+     * 追加一行
+     * @param item 项目信息
+     * @param depth 深度
+     * @param total_size 总大小
+     * @param fingerprint 元数据指纹
+     * @param descendants 子孙节点数
+     * @param children 直接子项（目录结束时传入，按名称排序后写入子项区）
+     */
+    void appendRow(const FileSystemItem& item, int depth, uint64_t total_size, uint64_t fingerprint,
+                   uint64_t descendants, std::vector<std::pair<std::string, uint64_t>>* children);
+
+    /**
+     * 获取扩展名的字典编号
+     * @param item 项目信息
+     * @return 编号
+     */
+    uint32_t extensionId(const FileSystemItem& item);
+
+    /**
+     * 写出当前行组并清空缓冲
+     */
+    void flushGroup();
+
+    /**
+     * 写出一列并记录其偏移
+     * @param data 列数据
+     * @param length 字节数
+     * @return 列起始偏移
+     */
+    uint64_t writeColumn(const void* data, size_t length);
+
+    /**
+     * 填充到 COLUMN_ALIGNMENT 对齐
+     */
+    void pad();
+};
+
+} // namespace filesystem
+} // namespace brisk
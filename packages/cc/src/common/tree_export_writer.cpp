@@ -0,0 +1,307 @@
+#include "tree_export_writer.h"
+#include "fingerprint.h"
+#include <algorithm>
+#include <cstring>
+
+namespace brisk {
+namespace filesystem {
+
+namespace {
+
+/**
+ * 两位十进制数字表（一次转换两位）
+ */
+const char DIGIT_PAIRS[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/**
+ * 项目类型名称（与 getItemInfo 返回的 type 一致）
+ */
+const char* typeName(ItemType type) {
+    switch (type) {
+        case ItemType::FILE: return "file";
+        case ItemType::DIRECTORY: return "directory";
+        case ItemType::SYMBOLIC_LINK: return "symlink";
+        default: return "unknown";
+    }
+}
+
+/**
+ * 计算从 data[0] 开始的合法 UTF-8 序列长度
+ * @return 序列长度，不合法时为 0
+ */
+size_t utf8SequenceLength(const unsigned char* data, size_t remaining) {
+    unsigned char lead = data[0];
+    size_t length;
+    uint32_t min_code;
+    if (lead >= 0xc2 && lead <= 0xdf) {
+        length = 2;
+        min_code = 0x80;
+    } else if (lead >= 0xe0 && lead <= 0xef) {
+        length = 3;
+        min_code = 0x800;
+    } else if (lead >= 0xf0 && lead <= 0xf4) {
+        length = 4;
+        min_code = 0x10000;
+    } else {
+        return 0;
+    }
+    if (remaining < length) {
+        return 0;
+    }
+
+    uint32_t code = lead & (0x7f >> length);
+    for (size_t i = 1; i < length; ++i) {
+        if ((data[i] & 0xc0) != 0x80) {
+            return 0;
+        }
+        code = (code << 6) | (data[i] & 0x3f);
+    }
+    // 拒绝过长编码、代理项与超出 Unicode 范围的码点
+    if (code < min_code || (code >= 0xd800 && code <= 0xdfff) || code > 0x10ffff) {
+        return 0;
+    }
+    return length;
+}
+
+} // namespace
+
+TreeExportWriter::TreeExportWriter(int fd, ExportFormat format)
+    : file_(fd), format_(format), buffer_(BUFFER_SIZE), used_(0), entry_count_(0), finished_(false) {
+}
+
+TreeExportWriter::TreeExportWriter(const std::string& path, ExportFormat format)
+    : file_(path, true), format_(format), buffer_(BUFFER_SIZE), used_(0), entry_count_(0), finished_(false) {
+}
+
+void TreeExportWriter::beginDirectory(const FileSystemItem& item, int depth) {
+    // NDJSON 的目录行需要总大小，在 endDirectory 中输出
+    if (format_ == ExportFormat::NDJSON) {
+        has_children_.push_back(false);
+        return;
+    }
+
+    beginNode();
+    appendLiteral("{\"item\":");
+    appendItem(item);
+    appendLiteral(",\"depth\":");
+    appendUnsigned(static_cast<uint64_t>(depth));
+    appendLiteral(",\"children\":[");
+    has_children_.push_back(false);
+}
+
+void TreeExportWriter::endDirectory(const FileSystemItem& item, int depth, uint64_t total_size, uint64_t fingerprint,
+                                    uint64_t newest_modified_time, uint64_t newest_accessed_time) {
+    has_children_.pop_back();
+    entry_count_++;
+
+    if (format_ == ExportFormat::NDJSON) {
+        appendLiteral("{");
+        appendNodeFields(item, depth, total_size, fingerprint, newest_modified_time, newest_accessed_time);
+        appendLiteral("}\n");
+        return;
+    }
+
+    appendLiteral("],\"totalSize\":");
+    appendQuotedUnsigned(total_size);
+    appendRollupFields(fingerprint, newest_modified_time, newest_accessed_time);
+    appendLiteral("}");
+}
+
+void TreeExportWriter::writeEntry(const FileSystemItem& item, int depth, uint64_t total_size, uint64_t fingerprint,
+                                  uint64_t newest_modified_time, uint64_t newest_accessed_time) {
+    beginNode();
+    entry_count_++;
+
+    appendLiteral("{");
+    appendNodeFields(item, depth, total_size, fingerprint, newest_modified_time, newest_accessed_time);
+    if (format_ == ExportFormat::NDJSON) {
+        appendLiteral("}\n");
+    } else {
+        appendLiteral(",\"children\":[]}");
+    }
+}
+
+void TreeExportWriter::finish() {
+    if (finished_) {
+        return;
+    }
+    finished_ = true;
+
+    if (format_ == ExportFormat::JSON) {
+        if (entry_count_ == 0) {
+            appendLiteral("null");
+        }
+        appendLiteral("\n");
+    }
+    flush();
+    file_.commit();
+}
+
+void TreeExportWriter::beginNode() {
+    if (format_ != ExportFormat::JSON || has_children_.empty()) {
+        return;
+    }
+
+    if (has_children_.back()) {
+        appendLiteral(",");
+    } else {
+        has_children_.back() = true;
+    }
+}
+
+void TreeExportWriter::appendNodeFields(const FileSystemItem& item, int depth, uint64_t total_size,
+                                        uint64_t fingerprint, uint64_t newest_modified_time,
+                                        uint64_t newest_accessed_time) {
+    appendLiteral("\"item\":");
+    appendItem(item);
+    appendLiteral(",\"totalSize\":");
+    appendQuotedUnsigned(total_size);
+    appendLiteral(",\"depth\":");
+    appendUnsigned(static_cast<uint64_t>(depth));
+    appendRollupFields(fingerprint, newest_modified_time, newest_accessed_time);
+}
+
+void TreeExportWriter::appendRollupFields(uint64_t fingerprint, uint64_t newest_modified_time,
+                                          uint64_t newest_accessed_time) {
+    appendLiteral(",\"fingerprint\":\"");
+    std::string hex = Fingerprint::toHex(fingerprint);
+    appendRaw(hex.data(), hex.size());
+    appendLiteral("\",\"newestModifiedTime\":");
+    appendQuotedUnsigned(newest_modified_time);
+    appendLiteral(",\"newestAccessedTime\":");
+    appendQuotedUnsigned(newest_accessed_time);
+}
+
+void TreeExportWriter::appendItem(const FileSystemItem& item) {
+    appendLiteral("{\"path\":");
+    appendString(item.path);
+    appendLiteral(",\"name\":");
+    appendString(item.name);
+    appendLiteral(",\"size\":");
+    appendQuotedUnsigned(item.size);
+    appendLiteral(",\"createdTime\":");
+    appendQuotedUnsigned(item.created_time);
+    appendLiteral(",\"modifiedTime\":");
+    appendQuotedUnsigned(item.modified_time);
+    appendLiteral(",\"accessedTime\":");
+    appendQuotedUnsigned(item.accessed_time);
+    appendLiteral(",\"inode\":");
+    appendQuotedUnsigned(item.inode);
+    appendLiteral(",\"type\":\"");
+    const char* type = typeName(item.type);
+    appendRaw(type, std::strlen(type));
+    appendLiteral("\"}");
+}
+
+void TreeExportWriter::appendRaw(const char* data, size_t length) {
+    if (length > buffer_.size()) {
+        // 超长数据分段写出
+        while (length > 0) {
+            size_t chunk = std::min(length, buffer_.size());
+            appendRaw(data, chunk);
+            data += chunk;
+            length -= chunk;
+        }
+        return;
+    }
+
+    reserve(length);
+    std::memcpy(buffer_.data() + used_, data, length);
+    used_ += length;
+}
+
+void TreeExportWriter::appendUnsigned(uint64_t value) {
+    // 从低位向高位每次转换两位
+    char digits[20];
+    char* end = digits + sizeof(digits);
+    char* cursor = end;
+    while (value >= 100) {
+        size_t pair = static_cast<size_t>(value % 100) * 2;
+        value /= 100;
+        cursor -= 2;
+        cursor[0] = DIGIT_PAIRS[pair];
+        cursor[1] = DIGIT_PAIRS[pair + 1];
+    }
+    if (value >= 10) {
+        size_t pair = static_cast<size_t>(value) * 2;
+        cursor -= 2;
+        cursor[0] = DIGIT_PAIRS[pair];
+        cursor[1] = DIGIT_PAIRS[pair + 1];
+    } else {
+        *--cursor = static_cast<char>('0' + value);
+    }
+    appendRaw(cursor, static_cast<size_t>(end - cursor));
+}
+
+void TreeExportWriter::appendQuotedUnsigned(uint64_t value) {
+    appendLiteral("\"");
+    appendUnsigned(value);
+    appendLiteral("\"");
+}
+
+void TreeExportWriter::appendString(const std::string& value) {
+    static const char hex[] = "0123456789abcdef";
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(value.data());
+    size_t length = value.size();
+    size_t run_start = 0;
+
+    appendLiteral("\"");
+    size_t i = 0;
+    while (i < length) {
+        unsigned char c = data[i];
+        // 无需转义的 ASCII 连续片段整体复制
+        if (c >= 0x20 && c < 0x80 && c != '"' && c != '\\') {
+            ++i;
+            continue;
+        }
+
+        size_t sequence = c >= 0x80 ? utf8SequenceLength(data + i, length - i) : 0;
+        if (sequence > 0) {
+            i += sequence;
+            continue;
+        }
+
+        appendRaw(value.data() + run_start, i - run_start);
+        if (c == '"') {
+            appendLiteral("\\\"");
+        } else if (c == '\\') {
+            appendLiteral("\\\\");
+        } else if (c == '\n') {
+            appendLiteral("\\n");
+        } else if (c == '\r') {
+            appendLiteral("\\r");
+        } else if (c == '\t') {
+            appendLiteral("\\t");
+        } else if (c < 0x20) {
+            char escaped[6] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xf]};
+            appendRaw(escaped, sizeof(escaped));
+        } else {
+            // 非法 UTF-8 字节，与 JS 字符串转换一致替换为 U+FFFD
+            appendLiteral("\xef\xbf\xbd");
+        }
+        ++i;
+        run_start = i;
+    }
+    appendRaw(value.data() + run_start, length - run_start);
+    appendLiteral("\"");
+}
+
+void TreeExportWriter::flush() {
+    // 写出失败时丢弃缓冲，异常由调用方处理
+    size_t length = used_;
+    used_ = 0;
+    file_.write(buffer_.data(), length);
+}
+
+} // namespace filesystem
+} // namespace brisk
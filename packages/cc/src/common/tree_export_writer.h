@@ -0,0 +1,143 @@
+#pragma once
+
+#include "tree_sink.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace brisk {
+namespace filesystem {
+
+/**
+ * 目录树导出格式
+ */
+enum class ExportFormat {
+    JSON,       // 嵌套 JSON（与 JSON.stringify(buildDirectoryTree()) 的结构一致）
+    NDJSON      // 每行一个节点（不含 children，目录在其全部子项之后输出）
+};
+
+/**
+ * 目录树流式导出写入器
+ *
+ * 遍历过程中逐个节点写出，只缓冲固定大小的输出与当前路径上各层目录的状态，
+ * 导出所需内存与树的规模无关。整数与转义字符串直接格式化到缓冲区，不经过 JS 对象与 JSON.stringify。
+ * 64 位数值按 JS 实现转换 BigInt 后的口径写为十进制字符串，非法 UTF-8 字节替换为 U+FFFD。
+ */
+class TreeExportWriter : public TreeSink {
+private:
+    OutputFile file_;                       // 输出文件
+    ExportFormat format_;                   // 导出格式
+    std::vector<char> buffer_;              // 输出缓冲区
+    size_t used_;                           // 缓冲区已用字节数
+    std::vector<bool> has_children_;        // 各层打开的目录是否已写出子项（JSON 用于分隔符）
+    uint64_t entry_count_;                  // 已写出的节点数
+    bool finished_;                         // 是否已结束
+
+    static constexpr size_t BUFFER_SIZE = 65536;  // 输出缓冲区大小
+
+public:
+    /**
+     * 构造函数（写入已打开的文件描述符，不负责关闭）
+     * @param fd 文件描述符
+     * @param format 导出格式
+     */
+    TreeExportWriter(int fd, ExportFormat format);
+
+    /**
+     * 构造函数（写入临时文件，finish 时原子替换目标文件，导出失败时目标文件保持不变）
+     * @param path 文件路径
+     * @param format 导出格式
+     */
+    TreeExportWriter(const std::string& path, ExportFormat format);
+
+    void beginDirectory(const FileSystemItem& item, int depth) override;
+
+    /**
+     * 结束目录节点（NDJSON 在此输出目录行）
+     */
+    void endDirectory(const FileSystemItem& item, int depth, uint64_t total_size, uint64_t fingerprint,
+                      uint64_t newest_modified_time, uint64_t newest_accessed_time) override;
+
+    void writeEntry(const FileSystemItem& item, int depth, uint64_t total_size, uint64_t fingerprint,
+                    uint64_t newest_modified_time, uint64_t newest_accessed_time) override;
+
+    /**
+     * 结束导出，写出剩余缓冲并关闭、提交文件（JSON 未写出任何节点时写出 null）
+     */
+    void finish() override;
+
+    uint64_t entryCount() const override { return entry_count_; }
+
+    uint64_t bytesWritten() const override { return file_.offset(); }
+
+    uint64_t bufferBytes() const override { return BUFFER_SIZE; }
+
+private:
+    /**
+     * 写出节点前的分隔符（JSON 中同级节点之间的逗号）
+     */
+    void beginNode();
+
+    /**
+     * 写出 "item":{...},"totalSize":"...","depth":...,"fingerprint":"...",
+     * "newestModifiedTime":"...","newestAccessedTime":"..." 部分
+     */
+    void appendNodeFields(const FileSystemItem& item, int depth, uint64_t total_size, uint64_t fingerprint,
+                          uint64_t newest_modified_time, uint64_t newest_accessed_time);
+
+    /**
+     * 写出 ,"fingerprint":"...","newestModifiedTime":"...","newestAccessedTime":"..." 部分
+     */
+    void appendRollupFields(uint64_t fingerprint, uint64_t newest_modified_time, uint64_t newest_accessed_time);
+
+    /**
+     * 写出项目信息对象
+     */
+    void appendItem(const FileSystemItem& item);
+
+    /**
+     * 写出原始字节
+     */
+    void appendRaw(const char* data, size_t length);
+
+    /**
+     * 写出字符串字面量（不含引号与转义）
+     */
+    template <size_t N>
+    void appendLiteral(const char (&literal)[N]) { appendRaw(literal, N - 1); }
+
+    /**
+     * 写出十进制无符号整数
+     */
+    void appendUnsigned(uint64_t value);
+
+    /**
+     * 写出带引号的十进制无符号整数
+     */
+    void appendQuotedUnsigned(uint64_t value);
+
+    /**
+     * 写出带引号并转义的字符串
+     */
+    void appendString(const std::string& value);
+
+    /**
+     * 确保缓冲区剩余空间，不足时写出缓冲
+     * @param length 需要的字节数
+     */
+    void reserve(size_t length) {
+        if (buffer_.size() - used_ < length) {
+            flush();
+        }
+    }
+
+    /**
+     * 将缓冲区写出到文件
+     */
+    void flush();
+};
+
+} // namespace filesystem
+} // namespace brisk
@@ -0,0 +1,212 @@
+#include "tree_shape.h"
+#include <algorithm>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace brisk {
+namespace filesystem {
+
+namespace {
+
+/**
+ * 最小堆比较：子项较多的排在后面（数量相同时按路径排列，结果与线程划分无关）
+ */
+bool largerThan(const ShapeDirectory& a, const ShapeDirectory& b) {
+    if (a.entry_count != b.entry_count) {
+        return a.entry_count > b.entry_count;
+    }
+    return a.path < b.path;
+}
+
+/**
+ * 最小堆比较：较长的路径排在后面
+ */
+bool longerThan(const std::string& a, const std::string& b) {
+    if (a.size() != b.size()) {
+        return a.size() > b.size();
+    }
+    return a < b;
+}
+
+/**
+ * 加入有界最小堆，超出容量时淘汰堆顶
+ * @return 堆是否变大
+ */
+template <typename T, typename Compare>
+bool pushBounded(std::vector<T>& heap, T&& entry, size_t limit, Compare compare) {
+    if (limit == 0) {
+        return false;
+    }
+
+    if (heap.size() < limit) {
+        heap.push_back(std::move(entry));
+        std::push_heap(heap.begin(), heap.end(), compare);
+        return true;
+    }
+
+    if (!compare(entry, heap.front())) {
+        return false;
+    }
+
+    std::pop_heap(heap.begin(), heap.end(), compare);
+    heap.back() = std::move(entry);
+    std::push_heap(heap.begin(), heap.end(), compare);
+    return false;
+}
+
+/**
+ * 按百分位在分桶计数中查找桶下标
+ */
+uint32_t percentileBucket(const std::vector<uint64_t>& counts, uint64_t total, double percentile) {
+    if (percentile < 0) {
+        percentile = 0;
+    } else if (percentile > 100) {
+        percentile = 100;
+    }
+
+    uint64_t target = static_cast<uint64_t>(percentile / 100.0 * total + 0.5);
+    if (target == 0) {
+        target = 1;
+    }
+
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < counts.size(); ++i) {
+        seen += counts[i];
+        if (seen >= target) {
+            return i;
+        }
+    }
+    return counts.empty() ? 0 : static_cast<uint32_t>(counts.size() - 1);
+}
+
+/**
+ * 逐项累加计数，目标较短时补齐
+ */
+void addCounts(std::vector<uint64_t>& target, const std::vector<uint64_t>& source) {
+    if (target.size() < source.size()) {
+        target.resize(source.size(), 0);
+    }
+    for (size_t i = 0; i < source.size(); ++i) {
+        target[i] += source[i];
+    }
+}
+
+} // namespace
+
+bool TreeShape::recordEntry(const std::string& path, uint32_t depth, size_t limit) {
+    if (depth >= depth_counts_.size()) {
+        depth_counts_.resize(static_cast<size_t>(depth) + 1, 0);
+    }
+    depth_counts_[depth]++;
+
+    if (path_length_counts_.empty()) {
+        path_length_counts_.assign(PATH_LENGTH_BUCKET_COUNT, 0);
+    }
+    uint64_t length = path.size();
+    path_length_counts_[std::min<uint64_t>(length / PATH_LENGTH_BUCKET_WIDTH, PATH_LENGTH_BUCKET_COUNT - 1)]++;
+
+    entries_++;
+    depth_sum_ += depth;
+    path_length_sum_ += length;
+    path_length_max_ = std::max(path_length_max_, length);
+
+    // 先与堆顶比较，大多数路径无需复制
+    if (limit == 0 || (longest_paths_.size() >= limit && !longerThan(path, longest_paths_.front()))) {
+        return false;
+    }
+    return pushBounded(longest_paths_, std::string(path), limit, longerThan);
+}
+
+bool TreeShape::recordDirectory(const std::string& path, uint64_t entry_count, size_t limit) {
+    if (fanout_counts_.empty()) {
+        fanout_counts_.assign(FANOUT_BUCKET_COUNT, 0);
+    }
+    fanout_counts_[fanoutBucket(entry_count)]++;
+
+    directories_++;
+    fanout_sum_ += entry_count;
+    fanout_max_ = std::max(fanout_max_, entry_count);
+
+    if (limit == 0 || (largest_directories_.size() >= limit && entry_count < largest_directories_.front().entry_count)) {
+        return false;
+    }
+    ShapeDirectory directory;
+    directory.path = path;
+    directory.entry_count = entry_count;
+    return pushBounded(largest_directories_, std::move(directory), limit, largerThan);
+}
+
+void TreeShape::merge(TreeShape& other, size_t limit) {
+    addCounts(depth_counts_, other.depth_counts_);
+    addCounts(fanout_counts_, other.fanout_counts_);
+    addCounts(path_length_counts_, other.path_length_counts_);
+
+    entries_ += other.entries_;
+    directories_ += other.directories_;
+    depth_sum_ += other.depth_sum_;
+    fanout_sum_ += other.fanout_sum_;
+    fanout_max_ = std::max(fanout_max_, other.fanout_max_);
+    path_length_sum_ += other.path_length_sum_;
+    path_length_max_ = std::max(path_length_max_, other.path_length_max_);
+
+    for (auto& directory : other.largest_directories_) {
+        pushBounded(largest_directories_, std::move(directory), limit, largerThan);
+    }
+    other.largest_directories_.clear();
+    for (auto& path : other.longest_paths_) {
+        pushBounded(longest_paths_, std::move(path), limit, longerThan);
+    }
+    other.longest_paths_.clear();
+}
+
+void TreeShape::finalize() {
+    std::sort(largest_directories_.begin(), largest_directories_.end(), largerThan);
+    std::sort(longest_paths_.begin(), longest_paths_.end(), longerThan);
+}
+
+uint64_t TreeShape::fanoutPercentile(double percentile) const {
+    if (directories_ == 0) {
+        return 0;
+    }
+    uint32_t index = percentileBucket(fanout_counts_, directories_, percentile);
+    return std::min(fanoutBucketMax(index), fanout_max_);
+}
+
+uint64_t TreeShape::pathLengthPercentile(double percentile) const {
+    if (entries_ == 0) {
+        return 0;
+    }
+    uint32_t index = percentileBucket(path_length_counts_, entries_, percentile);
+    uint64_t upper = (static_cast<uint64_t>(index) + 1) * PATH_LENGTH_BUCKET_WIDTH - 1;
+    return std::min(upper, path_length_max_);
+}
+
+uint64_t TreeShape::fanoutBucketMin(uint32_t index) {
+    return index == 0 ? 0 : 1ull << (index - 1);
+}
+
+uint64_t TreeShape::fanoutBucketMax(uint32_t index) {
+    if (index == 0) {
+        return 0;
+    }
+    return index >= FANOUT_BUCKET_COUNT - 1 ? UINT64_MAX : (1ull << index) - 1;
+}
+
+uint32_t TreeShape::fanoutBucket(uint64_t entry_count) {
+    if (entry_count == 0) {
+        return 0;
+    }
+#ifdef _MSC_VER
+    unsigned long highest;
+    _BitScanReverse64(&highest, entry_count);
+    uint32_t index = static_cast<uint32_t>(highest) + 1;
+#else
+    uint32_t index = 64 - static_cast<uint32_t>(__builtin_clzll(entry_count));
+#endif
+    return std::min(index, FANOUT_BUCKET_COUNT - 1);
+}
+
+} // namespace filesystem
+} // namespace brisk
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace brisk {
+namespace filesystem {
+
+/**
+ * 按子项数量排名的目录
+ */
+struct ShapeDirectory {
+    std::string path;                       // 目录路径
+    uint64_t entry_count;                   // 子项数量（列目录得到的全部项目，含隐藏与忽略的项目）
+
+    ShapeDirectory() : entry_count(0) {}
+};
+
+/**
+ * 目录树形状统计
+ * 深度分布、目录扇出（子项数）分布、路径长度分布，以及子项最多的目录与最长的路径。
+ * 每个遍历线程在自己的结果中记录，结束时合并；直方图首次记录时分配，排名用容量为 N 的最小堆维护
+ */
+class TreeShape {
+public:
+    static constexpr uint32_t FANOUT_BUCKET_COUNT = 34;        // 扇出桶数：0、1、2-3、4-7 ... 2^32 以上
+    static constexpr uint32_t PATH_LENGTH_BUCKET_WIDTH = 8;    // 路径长度桶宽（字节）
+    static constexpr uint32_t PATH_LENGTH_BUCKET_COUNT = 513;  // 路径长度桶数（覆盖 4096 字节，最后一桶为溢出）
+
+private:
+    std::vector<uint64_t> depth_counts_;        // 各深度的项目数（下标为深度，根为 0）
+    std::vector<uint64_t> fanout_counts_;       // 目录扇出的对数分桶计数
+    std::vector<uint64_t> path_length_counts_;  // 路径长度的线性分桶计数
+    uint64_t entries_;                          // 记录的项目数
+    uint64_t directories_;                      // 记录扇出的目录数
+    uint64_t depth_sum_;                        // 深度之和
+    uint64_t fanout_sum_;                       // 扇出之和
+    uint64_t fanout_max_;                       // 最大扇出
+    uint64_t path_length_sum_;                  // 路径长度之和
+    uint64_t path_length_max_;                  // 最长路径长度
+    std::vector<ShapeDirectory> largest_directories_;   // 子项最多的目录（最小堆，finalize 后降序）
+    std::vector<std::string> longest_paths_;            // 最长的路径（最小堆，finalize 后降序）
+
+public:
+    TreeShape() : entries_(0), directories_(0), depth_sum_(0), fanout_sum_(0), fanout_max_(0),
+                  path_length_sum_(0), path_length_max_(0) {}
+
+    /**
+     * 记录一个计入统计的项目（文件、目录或符号链接）
+     * @param path 项目路径
+     * @param depth 深度（根为 0）
+     * @param limit 最长路径的保留数量
+     * @return 是否新增保留了一条路径（用于内存统计）
+     */
+    bool recordEntry(const std::string& path, uint32_t depth, size_t limit);
+
+    /**
+     * 记录一个已列出的目录
+     * @param path 目录路径
+     * @param entry_count 子项数量
+     * @param limit 最大目录的保留数量
+     * @return 是否新增保留了一条路径（用于内存统计）
+     */
+    bool recordDirectory(const std::string& path, uint64_t entry_count, size_t limit);
+
+    /**
+     * 合并另一个线程的统计（来源的排名被移走）
+     * @param other 来源
+     * @param limit 排名的保留数量
+     */
+    void merge(TreeShape& other, size_t limit);
+
+    /**
+     * 将排名转换为降序列表
+     */
+    void finalize();
+
+    /**
+     * 扇出百分位数
+     * @param percentile 百分位（0 - 100）
+     * @return 对应的子项数（桶的上界，不超过最大值）
+     */
+    uint64_t fanoutPercentile(double percentile) const;
+
+    /**
+     * 路径长度百分位数
+     * @param percentile 百分位（0 - 100）
+     * @return 对应的路径长度（字节，桶的上界，不超过最大值）
+     */
+    uint64_t pathLengthPercentile(double percentile) const;
+
+    /**
+     * 扇出桶的下界
+     * @param index 桶下标
+     */
+    static uint64_t fanoutBucketMin(uint32_t index);
+
+    /**
+     * 扇出桶的上界
+     * @param index 桶下标
+     */
+    static uint64_t fanoutBucketMax(uint32_t index);
+
+    const std::vector<uint64_t>& depthCounts() const { return depth_counts_; }
+    const std::vector<uint64_t>& fanoutCounts() const { return fanout_counts_; }
+    const std::vector<ShapeDirectory>& largestDirectories() const { return largest_directories_; }
+    const std::vector<std::string>& longestPaths() const { return longest_paths_; }
+    uint64_t entries() const { return entries_; }
+    uint64_t directories() const { return directories_; }
+    uint64_t fanoutMax() const { return fanout_max_; }
+    uint64_t pathLengthMax() const { return path_length_max_; }
+    double depthMean() const { return entries_ > 0 ? static_cast<double>(depth_sum_) / entries_ : 0.0; }
+    double fanoutMean() const { return directories_ > 0 ? static_cast<double>(fanout_sum_) / directories_ : 0.0; }
+    double pathLengthMean() const { return entries_ > 0 ? static_cast<double>(path_length_sum_) / entries_ : 0.0; }
+
+private:
+    /**
+     * 扇出对应的桶下标
+     */
+    static uint32_t fanoutBucket(uint64_t entry_count);
+};
+
+} // namespace filesystem
+} // namespace brisk
@@ -0,0 +1,131 @@
+#include "tree_sink.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#ifdef PLATFORM_WINDOWS
+#include <Windows.h>
+#include <fcntl.h>
+#include <io.h>
+#include <process.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace brisk {
+namespace filesystem {
+
+OutputFile::OutputFile(int fd) : fd_(fd), owns_fd_(false), offset_(0) {
+    if (fd_ < 0) {
+        throw FilesystemException("Invalid file descriptor: " + std::to_string(fd), ErrorType::INVALID_PATH);
+    }
+}
+
+OutputFile::OutputFile(const std::string& path, bool replace) : fd_(-1), owns_fd_(true), offset_(0) {
+    std::string open_path = path;
+    if (replace) {
+        path_ = path;
+#ifdef PLATFORM_WINDOWS
+        temp_path_ = path + ".tmp-" + std::to_string(_getpid());
+#else
+        temp_path_ = path + ".tmp-" + std::to_string(getpid());
+#endif
+        open_path = temp_path_;
+    }
+#ifdef PLATFORM_WINDOWS
+    fd_ = _open(open_path.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+    fd_ = open(open_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+#endif
+    if (fd_ < 0) {
+        throw FilesystemException("Cannot open export file: " + open_path + " (" + std::strerror(errno) + ")",
+                                  ErrorType::IO_ERROR);
+    }
+}
+
+OutputFile::~OutputFile() {
+    if (owns_fd_ && fd_ >= 0) {
+#ifdef PLATFORM_WINDOWS
+        _close(fd_);
+#else
+        close(fd_);
+#endif
+    }
+    if (!temp_path_.empty()) {
+        std::remove(temp_path_.c_str());
+    }
+}
+
+void OutputFile::commit() {
+    if (owns_fd_ && fd_ >= 0) {
+#ifdef PLATFORM_WINDOWS
+        int result = _close(fd_);
+#else
+        int result = close(fd_);
+#endif
+        fd_ = -1;
+        if (result != 0) {
+            throw FilesystemException("Cannot write export file: " + std::string(std::strerror(errno)),
+                                      ErrorType::IO_ERROR);
+        }
+    }
+    if (temp_path_.empty()) {
+        return;
+    }
+
+#ifdef PLATFORM_WINDOWS
+    bool renamed = MoveFileExA(temp_path_.c_str(), path_.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    bool renamed = std::rename(temp_path_.c_str(), path_.c_str()) == 0;
+#endif
+    if (!renamed) {
+        throw FilesystemException("Cannot replace export file: " + path_ + " (" + std::strerror(errno) + ")",
+                                  ErrorType::IO_ERROR);
+    }
+    temp_path_.clear();
+}
+
+void OutputFile::write(const void* data, size_t length) {
+    const char* bytes = static_cast<const char*>(data);
+    size_t offset = 0;
+    while (offset < length) {
+#ifdef PLATFORM_WINDOWS
+        int written = _write(fd_, bytes + offset, static_cast<unsigned int>(length - offset));
+#else
+        ssize_t written = ::write(fd_, bytes + offset, length - offset);
+#endif
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw FilesystemException("Cannot write export file: " + std::string(std::strerror(errno)),
+                                      ErrorType::IO_ERROR);
+        }
+        offset += static_cast<size_t>(written);
+    }
+    offset_ += length;
+}
+
+void TreeSink::writeTree(const std::shared_ptr<TreeNode>& node) {
+    if (!node) {
+        return;
+    }
+
+    if (node->item.type != ItemType::DIRECTORY) {
+        writeEntry(node->item, node->depth, node->total_size, node->fingerprint, node->newest_modified_time,
+                   node->newest_accessed_time);
+        return;
+    }
+
+    beginDirectory(node->item, node->depth);
+    for (const auto& child : node->children) {
+        writeTree(child);
+    }
+    endDirectory(node->item, node->depth, node->total_size, node->fingerprint, node->newest_modified_time,
+                 node->newest_accessed_time);
+}
+
+} // namespace filesystem
+} // namespace brisk
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "filesystem_common.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace brisk {
+namespace filesystem {
+
+/**
+ * 导出输出文件（无缓冲，调用方按块写入）
+ */
+class OutputFile {
+private:
+    int fd_;                                // 文件描述符
+    bool owns_fd_;                          // 是否由本对象打开（析构时关闭）
+    uint64_t offset_;                       // 已写出的字节数
+    std::string path_;                      // 目标文件路径（替换模式）
+    std::string temp_path_;                 // 实际写入的临时文件路径（替换模式，提交后为空）
+
+public:
+    /**
+     * 构造函数（写入已打开的文件描述符，不负责关闭）
+     * @param fd 文件描述符
+     */
+    explicit OutputFile(int fd);
+
+    /**
+     * 构造函数（创建或截断文件）
+     * @param path 文件路径
+     * @param replace 替换模式：先写入同目录下的临时文件，commit 时再原子替换目标文件，
+     *                避免截断仍被其他读取者内存映射的旧文件；未提交的临时文件在析构时删除
+     */
+    explicit OutputFile(const std::string& path, bool replace = false);
+
+    ~OutputFile();
+
+    /**
+     * 提交写入：关闭文件，替换模式下将临时文件重命名为目标文件
+     */
+    void commit();
+
+    OutputFile(const OutputFile&) = delete;
+    OutputFile& operator=(const OutputFile&) = delete;
+
+    /**
+     * 写出全部数据（处理部分写入与中断）
+     * @param data 数据
+     * @param length 字节数
+     */
+    void write(const void* data, size_t length);
+
+    /**
+     * 已写出的字节数（即下一次写入在本次导出中的偏移）
+     * @return 字节数
+     */
+    uint64_t offset() const { return offset_; }
+};
+
+/**
+ * 目录树导出目标
+ *
+ * 遍历按深度优先顺序回调：目录先 beginDirectory，其子项全部写出后 endDirectory（此时总大小与指纹已确定），
+ * 文件与符号链接只调用一次 writeEntry。实现只需保留当前路径上各层目录的状态。
+ */
+class TreeSink {
+public:
+    virtual ~TreeSink() = default;
+
+    /**
+     * 开始写出目录节点，之后写出的节点均为其子项，直到对应的 endDirectory
+     * @param item 目录信息
+     * @param depth 深度
+     */
+    virtual void beginDirectory(const FileSystemItem& item, int depth) = 0;
+
+    /**
+     * 结束目录节点
+     * @param item 目录信息
+     * @param depth 深度
+     * @param total_size 总大小
+     * @param fingerprint 元数据指纹
+     * @param newest_modified_time 子树中最新的修改时间（毫秒，含自身）
+     * @param newest_accessed_time 子树中文件与链接最新的访问时间（毫秒，不含目录）
+     */
+    virtual void endDirectory(const FileSystemItem& item, int depth, uint64_t total_size, uint64_t fingerprint,
+                              uint64_t newest_modified_time, uint64_t newest_accessed_time) = 0;
+
+    /**
+     * 写出没有子项的节点（文件、符号链接）
+     * @param item 项目信息
+     * @param depth 深度
+     * @param total_size 总大小
+     * @param fingerprint 元数据指纹
+     * @param newest_modified_time 最新的修改时间（毫秒，即自身的修改时间）
+     * @param newest_accessed_time 最新的访问时间（毫秒，即自身的访问时间）
+     */
+    virtual void writeEntry(const FileSystemItem& item, int depth, uint64_t total_size, uint64_t fingerprint,
+                            uint64_t newest_modified_time, uint64_t newest_accessed_time) = 0;
+
+    /**
+     * 结束导出并写出剩余数据
+     */
+    virtual void finish() = 0;
+
+    /**
+     * 已写出的节点数
+     * @return 节点数
+     */
+    virtual uint64_t entryCount() const = 0;
+
+    /**
+     * 已写出的字节数
+     * @return 字节数
+     */
+    virtual uint64_t bytesWritten() const = 0;
+
+    /**
+     * 导出期间常驻的缓冲区大小（用于内存统计）
+     * @return 字节数
+     */
+    virtual uint64_t bufferBytes() const = 0;
+
+    /**
+     * 写出已构建的目录树（不支持流式遍历的平台使用）
+     * @param node 根节点（为空时不写出）
+     */
+    void writeTree(const std::shared_ptr<TreeNode>& node);
+};
+
+} // namespace filesystem
+} // namespace brisk
@@ -0,0 +1,526 @@
+#include "content_digest.h"
+#include "../common/bounded_queue.h"
+#include "../common/ignore_patterns.h"
+#include "../common/latency_histogram.h"
+
+#ifdef PLATFORM_LINUX
+
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace brisk {
+namespace filesystem {
+
+namespace {
+
+constexpr uint32_t DEFAULT_READ_SIZE = 1u << 20;         // 默认单次读取 1 MiB
+constexpr uint32_t MIN_READ_SIZE = 64u << 10;            // 单次读取下限
+constexpr uint32_t MAX_READ_SIZE = 64u << 20;            // 单次读取上限
+constexpr uint64_t SEGMENT_BYTES = 16ull << 20;          // 大文件片段大小（16384 个分块，2 的幂）
+constexpr size_t TASK_QUEUE_CAPACITY = 65536;            // 读取任务队列容量
+constexpr size_t DIRENT_BUFFER_SIZE = 64 * 1024;         // getdents64 缓冲区大小
+constexpr uint32_t MAX_AUTO_THREADS = 64;                // 自动线程数上限
+
+/**
+ * 目录树节点
+ */
+struct DigestNode {
+    std::string name;                           // 名称
+    size_t parent;                              // 父节点下标（根节点为 0）
+    ItemType type;                              // 类型
+    uint64_t size;                              // 大小（目录为子树内文件大小之和）
+    bool failed;                                // 是否出错（在父目录摘要中以失败标记代替）
+    std::vector<size_t> children;               // 子节点下标（仅目录，由列目录线程写入）
+    uint8_t digest[Blake3Hasher::OUT_LEN];      // 摘要
+
+    DigestNode(std::string name, size_t parent, ItemType type)
+        : name(std::move(name)), parent(parent), type(type), size(0), failed(false), digest{} {}
+};
+
+/**
+ * 按片段并行读取的大文件（最后一个完成的片段负责合并）
+ */
+struct SegmentedFile {
+    int fd;                                             // 文件描述符（所有片段共用）
+    std::string path;                                   // 文件路径
+    DigestNode* node;                                   // 对应节点
+    uint64_t size;                                      // 文件大小
+    size_t segment_count;                               // 片段数（最后一个为尾部片段）
+    std::vector<std::array<uint32_t, 8>> segments;      // 除尾部外各片段的子树链值
+    uint32_t tail[8];                                   // 尾部片段的子树链值
+    std::atomic<size_t> remaining;                      // 未完成的片段数
+    std::atomic<bool> failed;                           // 是否有片段读取失败
+
+    SegmentedFile(int fd, std::string path, DigestNode* node, uint64_t size)
+        : fd(fd), path(std::move(path)), node(node), size(size),
+          segment_count(static_cast<size_t>((size + SEGMENT_BYTES - 1) / SEGMENT_BYTES)),
+          segments(segment_count - 1), tail{}, remaining(segment_count), failed(false) {}
+
+    ~SegmentedFile() {
+        countProcessSyscall(SyscallType::CLOSE);
+        close(fd);
+    }
+};
+
+/**
+ * 读取任务：整个文件，或大文件的一个片段
+ */
+struct DigestTask {
+    DigestNode* node;                           // 文件节点
+    std::string path;                           // 文件路径
+    std::shared_ptr<SegmentedFile> file;        // 所属大文件（为空时为整个文件）
+    size_t segment;                             // 片段序号
+
+    DigestTask() : node(nullptr), segment(0) {}
+};
+
+/**
+ * 拼接子路径
+ */
+std::string joinPath(const std::string& directory, const char* name) {
+    std::string path = directory;
+    if (path.empty() || path.back() != '/') {
+        path += '/';
+    }
+    path += name;
+    return path;
+}
+
+/**
+ * 一次摘要计算的状态
+ */
+class DigestRun {
+private:
+    const ContentDigestOptions& options_;
+    uint32_t read_size_;
+    IgnorePatternSet ignore_patterns_;
+    std::deque<DigestNode> nodes_;              // 全部节点（先序追加，读取线程通过指针写入文件节点）
+    BoundedQueue<DigestTask> queue_;            // 读取任务队列
+    std::atomic<size_t> pending_;               // 已入队但未完成的任务数
+    std::atomic<bool> listing_done_;            // 列目录是否结束
+    std::atomic<uint64_t> bytes_hashed_;        // 已哈希的字节数
+    std::mutex errors_mutex_;
+    ContentDigestResult& result_;
+
+public:
+    DigestRun(const ContentDigestOptions& options, ContentDigestResult& result)
+        : options_(options),
+          read_size_(options.read_size == 0 ? DEFAULT_READ_SIZE
+                                            : std::min(std::max(options.read_size, MIN_READ_SIZE), MAX_READ_SIZE)),
+          queue_(TASK_QUEUE_CAPACITY),
+          pending_(0),
+          listing_done_(false),
+          bytes_hashed_(0),
+          result_(result) {
+        ignore_patterns_.compile(options.ignore_patterns);
+    }
+
+    void run(const std::string& path) {
+        uint32_t threads = options_.threads;
+        if (threads == 0) {
+            threads = std::min(std::max(std::thread::hardware_concurrency(), 4u), MAX_AUTO_THREADS);
+        }
+        result_.threads = threads;
+
+        struct stat st;
+        countProcessSyscall(SyscallType::STAT);
+        if (stat(path.c_str(), &st) != 0) {
+            throw std::runtime_error("Path not found: " + path);
+        }
+        if (!S_ISDIR(st.st_mode) && !S_ISREG(st.st_mode)) {
+            throw std::runtime_error("Unsupported file type: " + path);
+        }
+
+        std::vector<std::thread> readers;
+        readers.reserve(threads);
+        for (uint32_t i = 0; i < threads; ++i) {
+            readers.emplace_back([this, threads]() { readerLoop(threads > 1); });
+        }
+
+        try {
+            if (S_ISDIR(st.st_mode)) {
+                nodes_.emplace_back(".", 0, ItemType::DIRECTORY);
+                result_.directory_count++;
+                listTree(path);
+            } else {
+                nodes_.emplace_back(".", 0, ItemType::FILE);
+                result_.file_count++;
+                enqueueFile(&nodes_.back(), path);
+            }
+        } catch (...) {
+            queue_.close();
+            for (auto& reader : readers) {
+                reader.join();
+            }
+            throw;
+        }
+
+        listing_done_.store(true);
+        if (pending_.load() == 0) {
+            queue_.close();
+        }
+        for (auto& reader : readers) {
+            reader.join();
+        }
+
+        combineDirectories();
+        if (nodes_[0].failed) {
+            throw std::runtime_error(result_.errors.empty() ? "Cannot digest: " + path : result_.errors.front());
+        }
+        std::memcpy(result_.digest, nodes_[0].digest, sizeof(result_.digest));
+        collectEntries();
+        result_.bytes_hashed = bytes_hashed_.load();
+    }
+
+private:
+    void addError(const std::string& message) {
+        std::lock_guard<std::mutex> lock(errors_mutex_);
+        result_.errors.push_back(message);
+    }
+
+    void enqueueFile(DigestNode* node, const std::string& path) {
+        DigestTask task;
+        task.node = node;
+        task.path = path;
+        pending_.fetch_add(1);
+        queue_.push(std::move(task));
+    }
+
+    /**
+     * 任务完成；列目录已结束且没有未完成的任务时关闭队列
+     */
+    void finishTask() {
+        if (pending_.fetch_sub(1) == 1 && listing_done_.load()) {
+            queue_.close();
+        }
+    }
+
+    /**
+     * 深度优先列出目录树（调用线程），普通文件入队，符号链接直接计算摘要
+     */
+    void listTree(const std::string& root) {
+        std::vector<char> buffer(DIRENT_BUFFER_SIZE);
+        std::vector<std::pair<size_t, std::string>> stack;
+        stack.emplace_back(0, root);
+
+        while (!stack.empty()) {
+            size_t index = stack.back().first;
+            std::string path = std::move(stack.back().second);
+            stack.pop_back();
+
+            countProcessSyscall(SyscallType::OPEN);
+            int dir_fd = open(path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+            if (dir_fd == -1) {
+                nodes_[index].failed = true;
+                addError("Cannot open directory: " + path);
+                continue;
+            }
+
+            while (true) {
+                countProcessSyscall(SyscallType::GETDENTS);
+                ssize_t bytes_read = syscall(SYS_getdents64, dir_fd, buffer.data(), buffer.size());
+                if (bytes_read == -1) {
+                    nodes_[index].failed = true;
+                    addError("Cannot list directory: " + path);
+                    break;
+                }
+                if (bytes_read == 0) {
+                    break;
+                }
+
+                size_t offset = 0;
+                while (offset < static_cast<size_t>(bytes_read)) {
+                    struct linux_dirent64 {
+                        ino_t d_ino;
+                        off_t d_off;
+                        unsigned short d_reclen;
+                        unsigned char d_type;
+                        char d_name[];
+                    };
+                    auto* entry = reinterpret_cast<linux_dirent64*>(buffer.data() + offset);
+                    offset += entry->d_reclen;
+                    addEntry(index, path, dir_fd, entry->d_name, entry->d_type, stack);
+                }
+            }
+
+            countProcessSyscall(SyscallType::CLOSE);
+            close(dir_fd);
+        }
+    }
+
+    void addEntry(size_t parent, const std::string& directory, int dir_fd, const char* name, unsigned char d_type,
+                  std::vector<std::pair<size_t, std::string>>& stack) {
+        if (std::strcmp(name, ".") == 0 || std::strcmp(name, "..") == 0) {
+            return;
+        }
+        if (!options_.include_hidden && name[0] == '.') {
+            return;
+        }
+
+        std::string path = joinPath(directory, name);
+        if (!ignore_patterns_.empty() && ignore_patterns_.matches(path)) {
+            return;
+        }
+
+        if (d_type == DT_UNKNOWN) {
+            struct stat st;
+            countProcessSyscall(SyscallType::STAT);
+            if (fstatat(dir_fd, name, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+                addError("Cannot access: " + path);
+                return;
+            }
+            d_type = S_ISREG(st.st_mode) ? DT_REG : S_ISDIR(st.st_mode) ? DT_DIR : S_ISLNK(st.st_mode) ? DT_LNK : 0;
+        }
+
+        ItemType type;
+        if (d_type == DT_REG) {
+            type = ItemType::FILE;
+        } else if (d_type == DT_DIR) {
+            type = ItemType::DIRECTORY;
+        } else if (d_type == DT_LNK) {
+            type = ItemType::SYMBOLIC_LINK;
+        } else {
+            return;     // 设备、管道、套接字没有可摘要的内容
+        }
+
+        size_t index = nodes_.size();
+        nodes_.emplace_back(name, parent, type);
+        nodes_[parent].children.push_back(index);
+        DigestNode& node = nodes_.back();
+
+        if (type == ItemType::FILE) {
+            result_.file_count++;
+            enqueueFile(&node, path);
+        } else if (type == ItemType::DIRECTORY) {
+            result_.directory_count++;
+            stack.emplace_back(index, std::move(path));
+        } else {
+            result_.symlink_count++;
+            char target[4096];
+            ssize_t length = readlinkat(dir_fd, name, target, sizeof(target));
+            if (length < 0) {
+                node.failed = true;
+                addError("Cannot read link: " + path);
+                return;
+            }
+            Blake3Hasher::hash(target, static_cast<size_t>(length), node.digest);
+        }
+    }
+
+    /**
+     * 读取线程：依次处理整个文件或大文件片段
+     */
+    void readerLoop(bool split_large_files) {
+        std::unique_ptr<uint8_t[]> buffer(new uint8_t[read_size_]);
+        DigestTask task;
+        while (queue_.pop(task)) {
+            if (task.file) {
+                hashSegment(*task.file, task.segment, buffer.get());
+            } else {
+                hashFile(task, buffer.get(), split_large_files);
+            }
+            task = DigestTask();
+            finishTask();
+        }
+    }
+
+    int openFile(const std::string& path) {
+        countProcessSyscall(SyscallType::OPEN);
+        // O_NOATIME 只对文件所有者（或特权进程）可用，被拒绝时退回普通打开
+        int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC | O_NOATIME);
+        if (fd == -1 && errno == EPERM) {
+            fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        }
+        return fd;
+    }
+
+    /**
+     * 从 offset 开始读取 length 字节并追加到哈希
+     * @return 是否读满（文件被截断或读取出错时为 false）
+     */
+    bool readRange(int fd, const std::string& path, uint64_t offset, uint64_t length, uint8_t* buffer,
+                   Blake3Hasher& hasher) {
+        while (length > 0) {
+            size_t request = static_cast<size_t>(std::min<uint64_t>(length, read_size_));
+            ssize_t bytes_read = pread(fd, buffer, request, static_cast<off_t>(offset));
+            if (bytes_read < 0 && errno == EINTR) {
+                continue;
+            }
+            if (bytes_read <= 0) {
+                addError(bytes_read == 0 ? "File changed during read: " + path : "Cannot read file: " + path);
+                return false;
+            }
+
+            hasher.update(buffer, static_cast<size_t>(bytes_read));
+            if (options_.drop_cache) {
+                posix_fadvise(fd, static_cast<off_t>(offset), bytes_read, POSIX_FADV_DONTNEED);
+            }
+            bytes_hashed_.fetch_add(static_cast<uint64_t>(bytes_read), std::memory_order_relaxed);
+            offset += static_cast<uint64_t>(bytes_read);
+            length -= static_cast<uint64_t>(bytes_read);
+        }
+        return true;
+    }
+
+    void hashFile(const DigestTask& task, uint8_t* buffer, bool split_large_files) {
+        int fd = openFile(task.path);
+        if (fd == -1) {
+            task.node->failed = true;
+            addError("Cannot open file: " + task.path);
+            return;
+        }
+
+        struct stat st;
+        countProcessSyscall(SyscallType::STAT);
+        if (fstat(fd, &st) != 0) {
+            task.node->failed = true;
+            addError("Cannot access: " + task.path);
+            countProcessSyscall(SyscallType::CLOSE);
+            close(fd);
+            return;
+        }
+        uint64_t size = static_cast<uint64_t>(st.st_size);
+        task.node->size = size;
+        posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+        if (split_large_files && size > SEGMENT_BYTES) {
+            // 其余片段交给其他读取线程（不受队列容量限制，读取线程不能阻塞），本线程处理第一个片段
+            auto file = std::make_shared<SegmentedFile>(fd, task.path, task.node, size);
+            for (size_t i = 1; i < file->segment_count; ++i) {
+                DigestTask segment;
+                segment.node = task.node;
+                segment.file = file;
+                segment.segment = i;
+                pending_.fetch_add(1);
+                queue_.forcePush(std::move(segment));
+            }
+            hashSegment(*file, 0, buffer);
+            return;
+        }
+
+        Blake3Hasher hasher;
+        if (readRange(fd, task.path, 0, size, buffer, hasher)) {
+            hasher.finalize(task.node->digest);
+        } else {
+            task.node->failed = true;
+        }
+        countProcessSyscall(SyscallType::CLOSE);
+        close(fd);
+    }
+
+    void hashSegment(SegmentedFile& file, size_t segment, uint8_t* buffer) {
+        uint64_t offset = segment * SEGMENT_BYTES;
+        bool tail = segment + 1 == file.segment_count;
+        uint64_t length = tail ? file.size - offset : SEGMENT_BYTES;
+
+        Blake3Hasher hasher(offset / Blake3Hasher::CHUNK_LEN);
+        if (readRange(file.fd, file.path, offset, length, buffer, hasher)) {
+            hasher.finalizeSubtree(tail ? file.tail : file.segments[segment].data());
+        } else {
+            file.failed.store(true);
+        }
+
+        // 最后完成的片段合并全部子树链值
+        if (file.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            if (file.failed.load()) {
+                file.node->failed = true;
+            } else {
+                Blake3Hasher::combineSegments(file.segments, file.tail, file.node->digest);
+            }
+        }
+    }
+
+    /**
+     * 自底向上计算目录摘要（子节点总是排在父节点之后）
+     */
+    void combineDirectories() {
+        for (size_t i = nodes_.size(); i > 0; --i) {
+            DigestNode& node = nodes_[i - 1];
+            if (node.type != ItemType::DIRECTORY || node.failed) {
+                continue;
+            }
+
+            std::sort(node.children.begin(), node.children.end(), [this](size_t a, size_t b) {
+                return nodes_[a].name < nodes_[b].name;
+            });
+
+            Blake3Hasher hasher;
+            for (size_t child_index : node.children) {
+                const DigestNode& child = nodes_[child_index];
+                if (child.failed) {
+                    // 出错的子项以失败标记 (e, 名称) 参与，摘要不同于缺少该子项或内容正常时的摘要
+                    hasher.update("e", 1);
+                    hasher.update(child.name.data(), child.name.size());
+                    hasher.update("", 1);
+                    continue;
+                }
+                char type = child.type == ItemType::DIRECTORY ? 'd' : child.type == ItemType::SYMBOLIC_LINK ? 'l' : 'f';
+                hasher.update(&type, 1);
+                hasher.update(child.name.data(), child.name.size());
+                hasher.update("", 1);
+                hasher.update(child.digest, sizeof(child.digest));
+                node.size += child.size;
+            }
+            hasher.finalize(node.digest);
+        }
+    }
+
+    /**
+     * 按排序后的子项先序输出摘要
+     */
+    void collectEntries() {
+        std::vector<std::pair<size_t, std::string>> stack;
+        stack.emplace_back(0, ".");
+        while (!stack.empty()) {
+            size_t index = stack.back().first;
+            std::string path = std::move(stack.back().second);
+            stack.pop_back();
+
+            const DigestNode& node = nodes_[index];
+            if (node.type == ItemType::DIRECTORY || options_.include_files) {
+                ContentDigestEntry entry;
+                entry.type = node.type;
+                entry.size = node.size;
+                std::memcpy(entry.digest, node.digest, sizeof(entry.digest));
+                entry.path = path;
+                result_.entries.push_back(std::move(entry));
+            }
+
+            for (size_t i = node.children.size(); i > 0; --i) {
+                const DigestNode& child = nodes_[node.children[i - 1]];
+                if (!child.failed) {
+                    stack.emplace_back(node.children[i - 1], index == 0 ? child.name : path + "/" + child.name);
+                }
+            }
+        }
+    }
+};
+
+} // namespace
+
+ContentDigestResult ContentDigester::digest(const std::string& path, const ContentDigestOptions& options) {
+    uint64_t start_time = Utils::getCurrentTimestamp();
+    ContentDigestResult result;
+    DigestRun run(options, result);
+    run.run(path);
+    result.duration_ms = Utils::getCurrentTimestamp() - start_time;
+    return result;
+}
+
+} // namespace filesystem
+} // namespace brisk
+
+#endif // PLATFORM_LINUX
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "../common/filesystem_common.h"
+#include "../common/blake3_hasher.h"
+
+#ifdef PLATFORM_LINUX
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace brisk {
+namespace filesystem {
+
+/**
+ * 内容摘要选项
+ */
+struct ContentDigestOptions {
+    uint32_t threads;                           // 读取线程数（0 为自动）
+    uint32_t read_size;                         // 单次 pread 的字节数（0 为默认 1 MiB）
+    bool include_hidden;                        // 是否包含隐藏文件
+    std::vector<std::string> ignore_patterns;   // 忽略模式（匹配完整路径）
+    bool include_files;                         // 结果中是否包含各文件的摘要（目录总是包含）
+    bool drop_cache;                            // 读取后是否通知内核丢弃对应的页缓存
+
+    ContentDigestOptions() : threads(0), read_size(0), include_hidden(true), include_files(false),
+                             drop_cache(true) {}
+};
+
+/**
+ * 单个项目的摘要
+ */
+struct ContentDigestEntry {
+    std::string path;                           // 相对根目录的路径（根目录为 "."）
+    ItemType type;                              // 项目类型
+    uint64_t size;                              // 文件大小（目录为子树内文件大小之和）
+    uint8_t digest[Blake3Hasher::OUT_LEN];      // 摘要
+};
+
+/**
+ * 内容摘要结果
+ */
+struct ContentDigestResult {
+    uint8_t digest[Blake3Hasher::OUT_LEN];      // 根目录摘要
+    std::vector<ContentDigestEntry> entries;    // 各目录（及文件）的摘要，按路径的先序排列
+    uint64_t file_count;                        // 文件数
+    uint64_t directory_count;                   // 目录数
+    uint64_t symlink_count;                     // 符号链接数
+    uint64_t bytes_hashed;                      // 读取并哈希的字节数
+    uint64_t duration_ms;                       // 耗时（毫秒）
+    uint32_t threads;                           // 实际使用的读取线程数
+    std::vector<std::string> errors;            // 错误（出错的项目在摘要中以失败标记代替）
+
+    ContentDigestResult() : digest{}, file_count(0), directory_count(0), symlink_count(0), bytes_hashed(0),
+                            duration_ms(0), threads(0) {}
+};
+
+/**
+ * 目录树内容摘要（Merkle）
+ *
+ * 摘要定义（与遍历顺序、线程数无关）：
+ *   文件      BLAKE3(文件内容)，与 b3sum 的输出一致
+ *   符号链接  BLAKE3(链接目标)，不跟随
+ *   目录      BLAKE3(按名称字节序排列的子项依次拼接 类型字节 + 名称 + '\0' + 子项摘要)，
+ *             类型字节 'f' 为文件、'd' 为目录、'l' 为符号链接；其他类型的项目不参与摘要
+ *
+ * 调用线程列目录并为每个普通文件生成读取任务，多个读取线程并行处理：以 POSIX_FADV_SEQUENTIAL 打开，
+ * 每次 pread 较大的连续块，读完即以 POSIX_FADV_DONTNEED 丢弃页缓存。大文件按 2 的幂个 BLAKE3 分块
+ * 切成片段分给不同线程，片段的子树链值最后合并，单个大文件也能占满多个线程。
+ * 全部文件完成后自底向上计算各目录的摘要。
+ */
+class ContentDigester {
+public:
+    /**
+     * 计算目录树（或单个文件）的内容摘要
+     * @param path 根路径
+     * @param options 选项
+     * @return 摘要结果
+     */
+    static ContentDigestResult digest(const std::string& path, const ContentDigestOptions& options);
+};
+
+} // namespace filesystem
+} // namespace brisk
+
+#endif // PLATFORM_LINUX
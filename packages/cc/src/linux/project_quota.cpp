@@ -0,0 +1,174 @@
+#include "project_quota.h"
+
+#ifdef PLATFORM_LINUX
+
+#include <sys/ioctl.h>
+#include <sys/quota.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/sysmacros.h>
+#include <linux/fs.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace brisk {
+namespace filesystem {
+
+namespace {
+
+/**
+ * 还原 mountinfo 中八进制转义的字符（空格、制表符、换行与反斜杠）
+ */
+std::string unescapeMountField(const std::string& field) {
+    std::string out;
+    out.reserve(field.size());
+    for (size_t i = 0; i < field.size(); ++i) {
+        if (field[i] == '\\' && i + 3 < field.size() && field[i + 1] >= '0' && field[i + 1] <= '3') {
+            out += static_cast<char>(((field[i + 1] - '0') << 6) | ((field[i + 2] - '0') << 3) | (field[i + 3] - '0'));
+            i += 3;
+        } else {
+            out += field[i];
+        }
+    }
+    return out;
+}
+
+/**
+ * 关闭文件描述符（计入进程级系统调用指标）
+ */
+void closeCounted(int fd) {
+    countProcessSyscall(SyscallType::CLOSE);
+    close(fd);
+}
+
+} // namespace
+
+bool ProjectQuota::eligible(const CalculationOptions& options) {
+    // 配额按 inode 计一次且包含目录自身占用的块，只对应去重硬链接并计入目录大小的遍历
+    if (!options.inode_check || !options.include_directory_size) {
+        return false;
+    }
+    // 配额按 inode 统计整棵树，无法排除隐藏文件、忽略模式、深度限制与符号链接
+    if (!options.include_hidden || !options.ignore_patterns.empty() || options.max_depth != UINT32_MAX ||
+        !options.include_link || options.follow_symlinks) {
+        return false;
+    }
+    // 需要逐个目录或系统调用数据的功能仍需遍历
+    return !options.detect_duplicates && !options.aggregate_packages && options.slow_directory_limit == 0 &&
+           !options.latency_histograms && !options.shape_profile;
+}
+
+bool ProjectQuota::query(const std::string& path, ProjectQuotaUsage& usage) {
+    countProcessSyscall(SyscallType::OPEN);
+    int fd = open(path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd == -1) {
+        return false;
+    }
+
+    uint32_t project_id = 0;
+    bool inherit = false;
+    struct stat st;
+    countProcessSyscall(SyscallType::STAT);
+    if (fstat(fd, &st) != 0 || !projectOf(fd, project_id, inherit) || project_id == 0 || !inherit) {
+        closeCounted(fd);
+        return false;
+    }
+
+    // 父目录属于同一项目时，根目录只是项目中的子目录，配额用量会包含其他目录
+    countProcessSyscall(SyscallType::OPEN);
+    int parent_fd = openat(fd, "..", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (parent_fd != -1) {
+        uint32_t parent_project = 0;
+        bool parent_inherit = false;
+        struct stat parent_st;
+        countProcessSyscall(SyscallType::STAT);
+        bool same_project = fstat(parent_fd, &parent_st) == 0 && parent_st.st_dev == st.st_dev &&
+                            projectOf(parent_fd, parent_project, parent_inherit) && parent_project == project_id;
+        closeCounted(parent_fd);
+        if (same_project) {
+            closeCounted(fd);
+            return false;
+        }
+    }
+
+    struct dqblk quota;
+    std::memset(&quota, 0, sizeof(quota));
+    int status = -1;
+    bool need_device = true;
+    int command = QCMD(Q_GETQUOTA, PRJQUOTA);
+
+#ifdef SYS_quotactl_fd
+    // Linux 5.14 起可直接按已打开的目录查询，无需查找块设备；内核不支持时再按块设备查询
+    status = static_cast<int>(syscall(SYS_quotactl_fd, fd, command, project_id, &quota));
+    need_device = status == -1 && errno == ENOSYS;
+#endif
+    closeCounted(fd);
+
+    if (need_device) {
+        std::string device = mountSource(st.st_dev);
+        if (device.empty()) {
+            return false;
+        }
+        status = quotactl(command, device.c_str(), static_cast<int>(project_id), reinterpret_cast<caddr_t>(&quota));
+    }
+
+    if (status != 0 || (quota.dqb_valid & QIF_USAGE) != QIF_USAGE) {
+        return false;
+    }
+
+    usage.used = true;
+    usage.project_id = project_id;
+    usage.space_bytes = quota.dqb_curspace;
+    usage.inodes = quota.dqb_curinodes;
+    return true;
+}
+
+bool ProjectQuota::projectOf(int fd, uint32_t& project_id, bool& inherit) {
+    struct fsxattr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    if (ioctl(fd, FS_IOC_FSGETXATTR, &attr) != 0) {
+        return false;
+    }
+    project_id = attr.fsx_projid;
+    inherit = (attr.fsx_xflags & FS_XFLAG_PROJINHERIT) != 0;
+    return true;
+}
+
+std::string ProjectQuota::mountSource(dev_t device) {
+    std::ifstream mountinfo("/proc/self/mountinfo");
+    if (!mountinfo) {
+        return std::string();
+    }
+
+    char expected[32];
+    std::snprintf(expected, sizeof(expected), "%u:%u", major(device), minor(device));
+
+    // 格式：挂载 ID、父 ID、主:次设备号、根、挂载点、选项、可选字段…、"-"、文件系统类型、挂载来源、超级块选项
+    std::string line;
+    while (std::getline(mountinfo, line)) {
+        std::istringstream fields(line);
+        std::string mount_id, parent_id, device_id;
+        if (!(fields >> mount_id >> parent_id >> device_id) || device_id != expected) {
+            continue;
+        }
+
+        std::string field;
+        while (fields >> field && field != "-") {
+        }
+        std::string fs_type, source;
+        if (field == "-" && fields >> fs_type >> source && !source.empty() && source[0] == '/') {
+            return unescapeMountField(source);
+        }
+    }
+    return std::string();
+}
+
+} // namespace filesystem
+} // namespace brisk
+
+#endif // PLATFORM_LINUX
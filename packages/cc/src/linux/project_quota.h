@@ -0,0 +1,63 @@
+#pragma once
+
+#include "../common/filesystem_common.h"
+
+#ifdef PLATFORM_LINUX
+
+#include <sys/types.h>
+#include <string>
+
+namespace brisk {
+namespace filesystem {
+
+/**
+ * 项目配额快速路径
+ *
+ * ext4 / XFS 的项目目录带有项目 ID（FS_XFLAG_PROJINHERIT，子项创建时继承），内核按项目精确统计
+ * 已占用的空间与 inode 数。根目录是某个项目的顶层目录时，用 quotactl(Q_GETQUOTA, PRJQUOTA) 读取用量，
+ * 代替遍历整棵目录树。
+ *
+ * 使用前提：项目 ID 只分配给这一棵目录树（配额按项目统计，不区分目录）；文件系统已启用项目配额记账；
+ * 调用者具有 CAP_SYS_ADMIN（内核只允许普通用户查询自己的用户 / 组配额）。任一条件不满足时返回 false，
+ * 由调用方回退到完整遍历。
+ */
+class ProjectQuota {
+public:
+    /**
+     * 选项是否允许使用配额用量：需开启 inode_check 与 include_directory_size，
+     * 设置了过滤条件或需要逐项统计的功能时不能使用
+     * @param options 配置选项
+     * @return 是否可以使用
+     */
+    static bool eligible(const CalculationOptions& options);
+
+    /**
+     * 读取根目录所属项目的配额用量
+     * @param path 根目录路径
+     * @param usage 输出的用量
+     * @return 根目录是项目的顶层目录且读取成功时为 true
+     */
+    static bool query(const std::string& path, ProjectQuotaUsage& usage);
+
+private:
+    /**
+     * 读取目录的项目 ID
+     * @param fd 目录文件描述符
+     * @param project_id 输出的项目 ID
+     * @param inherit 输出子项是否继承项目 ID
+     * @return 是否成功
+     */
+    static bool projectOf(int fd, uint32_t& project_id, bool& inherit);
+
+    /**
+     * 查找设备号对应的块设备（/proc/self/mountinfo 中的挂载来源）
+     * @param device 设备号
+     * @return 块设备路径，未找到时为空
+     */
+    static std::string mountSource(dev_t device);
+};
+
+} // namespace filesystem
+} // namespace brisk
+
+#endif // PLATFORM_LINUX
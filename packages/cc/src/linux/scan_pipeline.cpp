@@ -0,0 +1,500 @@
+#include "scan_pipeline.h"
+#include "usdt_probes.h"
+
+#ifdef PLATFORM_LINUX
+
+#include <sys/syscall.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+namespace brisk {
+namespace filesystem {
+
+namespace {
+
+/**
+ * 执行受看门狗监视的系统调用并记录延迟
+ * 线程在调用期间被放弃时丢弃返回值并抛出 WorkerAbandoned，此后不再写入任何状态
+ * @param watch 监视状态
+ * @param path 操作的路径
+ * @param latency 延迟直方图（为空时不统计）
+ * @param type 系统调用类型（计入进程级指标）
+ * @param call 系统调用
+ * @param discard 被放弃时对返回值的清理（如关闭文件描述符）
+ * @return 系统调用的返回值
+ */
+template <typename Call, typename Discard>
+auto watchedCall(WatchedWorker& watch, const std::string& path, LatencyHistogram* latency, SyscallType type,
+                 Call call, Discard discard) -> decltype(call()) {
+    countProcessSyscall(type);
+    std::chrono::steady_clock::time_point start;
+    if (latency) {
+        start = std::chrono::steady_clock::now();
+    }
+
+    watch.begin(path);
+    auto value = call();
+    if (!watch.end()) {
+        discard(value);
+        throw WorkerAbandoned();
+    }
+
+    if (latency) {
+        latency->record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count()));
+    }
+    return value;
+}
+
+} // namespace
+
+ScanPipeline::ScanPipeline(LinuxSyscallAccelerator& accelerator, const CalculationOptions& options)
+    : accelerator_(accelerator),
+      options_(options),
+      scan_client_(accelerator.scan_client_),
+      directories_(0),
+      batches_(options.pipeline_queue_depth > 0 ? options.pipeline_queue_depth : DEFAULT_QUEUE_DEPTH),
+      pending_(0),
+      live_workers_(0) {
+}
+
+void ScanPipeline::run(const std::string& root, CalculationResult& result) {
+    // 根路径按递归遍历的口径处理，只有目录才启动流水线
+    bool beyond_depth = options_.max_depth == 0;
+    if (beyond_depth && !options_.include_directory_size) {
+        return;
+    }
+
+    LinuxFileInfo info;
+    bool found;
+    {
+        SyscallTimer timer(LinuxSyscallAccelerator::syscallLatency(options_, result, SyscallType::STAT), SyscallType::STAT);
+        found = accelerator_.getFileInfo(root, options_.follow_symlinks, info);
+    }
+    if (!found) {
+        accelerator_.recordError(result, "Cannot access: " + root);
+        return;
+    }
+
+    if (accelerator_.shouldIgnoreFile(info, options_) || !accelerator_.markInodeProcessed(info, options_)) {
+        return;
+    }
+    SubtreeSummary summary;
+    LinuxSyscallAccelerator::recordItemTimes(info, result, summary);
+    accelerator_.recordShapeEntry(result, root, 0, options_);
+
+    if (!info.is_directory) {
+        if (info.is_symlink) {
+            accelerator_.countSymlink(info, options_, result, summary);
+        } else {
+            result.file_count++;
+            result.total_size += info.size;
+        }
+        return;
+    }
+
+    if (options_.include_directory_size) {
+        result.total_size += info.size;
+    }
+    if (beyond_depth) {
+        return;
+    }
+    result.directory_count++;
+
+    pending_.store(1);
+    directories_.push({root, 0});
+
+    uint32_t lister_count = std::max(options_.pipeline_listers, 1u);
+    uint32_t stat_count = options_.pipeline_stat_workers > 0 ? options_.pipeline_stat_workers
+                                                            : accelerator_.resolveThreadCount(options_);
+
+    for (uint32_t i = 0; i < lister_count + stat_count; ++i) {
+        if (!spawnWorker(i < lister_count, result)) {
+            break;
+        }
+    }
+
+    waitForWorkers(result);
+
+    for (const auto& worker : workers_) {
+        // 被放弃的线程在放弃后不再写入结果，放弃前完成的统计照常合并
+        accelerator_.mergeThreadResult(result, worker->result, options_);
+    }
+
+    for (auto& path : timed_out_) {
+        accelerator_.recordError(result, "Operation timed out: " + path);
+        result.timed_out.push_back(std::move(path));
+    }
+}
+
+bool ScanPipeline::spawnWorker(bool lister, CalculationResult& result) {
+    auto worker = std::make_shared<PipelineWorker>(options_.operation_timeout_ms > 0, lister);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        live_workers_++;
+    }
+
+    try {
+        std::thread([this, worker]() {
+            try {
+                // 先绑定再处理任务，使线程结果与缓冲区按首次访问分配在本地节点
+                accelerator_.placement_.placeCurrentThread();
+                if (worker->lister) {
+                    listerLoop(*worker);
+                } else {
+                    statLoop(*worker);
+                }
+            } catch (const WorkerAbandoned&) {
+                // 已被看门狗放弃，扫描可能已经结束，不能再访问流水线
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            live_workers_--;
+            workers_done_.notify_all();
+        }).detach();
+    } catch (const std::exception& e) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            live_workers_--;
+        }
+        // 无法保证每个阶段都有线程，停止扫描并保留已完成的统计
+        accelerator_.recordError(result, "Thread error: " + std::string(e.what()));
+        directories_.close();
+        batches_.close();
+        return false;
+    }
+
+    workers_.push_back(std::move(worker));
+    return true;
+}
+
+void ScanPipeline::waitForWorkers(CalculationResult& result) {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    if (options_.operation_timeout_ms == 0) {
+        workers_done_.wait(lock, [this]() { return live_workers_ == 0; });
+        return;
+    }
+
+    // 检查间隔取超时时间的四分之一，超时的操作最迟在 1.25 倍超时时间内被发现
+    auto tick = std::chrono::milliseconds(
+        std::min(std::max(options_.operation_timeout_ms / 4, 1u), MAX_WATCHDOG_TICK_MS));
+
+    while (live_workers_ > 0) {
+        workers_done_.wait_for(lock, tick);
+        lock.unlock();
+        expireStuckWorkers(result);
+        lock.lock();
+    }
+}
+
+void ScanPipeline::expireStuckWorkers(CalculationResult& result) {
+    uint64_t now = Utils::getMonotonicMicros();
+    uint64_t timeout = static_cast<uint64_t>(options_.operation_timeout_ms) * 1000;
+
+    // 替换线程会追加到 workers_，只检查本轮开始前已有的线程
+    size_t worker_count = workers_.size();
+    for (size_t i = 0; i < worker_count; ++i) {
+        std::shared_ptr<PipelineWorker> worker = workers_[i];
+        std::string path;
+        if (!worker->watch.expire(now, timeout, path)) {
+            continue;
+        }
+
+        timed_out_.push_back(path);
+
+        // 线程阻塞在任务中，代其归还执行槽位
+        if (scan_client_) {
+            scan_client_->release();
+        }
+
+        // 放弃的列目录线程不再归还缓冲区，代其归还
+        if (worker->buffer_bytes > 0) {
+            accelerator_.memory_.release(MemorySubsystem::BUFFERS, worker->buffer_bytes);
+            worker->buffer_bytes = 0;
+        }
+
+        // 放弃的 stat 线程未处理的目录项重新入队，只跳过阻塞的那一项
+        if (!worker->lister) {
+            const PipelineBatch& stuck = *worker->batch;
+            PipelineBatch rest;
+            rest.directory = stuck.directory;
+            for (size_t j = worker->entry_index + 1; j < stuck.entries.size(); ++j) {
+                rest.memory_bytes += sizeof(PipelineEntry) + MemoryAccounting::stringBytes(stuck.entries[j].name.size());
+                rest.entries.push_back(stuck.entries[j]);
+            }
+            accelerator_.memory_.release(MemorySubsystem::QUEUES, stuck.memory_bytes);
+
+            if (!rest.entries.empty()) {
+                accelerator_.memory_.allocate(MemorySubsystem::QUEUES, rest.memory_bytes);
+                pending_.fetch_add(1);
+                // 调用线程不能阻塞在有界队列上，忽略容量放入
+                if (!batches_.forcePush(std::move(rest))) {
+                    finishWork();
+                }
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            live_workers_--;
+        }
+
+        if (spawnWorker(worker->lister, result)) {
+            // 放弃的目录或批次视为完成，接替线程继续处理队列中的其余工作
+            finishWork();
+        }
+    }
+}
+
+void ScanPipeline::listerLoop(PipelineWorker& worker) {
+    PipelineTask task;
+    while (directories_.pop(task)) {
+        accelerator_.memory_.release(MemorySubsystem::QUEUES,
+                                     sizeof(PipelineTask) + MemoryAccounting::stringBytes(task.path.size()));
+        GET_FOLDER_PROBE3(task_take, 0, task.path.c_str(), 0);
+        // 被放弃时由看门狗归还槽位，因此不使用 RAII
+        if (scan_client_) {
+            scan_client_->acquire();
+        }
+        try {
+            listDirectory(task, worker);
+        } catch (const std::exception& e) {
+            accelerator_.recordError(worker.result, "Thread error: " + std::string(e.what()));
+        }
+        if (worker.buffer_bytes > 0) {
+            accelerator_.memory_.release(MemorySubsystem::BUFFERS, worker.buffer_bytes);
+            worker.buffer_bytes = 0;
+        }
+        if (scan_client_) {
+            scan_client_->release();
+        }
+        finishWork();
+    }
+}
+
+void ScanPipeline::statLoop(PipelineWorker& worker) {
+    PipelineBatch batch;
+    while (batches_.pop(batch)) {
+        worker.batch = std::make_shared<PipelineBatch>(std::move(batch));
+        GET_FOLDER_PROBE3(task_take, 1, worker.batch->directory->path.c_str(), worker.batch->entries.size());
+        if (scan_client_) {
+            scan_client_->acquire();
+        }
+        try {
+            statBatch(*worker.batch, worker);
+        } catch (const std::exception& e) {
+            accelerator_.recordError(worker.result, "Thread error: " + std::string(e.what()));
+        }
+        if (scan_client_) {
+            scan_client_->release();
+        }
+        accelerator_.memory_.release(MemorySubsystem::QUEUES, worker.batch->memory_bytes);
+        // 释放目录引用，最后一个批次处理完时关闭目录
+        worker.batch.reset();
+        batch = PipelineBatch();
+        finishWork();
+    }
+}
+
+void ScanPipeline::listDirectory(const PipelineTask& task, PipelineWorker& worker) {
+    CalculationResult& result = worker.result;
+    GET_FOLDER_PROBE2(dir_enter, task.path.c_str(), task.depth);
+
+    int dir_fd = watchedCall(worker.watch, task.path,
+                             LinuxSyscallAccelerator::syscallLatency(options_, result, SyscallType::OPEN),
+                             SyscallType::OPEN,
+                             [&]() { return openDirectory(task.path); },
+                             [](int fd) { if (fd != -1) close(fd); });
+    if (dir_fd == -1) {
+        accelerator_.recordError(result, "Cannot open directory: " + task.path);
+        return;
+    }
+
+    auto directory = std::make_shared<PipelineDirectory>(dir_fd, task.path, task.depth);
+    LatencyHistogram* getdents_latency = LinuxSyscallAccelerator::syscallLatency(options_, result,
+                                                                                 SyscallType::GETDENTS);
+
+    // 线程可能在读取中途被放弃，不使用析构时访问加速器的 ScopedMemory，由 listerLoop 或看门狗归还
+    std::vector<char> buffer(LIST_BUFFER_SIZE);
+    accelerator_.memory_.allocate(MemorySubsystem::BUFFERS, LIST_BUFFER_SIZE);
+    worker.buffer_bytes = LIST_BUFFER_SIZE;
+
+    PipelineBatch batch;
+    batch.directory = directory;
+    uint64_t listed = 0;
+    bool complete = true;
+
+    while (true) {
+        ssize_t bytes_read = watchedCall(worker.watch, task.path, getdents_latency, SyscallType::GETDENTS,
+                                         [&]() { return readEntries(dir_fd, buffer.data(), buffer.size()); },
+                                         [](long) {});
+
+        if (bytes_read == -1) {
+            accelerator_.recordError(result, "Cannot list directory: " + task.path);
+            complete = false;
+            break;
+        }
+
+        if (bytes_read == 0) {
+            break;  // 目录结束
+        }
+
+        size_t offset = 0;
+        while (offset < static_cast<size_t>(bytes_read)) {
+            struct linux_dirent64 {
+                ino_t d_ino;
+                off_t d_off;
+                unsigned short d_reclen;
+                unsigned char d_type;
+                char d_name[];
+            };
+
+            auto* entry = reinterpret_cast<linux_dirent64*>(buffer.data() + offset);
+            offset += entry->d_reclen;
+
+            // 跳过 . 和 ..
+            if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+                continue;
+            }
+
+            batch.entries.push_back({entry->d_name, entry->d_type});
+            listed++;
+            batch.memory_bytes += sizeof(PipelineEntry) + MemoryAccounting::stringBytes(batch.entries.back().name.size());
+
+            if (batch.entries.size() >= BATCH_ENTRIES) {
+                enqueueBatch(std::move(batch));
+                batch = PipelineBatch();
+                batch.directory = directory;
+            }
+        }
+    }
+
+    if (!batch.entries.empty()) {
+        enqueueBatch(std::move(batch));
+    }
+    if (complete) {
+        accelerator_.recordShapeDirectory(result, task.path, listed, options_);
+    }
+    GET_FOLDER_PROBE4(dir_exit, task.path.c_str(), task.depth, listed, 0);
+}
+
+void ScanPipeline::statBatch(const PipelineBatch& batch, PipelineWorker& worker) {
+    CalculationResult& result = worker.result;
+    const PipelineDirectory& directory = *batch.directory;
+    uint32_t child_depth = directory.depth + 1;
+    bool child_beyond_depth = child_depth >= options_.max_depth;
+    int stat_flags = options_.follow_symlinks ? 0 : AT_SYMLINK_NOFOLLOW;
+
+    // 目录既不参与去重也不计入自身大小时，d_type 已足够判断，无需 stat
+    bool need_directory_stat = options_.inode_check || options_.include_directory_size || options_.follow_symlinks;
+
+    LatencyHistogram* stat_latency = LinuxSyscallAccelerator::syscallLatency(options_, result, SyscallType::STAT);
+    uint64_t stat_calls = 0;
+
+    for (size_t i = 0; i < batch.entries.size(); ++i) {
+        const PipelineEntry& entry = batch.entries[i];
+        if (!options_.include_hidden && Utils::isHiddenFile(entry.name)) {
+            continue;
+        }
+
+        std::string full_path = directory.path + "/" + entry.name;
+        if (accelerator_.ignore_patterns_.matches(full_path)) {
+            continue;
+        }
+
+        if (entry.type == DT_DIR && (!need_directory_stat || (child_beyond_depth && !options_.include_directory_size))) {
+            if (!child_beyond_depth) {
+                result.directory_count++;
+                accelerator_.recordShapeEntry(result, full_path, child_depth, options_);
+                enqueueDirectory(std::move(full_path), child_depth);
+            }
+            continue;
+        }
+
+        // 相对已打开的目录 stat，省去逐级路径解析
+        struct stat st;
+        worker.entry_index = i;
+        stat_calls++;
+        int status = watchedCall(worker.watch, full_path, stat_latency, SyscallType::STAT,
+                                 [&]() { return statEntry(directory.fd, entry.name, st, stat_flags); },
+                                 [](int) {});
+        if (status != 0) {
+            accelerator_.recordError(result, "Cannot access: " + full_path);
+            continue;
+        }
+
+        LinuxFileInfo info;
+        LinuxSyscallAccelerator::fillFileInfo(st, info);
+        if (!accelerator_.markInodeProcessed(info, options_)) {
+            continue;
+        }
+        SubtreeSummary summary;
+        LinuxSyscallAccelerator::recordItemTimes(info, result, summary);
+        accelerator_.recordShapeEntry(result, full_path, child_depth, options_);
+
+        if (info.is_directory) {
+            if (options_.include_directory_size) {
+                result.total_size += info.size;
+            }
+            if (!child_beyond_depth) {
+                result.directory_count++;
+                enqueueDirectory(std::move(full_path), child_depth);
+            }
+        } else if (info.is_symlink) {
+            accelerator_.countSymlink(info, options_, result, summary);
+        } else {
+            result.file_count++;
+            result.total_size += info.size;
+        }
+    }
+    GET_FOLDER_PROBE3(stat_batch, directory.path.c_str(), batch.entries.size(), stat_calls);
+}
+
+int ScanPipeline::openDirectory(const std::string& path) {
+    return open(path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+}
+
+long ScanPipeline::readEntries(int fd, char* buffer, size_t size) {
+    return syscall(SYS_getdents64, fd, buffer, size);
+}
+
+int ScanPipeline::statEntry(int dir_fd, const std::string& name, struct stat& st, int flags) {
+    return fstatat(dir_fd, name.c_str(), &st, flags);
+}
+
+void ScanPipeline::enqueueDirectory(std::string path, uint32_t depth) {
+    accelerator_.memory_.allocate(MemorySubsystem::QUEUES,
+                                  sizeof(PipelineTask) + MemoryAccounting::stringBytes(path.size()));
+    pending_.fetch_add(1);
+    directories_.push({std::move(path), depth});
+}
+
+void ScanPipeline::enqueueBatch(PipelineBatch batch) {
+    accelerator_.memory_.allocate(MemorySubsystem::QUEUES, batch.memory_bytes);
+    pending_.fetch_add(1);
+    if (batches_.tryPush(batch)) {
+        return;
+    }
+
+    // 批次队列满时阻塞等待 stat 线程跟上，等待期间归还槽位，避免 stat 线程拿不到槽位而死锁
+    ScanSlotRelease idle(scan_client_);
+    batches_.push(std::move(batch));
+}
+
+void ScanPipeline::finishWork() {
+    // 新的目录与批次总是在当前任务完成前登记，计数归零即没有剩余工作
+    if (pending_.fetch_sub(1) == 1) {
+        directories_.close();
+        batches_.close();
+    }
+}
+
+} // namespace filesystem
+} // namespace brisk
+
+#endif // PLATFORM_LINUX
@@ -0,0 +1,234 @@
+#pragma once
+
+#include "syscall_accelerator.h"
+#include "../common/bounded_queue.h"
+#include "../common/operation_watchdog.h"
+
+#ifdef PLATFORM_LINUX
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace brisk {
+namespace filesystem {
+
+/**
+ * 已打开的目录（最后一个引用它的批次处理完后关闭）
+ */
+struct PipelineDirectory {
+    int fd;                       // 目录文件描述符
+    std::string path;             // 目录路径
+    uint32_t depth;               // 目录深度
+
+    PipelineDirectory(int fd, std::string path, uint32_t depth) : fd(fd), path(std::move(path)), depth(depth) {}
+    ~PipelineDirectory() {
+        if (fd != -1) {
+            countProcessSyscall(SyscallType::CLOSE);
+            close(fd);
+        }
+    }
+};
+
+/**
+ * 目录项（getdents64 返回的名称与类型）
+ */
+struct PipelineEntry {
+    std::string name;             // 名称
+    unsigned char type;           // d_type（DT_UNKNOWN 时需 stat 判断）
+};
+
+/**
+ * 目录项批次（列目录阶段产出，stat 阶段消费）
+ */
+struct PipelineBatch {
+    std::shared_ptr<PipelineDirectory> directory; // 所属目录
+    std::vector<PipelineEntry> entries;           // 目录项
+    uint64_t memory_bytes;                        // 批次占用的估算字节数
+
+    PipelineBatch() : memory_bytes(0) {}
+};
+
+/**
+ * 待列出的目录
+ */
+struct PipelineTask {
+    std::string path;             // 目录路径
+    uint32_t depth;               // 目录深度
+};
+
+/**
+ * 流水线工作线程
+ */
+struct PipelineWorker {
+    WatchedWorker watch;                        // 看门狗监视状态
+    bool lister;                                // 是否为列目录线程（否则为 stat 线程）
+    CalculationResult result;                   // 线程结果
+    std::shared_ptr<PipelineBatch> batch;       // 正在处理的批次（stat 线程）
+    size_t entry_index;                         // 正在 stat 的目录项下标
+    uint64_t buffer_bytes;                      // 计入内存统计的列目录缓冲区字节数（线程被放弃时由看门狗归还）
+
+    PipelineWorker(bool watching, bool lister) : watch(watching), lister(lister), entry_index(0), buffer_bytes(0) {}
+};
+
+/**
+ * 工作线程已被看门狗放弃（不继承 std::exception，避免被任务级的错误处理捕获）
+ */
+struct WorkerAbandoned {};
+
+/**
+ * 流水线扫描
+ *
+ * 列目录线程从目录队列取出目录，用 getdents64 读出 (目录 fd, 名称, d_type) 批次放入有界批次队列；
+ * stat 线程消费批次，对目录项执行 fstatat 并统计，发现的子目录放回目录队列。
+ * 两个阶段的线程数分别可调，批次队列满时列目录线程阻塞形成背压；
+ * 目录队列不设上限（按 QUEUES 计入内存），保证 stat 线程永不阻塞，从而不会相互等待死锁。
+ * 仅统计汇总数据，不支持需要按目录自底向上汇总的相同子树检测、包统计与慢目录统计。
+ *
+ * 设置操作超时后，调用线程兼作看门狗：open/getdents64/fstatat 超时的线程被放弃（系统调用无法中断，
+ * 线程返回后直接退出），其路径记为超时，未处理的目录项重新入队，并启动新线程接替。
+ * 工作线程均为分离线程，被放弃的线程只持有自身的 PipelineWorker，扫描结束后仍可安全返回。
+ *
+ * 每个目录或批次在共享调度器的执行槽位内处理，空闲等待队列时不占用槽位；
+ * 被放弃线程的槽位由看门狗代为归还。
+ */
+class ScanPipeline {
+private:
+    LinuxSyscallAccelerator& accelerator_;        // 所属加速器（去重集合、忽略模式、内存统计）
+    const CalculationOptions& options_;           // 配置选项
+    ScanClient* scan_client_;                     // 调度客户端（工作线程按任务获取执行槽位）
+    BoundedQueue<PipelineTask> directories_;      // 待列出的目录（不限容量）
+    BoundedQueue<PipelineBatch> batches_;         // 目录项批次（有界）
+    std::atomic<uint64_t> pending_;               // 未完成的目录与批次数量，归零时扫描结束
+    std::vector<std::shared_ptr<PipelineWorker>> workers_; // 所有工作线程（仅调用线程访问）
+    std::vector<std::string> timed_out_;          // 超时而放弃的路径（仅调用线程访问）
+    uint32_t live_workers_;                       // 仍在工作的线程数
+    std::mutex mutex_;                            // 工作线程计数的互斥锁
+    std::condition_variable workers_done_;        // 工作线程退出通知
+
+    static constexpr size_t BATCH_ENTRIES = 128;        // 每个批次的目录项数量
+    static constexpr uint32_t DEFAULT_QUEUE_DEPTH = 64; // 默认批次队列容量
+    static constexpr size_t LIST_BUFFER_SIZE = 32768;   // getdents64 缓冲区大小
+    static constexpr uint32_t MAX_WATCHDOG_TICK_MS = 100; // 看门狗最长检查间隔
+
+public:
+    /**
+     * 构造函数
+     * @param accelerator 所属加速器
+     * @param options 配置选项
+     */
+    ScanPipeline(LinuxSyscallAccelerator& accelerator, const CalculationOptions& options);
+
+    virtual ~ScanPipeline() = default;
+
+    /**
+     * 从根目录开始扫描，直到所有目录与批次处理完毕
+     * @param root 根目录路径
+     * @param result 计算结果（合并各线程结果）
+     */
+    void run(const std::string& root, CalculationResult& result);
+
+protected:
+    /*
+     * 受看门狗监视的系统调用。测试可重写为阻塞的桩函数以模拟挂起的挂载点；
+     * 重写的函数在调用期间可能被放弃，扫描随即结束，返回前不得访问流水线的成员
+     */
+
+    /**
+     * 打开目录
+     * @param path 目录路径
+     * @return 文件描述符，失败时为 -1
+     */
+    virtual int openDirectory(const std::string& path);
+
+    /**
+     * 读取目录项（getdents64）
+     * @param fd 目录文件描述符
+     * @param buffer 缓冲区
+     * @param size 缓冲区大小
+     * @return 读取的字节数，目录结束时为 0，失败时为 -1
+     */
+    virtual long readEntries(int fd, char* buffer, size_t size);
+
+    /**
+     * 相对已打开的目录 stat 目录项
+     * @param dir_fd 目录文件描述符
+     * @param name 目录项名称
+     * @param st 输出的文件信息
+     * @param flags fstatat 标志
+     * @return 0 为成功，失败时为 -1
+     */
+    virtual int statEntry(int dir_fd, const std::string& name, struct stat& st, int flags);
+
+private:
+    /**
+     * 启动工作线程
+     * @param lister 是否为列目录线程
+     * @param result 计算结果（启动失败时记录错误）
+     * @return 是否成功
+     */
+    bool spawnWorker(bool lister, CalculationResult& result);
+
+    /**
+     * 等待所有工作线程退出，设置超时时定期检查超时的操作
+     * @param result 计算结果
+     */
+    void waitForWorkers(CalculationResult& result);
+
+    /**
+     * 检查并放弃超时的工作线程
+     * @param result 计算结果
+     */
+    void expireStuckWorkers(CalculationResult& result);
+
+    /**
+     * 列目录线程主循环
+     * @param worker 工作线程
+     */
+    void listerLoop(PipelineWorker& worker);
+
+    /**
+     * stat 线程主循环
+     * @param worker 工作线程
+     */
+    void statLoop(PipelineWorker& worker);
+
+    /**
+     * 列出单个目录并将目录项按批次放入批次队列
+     * @param task 目录
+     * @param worker 工作线程
+     */
+    void listDirectory(const PipelineTask& task, PipelineWorker& worker);
+
+    /**
+     * 统计批次中的目录项
+     * @param batch 批次
+     * @param worker 工作线程
+     */
+    void statBatch(const PipelineBatch& batch, PipelineWorker& worker);
+
+    /**
+     * 将子目录放入目录队列
+     * @param path 目录路径
+     * @param depth 目录深度
+     */
+    void enqueueDirectory(std::string path, uint32_t depth);
+
+    /**
+     * 将批次放入批次队列
+     * @param batch 批次
+     */
+    void enqueueBatch(PipelineBatch batch);
+
+    /**
+     * 完成一个目录或批次，全部完成时关闭两个队列
+     */
+    void finishWork();
+};
+
+} // namespace filesystem
+} // namespace brisk
+
+#endif // PLATFORM_LINUX
@@ -1,9 +1,13 @@
 #include "syscall_accelerator.h"
+#include "scan_pipeline.h"
+#include "project_quota.h"
+#include "usdt_probes.h"
 
 #ifdef PLATFORM_LINUX
 
 #include <sys/syscall.h>
 #include <algorithm>
+#include <cstring>
 #include <future>
 #include <atomic>
 
@@ -31,22 +35,69 @@ CalculationResult LinuxSyscallAccelerator::calculateFolderSize(
             return result;
         }
         
-        // 清理已处理的 inode 集合
-        {
-            std::lock_guard<std::mutex> lock(inode_mutex_);
-            processed_inodes_.clear();
+        // 操作超时只由流水线的看门狗实现，流水线不支持的功能与超时不能同时使用，否则扫描可能无限阻塞
+        if (options.operation_timeout_ms > 0 && !usePipeline(options)) {
+            result.errors.push_back("operationTimeoutMs cannot be combined with detectDuplicates, aggregatePackages "
+                                    "or slowDirectoryLimit");
+            return result;
+        }
+        
+        // 项目配额快速路径：内核已按项目统计用量，一次查询代替遍历
+        // totalSize 取按块计算的占用空间，各项数量与最新时间保持为 0（配额不提供，见 README）
+        if (options.project_quota && ProjectQuota::eligible(options) && ProjectQuota::query(path, result.quota)) {
+            result.total_size = result.quota.space_bytes;
+            result.duration_ms = Utils::getCurrentTimestamp() - start_time;
+            return result;
         }
         
-        // 递归计算目录大小
-        calculateDirectorySizeRecursive(path, options, result, 0);
+        beginScan(options);
+        ActiveMemoryScope active(memory_);
+        duplicate_collector_.clear();
+        GET_FOLDER_PROBE2(scan_start, path.c_str(), usePipeline(options));
+        
+        // 与其他并发扫描共享执行槽位
+        ScanClient client(options.priority, ScanScheduler::instance());
+        scan_client_ = &client;
+        
+        if (usePipeline(options)) {
+            // 列目录与 stat 分阶段并行（工作线程按任务获取槽位）
+            createPipeline(options)->run(path, result);
+        } else {
+            // 递归计算目录大小
+            ScanSlot slot(scan_client_);
+            calculateDirectorySizeRecursive(path, options, result, 0);
+        }
+        
+        SlowDirectoryHeap::finalize(result.slow_directories);
+        result.shape.finalize();
+        
+        // 包统计按大小降序排列
+        std::sort(result.packages.begin(), result.packages.end(),
+                  [](const PackageInfo& a, const PackageInfo& b) { return a.size > b.size; });
+        
+        // 汇总相同子树
+        if (options.detect_duplicates) {
+            result.duplicate_groups = duplicate_collector_.buildGroups();
+            for (const auto& group : result.duplicate_groups) {
+                result.redundant_size += group.redundant_size;
+            }
+        }
         
     } catch (const FilesystemException& e) {
         result.errors.push_back(std::string(e.what()));
     } catch (const std::exception& e) {
         result.errors.push_back("Unexpected error: " + std::string(e.what()));
     }
+    scan_client_ = nullptr;
+    
+    result.memory = memory_.snapshot();
+    if (result.memory.degraded) {
+        result.errors.push_back("Memory limit exceeded, switched to aggregate-only mode");
+    }
     
     result.duration_ms = Utils::getCurrentTimestamp() - start_time;
+    GET_FOLDER_PROBE5(scan_end, path.c_str(), result.total_size, result.file_count, result.directory_count,
+                      result.duration_ms);
     return result;
 }
 
@@ -58,15 +109,38 @@ std::shared_ptr<TreeNode> LinuxSyscallAccelerator::buildDirectoryTree(
         throw FilesystemException("Path not found: " + path, ErrorType::PATH_NOT_FOUND);
     }
     
-    // 清理已处理的 inode 集合
-    {
-        std::lock_guard<std::mutex> lock(inode_mutex_);
-        processed_inodes_.clear();
-    }
+    beginScan(options);
+    ActiveMemoryScope active(memory_);
     
     return buildDirectoryTreeRecursive(path, options, 0);
 }
 
+void LinuxSyscallAccelerator::exportDirectoryTree(
+    const std::string& path,
+    const CalculationOptions& options,
+    TreeSink& sink) {
+    
+    if (!pathExists(path)) {
+        throw FilesystemException("Path not found: " + path, ErrorType::PATH_NOT_FOUND);
+    }
+    
+    beginScan(options);
+    ActiveMemoryScope active(memory_);
+    ScopedMemory writer_memory(memory_, MemorySubsystem::BUFFERS, sink.bufferBytes());
+    
+    // 与其他并发扫描共享执行槽位
+    ScanClient client(options.priority, ScanScheduler::instance());
+    scan_client_ = &client;
+    try {
+        ScanSlot slot(scan_client_);
+        exportDirectoryTreeRecursive(path, options, sink, 0);
+    } catch (...) {
+        scan_client_ = nullptr;
+        throw;
+    }
+    scan_client_ = nullptr;
+}
+
 bool LinuxSyscallAccelerator::pathExists(const std::string& path) {
     struct stat st;
     return stat(path.c_str(), &st) == 0;
@@ -99,24 +173,36 @@ bool LinuxSyscallAccelerator::getFileInfo(const std::string& path, bool follow_s
     
     info.path = path;
     info.name = path.substr(path.find_last_of('/') + 1);
+    fillFileInfo(st, info);
+    
+    return true;
+}
+
+void LinuxSyscallAccelerator::fillFileInfo(const struct stat& st, LinuxFileInfo& info) {
+    info.device = st.st_dev;
     info.inode = st.st_ino;
     info.mode = st.st_mode;
     info.size = st.st_size;
     info.atime = st.st_atime;
     info.mtime = st.st_mtime;
     info.ctime = st.st_ctime;
+    info.uid = st.st_uid;
     info.is_directory = S_ISDIR(st.st_mode);
     info.is_symlink = S_ISLNK(st.st_mode);
-    
-    return true;
 }
 
-bool LinuxSyscallAccelerator::listDirectoryFast(int dir_fd, std::vector<std::string>& entries) {
+bool LinuxSyscallAccelerator::listDirectoryFast(int dir_fd, std::vector<std::string>& entries,
+                                                LatencyHistogram* getdents_latency) {
     const size_t BUFFER_SIZE = 4096;
     char buffer[BUFFER_SIZE];
+    ScopedMemory buffer_memory(memory_, MemorySubsystem::BUFFERS, BUFFER_SIZE);
     
     while (true) {
-        ssize_t bytes_read = syscall(SYS_getdents64, dir_fd, buffer, BUFFER_SIZE);
+        ssize_t bytes_read;
+        {
+            SyscallTimer timer(getdents_latency, SyscallType::GETDENTS);
+            bytes_read = syscall(SYS_getdents64, dir_fd, buffer, BUFFER_SIZE);
+        }
         
         if (bytes_read == -1) {
             return false;
@@ -151,84 +237,149 @@ bool LinuxSyscallAccelerator::listDirectoryFast(int dir_fd, std::vector<std::str
     return true;
 }
 
-void LinuxSyscallAccelerator::calculateDirectorySizeRecursive(
+SubtreeSummary LinuxSyscallAccelerator::calculateDirectorySizeRecursive(
     const std::string& path,
     const CalculationOptions& options,
     CalculationResult& result,
     uint32_t current_depth) {
     
-    if (current_depth >= options.max_depth) {
-        return;
+    SubtreeSummary summary;
+    
+    // 超出深度的目录不再读取；统计目录自身大小时仍需计入该目录本身
+    bool beyond_depth = current_depth >= options.max_depth;
+    if (beyond_depth && !options.include_directory_size) {
+        return summary;
     }
     
     LinuxFileInfo info;
-    if (!getFileInfo(path, options.follow_symlinks, info)) {
-        result.errors.push_back("Cannot access: " + path);
-        return;
+    bool found;
+    {
+        SyscallTimer timer(syscallLatency(options, result, SyscallType::STAT), SyscallType::STAT);
+        found = getFileInfo(path, options.follow_symlinks, info);
+    }
+    if (!found) {
+        recordError(result, "Cannot access: " + path);
+        return summary;
     }
     
     // 检查是否应该忽略
     if (shouldIgnoreFile(info, options)) {
-        return;
+        return summary;
     }
     
     // 检查 inode 是否已处理（避免硬链接重复计算）
-    {
-        std::lock_guard<std::mutex> lock(inode_mutex_);
-        if (processed_inodes_.count(info.inode)) {
-            return;
+    if (!markInodeProcessed(info, options)) {
+        return summary;
+    }
+    
+    summary.counted = true;
+    summary.present = true;
+    recordItemTimes(info, result, summary);
+    recordShapeEntry(result, path, current_depth, options);
+    
+    if (info.is_directory && options.include_directory_size) {
+        result.total_size += info.size;
+        summary.total_size += info.size;
+        summary.structure_size += info.size;
+        
+        if (beyond_depth) {
+            return summary;
         }
-        processed_inodes_.insert(info.inode);
     }
     
     if (info.is_directory) {
         result.directory_count++;
+        GET_FOLDER_PROBE2(dir_enter, path.c_str(), current_depth);
+        
+        // 调度点：有服务量更少的扫描在等待时让出槽位
+        if (scan_client_) {
+            scan_client_->checkpoint();
+        }
+        
+        // 慢目录统计：分别记录列目录与 stat 阶段耗时（不含子目录递归）
+        bool track_slow = options.slow_directory_limit > 0;
+        uint64_t list_start = track_slow ? Utils::getMonotonicMicros() : 0;
+        uint64_t stat_us = 0;
+        
+        LatencyHistogram* stat_latency = syscallLatency(options, result, SyscallType::STAT);
+        
+        auto stat_entry = [&](const std::string& full_path, LinuxFileInfo& entry_info) {
+            uint64_t stat_start = track_slow ? Utils::getMonotonicMicros() : 0;
+            bool entry_found;
+            {
+                SyscallTimer timer(stat_latency, SyscallType::STAT);
+                entry_found = getFileInfo(full_path, options.follow_symlinks, entry_info);
+            }
+            if (track_slow) {
+                stat_us += Utils::getMonotonicMicros() - stat_start;
+            }
+            // 列出后消失或无权访问的子项同样记录错误（与流水线模式一致）
+            if (!entry_found) {
+                recordError(result, "Cannot access: " + full_path);
+            }
+            return entry_found;
+        };
         
         // 打开目录
-        int dir_fd = open(path.c_str(), O_RDONLY);
+        int dir_fd;
+        {
+            SyscallTimer timer(syscallLatency(options, result, SyscallType::OPEN), SyscallType::OPEN);
+            dir_fd = open(path.c_str(), O_RDONLY);
+        }
         if (dir_fd == -1) {
-            result.errors.push_back("Cannot open directory: " + path);
-            return;
+            recordError(result, "Cannot open directory: " + path);
+            return summary;
         }
         
+        // 子项结构哈希累加（与子项顺序无关）
+        FingerprintAccumulator structure;
+        
         std::vector<std::string> entries;
-        if (listDirectoryFast(dir_fd, entries)) {
+        bool listed = listDirectoryFast(dir_fd, entries, syscallLatency(options, result, SyscallType::GETDENTS));
+        
+        // 目录项列表在处理本目录期间常驻
+        ScopedMemory entries_memory(memory_, MemorySubsystem::BUFFERS, 0);
+        for (const auto& entry : entries) {
+            entries_memory.grow(MemoryAccounting::stringBytes(entry.size()));
+        }
+        uint64_t list_us = track_slow ? Utils::getMonotonicMicros() - list_start : 0;
+        
+        if (listed) {
+            recordShapeDirectory(result, path, entries.size(), options);
+            
             // 并行处理子目录
-            if (options.max_threads > 1 && entries.size() > 10) {
+            if (resolveThreadCount(options) > 1 && entries.size() > 10) {
                 std::vector<std::string> sub_dirs;
-                std::vector<std::string> files;
+                std::vector<std::string> sub_dir_names;
                 
-                // 分离目录和文件
+                // 分离目录和文件，文件直接统计
                 for (const auto& entry : entries) {
                     std::string full_path = path + "/" + entry;
                     LinuxFileInfo entry_info;
                     
-                    if (getFileInfo(full_path, options.follow_symlinks, entry_info)) {
+                    if (stat_entry(full_path, entry_info)) {
                         if (entry_info.is_directory) {
                             sub_dirs.push_back(full_path);
+                            sub_dir_names.push_back(entry);
                         } else {
-                            files.push_back(full_path);
+                            accumulateChild(summary, structure, entry, ItemType::FILE,
+                                            processFileEntry(entry_info, options, result, current_depth + 1));
                         }
                     }
                 }
                 
-                // 处理文件
-                for (const auto& file_path : files) {
-                    LinuxFileInfo file_info;
-                    if (getFileInfo(file_path, options.follow_symlinks, file_info)) {
-                        if (!shouldIgnoreFile(file_info, options)) {
-                            std::lock_guard<std::mutex> lock(inode_mutex_);
-                            if (!processed_inodes_.count(file_info.inode)) {
-                                processed_inodes_.insert(file_info.inode);
-                                result.file_count++;
-                                result.total_size += file_info.size;
-                            }
-                        }
-                    }
+                // 待并行处理的子目录队列
+                ScopedMemory queue_memory(memory_, MemorySubsystem::QUEUES, 0);
+                for (const auto& sub_dir : sub_dirs) {
+                    queue_memory.grow(MemoryAccounting::stringBytes(sub_dir.size()) + sizeof(SubtreeSummary));
                 }
                 
                 // 并行处理子目录
-                processDirectoriesParallel(sub_dirs, options, result, current_depth + 1);
+                std::vector<SubtreeSummary> sub_summaries =
+                    processDirectoriesParallel(sub_dirs, options, result, current_depth + 1);
+                for (size_t i = 0; i < sub_summaries.size(); ++i) {
+                    accumulateChild(summary, structure, sub_dir_names[i], ItemType::DIRECTORY, sub_summaries[i]);
+                }
                 
             } else {
                 // 串行处理
@@ -236,33 +387,228 @@ void LinuxSyscallAccelerator::calculateDirectorySizeRecursive(
                     std::string full_path = path + "/" + entry;
                     LinuxFileInfo entry_info;
                     
-                    if (getFileInfo(full_path, options.follow_symlinks, entry_info)) {
+                    if (stat_entry(full_path, entry_info)) {
                         if (entry_info.is_directory) {
-                            calculateDirectorySizeRecursive(full_path, options, result, current_depth + 1);
-                        } else if (!shouldIgnoreFile(entry_info, options)) {
-                            std::lock_guard<std::mutex> lock(inode_mutex_);
-                            if (!processed_inodes_.count(entry_info.inode)) {
-                                processed_inodes_.insert(entry_info.inode);
-                                result.file_count++;
-                                result.total_size += entry_info.size;
-                            }
+                            accumulateChild(summary, structure, entry, ItemType::DIRECTORY,
+                                            calculateDirectorySizeRecursive(full_path, options, result, current_depth + 1));
+                        } else {
+                            accumulateChild(summary, structure, entry, ItemType::FILE,
+                                            processFileEntry(entry_info, options, result, current_depth + 1));
                         }
                     }
                 }
             }
         } else {
-            result.errors.push_back("Cannot list directory: " + path);
+            recordError(result, "Cannot list directory: " + path);
         }
         
-        close(dir_fd);
+        // 识别 node_modules 下的包边界，复用已打开的目录读取 package.json
+        bool is_package = options.aggregate_packages && !memory_.degraded() &&
+                          PackageManifest::isPackageLocation(path) &&
+                          std::find(entries.begin(), entries.end(), "package.json") != entries.end();
+        std::string package_version = is_package ? readPackageVersion(dir_fd) : std::string();
         
+        {
+            SyscallTimer timer(syscallLatency(options, result, SyscallType::CLOSE), SyscallType::CLOSE);
+            close(dir_fd);
+        }
+        
+        summary.structure_hash = structure.finish();
+        GET_FOLDER_PROBE4(dir_exit, path.c_str(), current_depth, entries.size(), summary.total_size);
+        
+        if (track_slow && !memory_.degraded()) {
+            SlowDirectory slow;
+            slow.path = path;
+            slow.list_us = list_us;
+            slow.stat_us = stat_us;
+            slow.entry_count = static_cast<uint32_t>(entries.size());
+            if (result.slow_directories.size() < options.slow_directory_limit) {
+                memory_.allocate(MemorySubsystem::STRINGS, MemoryAccounting::stringBytes(path.size()));
+            }
+            SlowDirectoryHeap::push(result.slow_directories, std::move(slow), options.slow_directory_limit);
+        }
+        
+        if (is_package) {
+            PackageInfo package;
+            package.name = PackageManifest::packageName(path);
+            package.version = package_version;
+            package.path = path;
+            package.size = summary.total_size - summary.nested_modules_size;
+            package.file_count = summary.file_count - summary.nested_modules_files;
+            package.depth = PackageManifest::nestingDepth(path);
+            package.newest_modified_time = summary.newest_modified_time;
+            package.newest_accessed_time = summary.newest_accessed_time;
+            memory_.allocate(MemorySubsystem::STRINGS, sizeof(PackageInfo) +
+                             MemoryAccounting::stringBytes(package.path.size()) +
+                             MemoryAccounting::stringBytes(package.name.size()) +
+                             MemoryAccounting::stringBytes(package.version.size()));
+            result.packages.push_back(std::move(package));
+        }
+        
+        // 记录子树结构哈希，用于相同子树检测（空目录不参与）；大小取不去重的值，与遍历顺序无关
+        if (options.detect_duplicates && summary.structure_files > 0 && !memory_.degraded()) {
+            memory_.allocate(MemorySubsystem::STRINGS, MemoryAccounting::stringBytes(path.size()) + sizeof(uint64_t) * 4);
+            duplicate_collector_.record(summary.structure_hash, path, summary.structure_size, summary.structure_files);
+        }
+        
+    } else if (info.is_symlink) {
+        // 符号链接
+        countSymlink(info, options, result, summary);
+        summary.structure_size = summary.total_size;
     } else {
         // 文件
         result.file_count++;
         result.total_size += info.size;
+        summary.total_size = info.size;
+        summary.file_count = 1;
+        summary.structure_size = info.size;
+        summary.structure_files = 1;
+    }
+    
+    return summary;
+}
+
+SubtreeSummary LinuxSyscallAccelerator::processFileEntry(
+    const LinuxFileInfo& info,
+    const CalculationOptions& options,
+    CalculationResult& result,
+    uint32_t depth) {
+    
+    SubtreeSummary summary;
+    
+    if (shouldIgnoreFile(info, options)) {
+        return summary;
+    }
+    
+    // 结构哈希只取项目自身的元数据：已在别处计入的硬链接同样参与，
+    // 共享硬链接的相同子树无论哪个先被遍历都得到相同的哈希
+    summary.present = true;
+    if (!info.is_symlink || options.include_link) {
+        summary.structure_size = info.size;
+    }
+    if (!info.is_symlink) {
+        summary.structure_files = 1;
+        // 按需对文件内容进行哈希，仅用于相同子树检测
+        if (options.detect_duplicates && options.duplicate_content_hash) {
+            summary.structure_hash = hashFileContent(info.path);
+        }
+    }
+    
+    // 去重只作用于大小与数量统计
+    if (!markInodeProcessed(info, options)) {
+        return summary;
+    }
+    
+    summary.counted = true;
+    recordItemTimes(info, result, summary);
+    recordShapeEntry(result, info.path, depth, options);
+    
+    if (info.is_symlink) {
+        countSymlink(info, options, result, summary);
+        return summary;
+    }
+    
+    result.file_count++;
+    result.total_size += info.size;
+    
+    summary.total_size = info.size;
+    summary.file_count = 1;
+    
+    return summary;
+}
+
+void LinuxSyscallAccelerator::countSymlink(
+    const LinuxFileInfo& info,
+    const CalculationOptions& options,
+    CalculationResult& result,
+    SubtreeSummary& summary) {
+    
+    result.link_count++;
+    
+    // 符号链接自身大小按 include_link 决定是否计入
+    if (options.include_link) {
+        result.total_size += info.size;
+        summary.total_size = info.size;
     }
 }
 
+void LinuxSyscallAccelerator::accumulateChild(
+    SubtreeSummary& parent,
+    FingerprintAccumulator& structure,
+    const std::string& name,
+    ItemType type,
+    const SubtreeSummary& child) {
+    
+    if (!child.present) {
+        return;
+    }
+    
+    // 结构哈希只包含名称、类型、大小与子项结构，不包含时间，便于识别不同位置的相同副本
+    parent.structure_size += child.structure_size;
+    parent.structure_files += child.structure_files;
+    structure.add(Fingerprint::ofEntry(name, type, child.structure_size, 0, child.structure_hash));
+    
+    if (!child.counted) {
+        return;
+    }
+    
+    parent.total_size += child.total_size;
+    parent.file_count += child.file_count;
+    parent.newest_modified_time = std::max(parent.newest_modified_time, child.newest_modified_time);
+    parent.newest_accessed_time = std::max(parent.newest_accessed_time, child.newest_accessed_time);
+    
+    if (type == ItemType::DIRECTORY && name == "node_modules") {
+        parent.nested_modules_size += child.total_size;
+        parent.nested_modules_files += child.file_count;
+    }
+
+}
+
+std::string LinuxSyscallAccelerator::readPackageVersion(int dir_fd) {
+    int fd = openat(dir_fd, "package.json", O_RDONLY);
+    if (fd == -1) {
+        return "";
+    }
+    
+    // 只读取文件开头部分，避免读取巨大的 package.json
+    std::string content(PackageManifest::MAX_MANIFEST_BYTES, '\0');
+    size_t total = 0;
+    while (total < content.size()) {
+        ssize_t bytes_read = read(fd, &content[total], content.size() - total);
+        if (bytes_read <= 0) {
+            break;
+        }
+        total += static_cast<size_t>(bytes_read);
+    }
+    close(fd);
+    
+    content.resize(total);
+    return PackageManifest::extractVersion(content);
+}
+
+uint64_t LinuxSyscallAccelerator::hashFileContent(const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        return 0;
+    }
+    
+    const size_t BUFFER_SIZE = 65536;
+    std::vector<char> buffer(BUFFER_SIZE);
+    ScopedMemory buffer_memory(memory_, MemorySubsystem::BUFFERS, BUFFER_SIZE);
+    uint64_t hash = 0;
+    
+    while (true) {
+        ssize_t bytes_read = read(fd, buffer.data(), BUFFER_SIZE);
+        if (bytes_read <= 0) {
+            break;
+        }
+        hash = Fingerprint::hashBytes(buffer.data(), static_cast<size_t>(bytes_read), hash);
+    }
+    
+    close(fd);
+    return hash;
+}
+
 std::shared_ptr<TreeNode> LinuxSyscallAccelerator::buildDirectoryTreeRecursive(
     const std::string& path,
     const CalculationOptions& options,
@@ -285,6 +631,12 @@ std::shared_ptr<TreeNode> LinuxSyscallAccelerator::buildDirectoryTreeRecursive(
     node->item = linuxFileInfoToFileSystemItem(info);
     node->depth = current_depth;
     node->total_size = info.size;
+    node->newest_modified_time = node->item.modified_time;
+    node->newest_accessed_time = info.is_directory ? 0 : node->item.accessed_time;
+    accountTreeNode(*node, true);
+    
+    // 子项指纹累加（与子项顺序无关）
+    FingerprintAccumulator children_fingerprint;
     
     if (info.is_directory) {
         int dir_fd = open(path.c_str(), O_RDONLY);
@@ -295,8 +647,19 @@ std::shared_ptr<TreeNode> LinuxSyscallAccelerator::buildDirectoryTreeRecursive(
                     std::string full_path = path + "/" + entry;
                     auto child_node = buildDirectoryTreeRecursive(full_path, options, current_depth + 1);
                     if (child_node) {
-                        node->children.push_back(child_node);
+                        children_fingerprint.add(child_node->fingerprint);
                         node->total_size += child_node->total_size;
+                        node->newest_modified_time = std::max(node->newest_modified_time,
+                                                              child_node->newest_modified_time);
+                        node->newest_accessed_time = std::max(node->newest_accessed_time,
+                                                              child_node->newest_accessed_time);
+                        
+                        // 超出内存上限后不再保留子节点，只累计汇总值
+                        if (memory_.degraded()) {
+                            releaseTree(*child_node);
+                        } else {
+                            node->children.push_back(child_node);
+                        }
                     }
                 }
             }
@@ -304,9 +667,95 @@ std::shared_ptr<TreeNode> LinuxSyscallAccelerator::buildDirectoryTreeRecursive(
         }
     }
     
+    node->fingerprint = Fingerprint::ofEntry(
+        node->item.name, node->item.type, node->item.size, node->item.modified_time,
+        info.is_directory ? children_fingerprint.finish() : 0);
+    
     return node;
 }
 
+ExportedNode LinuxSyscallAccelerator::exportDirectoryTreeRecursive(
+    const std::string& path,
+    const CalculationOptions& options,
+    TreeSink& sink,
+    uint32_t current_depth) {
+    
+    // 筛选规则、总大小与指纹均与 buildDirectoryTreeRecursive 一致
+    ExportedNode exported;
+    
+    if (current_depth >= options.max_depth) {
+        return exported;
+    }
+    
+    LinuxFileInfo info;
+    if (!getFileInfo(path, options.follow_symlinks, info)) {
+        return exported;
+    }
+    
+    if (shouldIgnoreFile(info, options)) {
+        return exported;
+    }
+    
+    FileSystemItem item = linuxFileInfoToFileSystemItem(info);
+    int depth = static_cast<int>(current_depth);
+    exported.exported = true;
+    exported.total_size = info.size;
+    exported.newest_modified_time = item.modified_time;
+    exported.newest_accessed_time = info.is_directory ? 0 : item.accessed_time;
+    
+    if (!info.is_directory) {
+        exported.fingerprint = Fingerprint::ofEntry(item.name, item.type, item.size, item.modified_time, 0);
+        sink.writeEntry(item, depth, exported.total_size, exported.fingerprint, exported.newest_modified_time,
+                        exported.newest_accessed_time);
+        return exported;
+    }
+    
+    // 调度点：有服务量更少的扫描在等待时让出槽位
+    if (scan_client_) {
+        scan_client_->checkpoint();
+    }
+    
+    sink.beginDirectory(item, depth);
+    
+    // 子项指纹累加（与子项顺序无关）
+    FingerprintAccumulator children_fingerprint;
+    
+    int dir_fd = open(path.c_str(), O_RDONLY);
+    if (dir_fd != -1) {
+        std::vector<std::string> entries;
+        bool listed = listDirectoryFast(dir_fd, entries);
+        // 列出后即关闭，打开的目录数不随深度增长
+        close(dir_fd);
+        
+        if (listed) {
+            // 目录项列表在导出本目录期间常驻
+            ScopedMemory entries_memory(memory_, MemorySubsystem::BUFFERS, 0);
+            for (const auto& entry : entries) {
+                entries_memory.grow(MemoryAccounting::stringBytes(entry.size()));
+            }
+            
+            for (const auto& entry : entries) {
+                ExportedNode child = exportDirectoryTreeRecursive(path + "/" + entry, options, sink,
+                                                                  current_depth + 1);
+                if (child.exported) {
+                    children_fingerprint.add(child.fingerprint);
+                    exported.total_size += child.total_size;
+                    exported.newest_modified_time = std::max(exported.newest_modified_time,
+                                                             child.newest_modified_time);
+                    exported.newest_accessed_time = std::max(exported.newest_accessed_time,
+                                                             child.newest_accessed_time);
+                }
+            }
+        }
+    }
+    
+    exported.fingerprint = Fingerprint::ofEntry(item.name, item.type, item.size, item.modified_time,
+                                                children_fingerprint.finish());
+    sink.endDirectory(item, depth, exported.total_size, exported.fingerprint, exported.newest_modified_time,
+                      exported.newest_accessed_time);
+    return exported;
+}
+
 FileSystemItem LinuxSyscallAccelerator::linuxFileInfoToFileSystemItem(const LinuxFileInfo& info) {
     FileSystemItem item;
     item.path = info.path;
@@ -316,6 +765,7 @@ FileSystemItem LinuxSyscallAccelerator::linuxFileInfoToFileSystemItem(const Linu
     item.modified_time = static_cast<uint64_t>(info.mtime) * 1000;
     item.accessed_time = static_cast<uint64_t>(info.atime) * 1000;
     item.inode = static_cast<uint64_t>(info.inode);
+    item.owner = static_cast<uint32_t>(info.uid);
     
     if (info.is_directory) {
         item.type = ItemType::DIRECTORY;
@@ -335,63 +785,208 @@ bool LinuxSyscallAccelerator::shouldIgnoreFile(const LinuxFileInfo& info, const
     }
     
     // 检查忽略模式
-    if (Utils::matchesIgnorePattern(info.path, options.ignore_patterns)) {
+    if (ignore_patterns_.matches(info.path)) {
         return true;
     }
     
     return false;
 }
 
-void LinuxSyscallAccelerator::processDirectoriesParallel(
+std::vector<SubtreeSummary> LinuxSyscallAccelerator::processDirectoriesParallel(
     const std::vector<std::string>& directories,
     const CalculationOptions& options,
     CalculationResult& result,
     uint32_t current_depth) {
     
+    std::vector<SubtreeSummary> summaries(directories.size());
+    
     if (directories.empty()) {
-        return;
+        return summaries;
     }
     
     // 计算线程数
-    uint32_t thread_count = std::min(max_threads_, static_cast<uint32_t>(directories.size()));
+    uint32_t thread_count = std::min(resolveThreadCount(options), static_cast<uint32_t>(directories.size()));
     
-    // 分割目录列表
-    std::vector<std::vector<std::string>> thread_dirs(thread_count);
+    // 分割目录列表（记录下标，各线程写入互不重叠的汇总位置）
+    std::vector<std::vector<size_t>> thread_dirs(thread_count);
     for (size_t i = 0; i < directories.size(); ++i) {
-        thread_dirs[i % thread_count].push_back(directories[i]);
+        thread_dirs[i % thread_count].push_back(i);
     }
+    ScopedMemory queue_memory(memory_, MemorySubsystem::QUEUES, directories.size() * sizeof(size_t));
     
     // 创建线程结果
     std::vector<std::future<CalculationResult>> futures;
     
-    for (const auto& dirs : thread_dirs) {
-        if (!dirs.empty()) {
-            futures.push_back(std::async(std::launch::async, [this, dirs, options, current_depth]() {
+    for (const auto& indices : thread_dirs) {
+        if (!indices.empty()) {
+            futures.push_back(std::async(std::launch::async,
+                [this, indices, &directories, &summaries, options, current_depth]() {
+                // 先绑定再创建线程结果，使其按首次访问分配在本地节点
+                placement_.placeCurrentThread();
+                ScanSlot slot(scan_client_);
                 CalculationResult thread_result;
-                for (const auto& dir : dirs) {
-                    calculateDirectorySizeRecursive(dir, options, thread_result, current_depth);
+                for (size_t index : indices) {
+                    summaries[index] = calculateDirectorySizeRecursive(
+                        directories[index], options, thread_result, current_depth);
                 }
                 return thread_result;
             }));
         }
     }
     
+    // 等待子线程期间归还槽位
+    ScanSlotRelease idle(scan_client_);
+    
     // 收集结果
     for (auto& future : futures) {
         try {
             CalculationResult thread_result = future.get();
-            result.total_size += thread_result.total_size;
-            result.file_count += thread_result.file_count;
-            result.directory_count += thread_result.directory_count;
-            
-            // 合并错误
-            result.errors.insert(result.errors.end(), 
-                               thread_result.errors.begin(), 
-                               thread_result.errors.end());
+            mergeThreadResult(result, thread_result, options);
         } catch (const std::exception& e) {
-            result.errors.push_back("Thread error: " + std::string(e.what()));
+            recordError(result, "Thread error: " + std::string(e.what()));
         }
     }
+    
+    return summaries;
+}
+
+void LinuxSyscallAccelerator::mergeThreadResult(CalculationResult& result, CalculationResult& thread_result,
+                                                const CalculationOptions& options) {
+    result.total_size += thread_result.total_size;
+    result.file_count += thread_result.file_count;
+    result.directory_count += thread_result.directory_count;
+    result.link_count += thread_result.link_count;
+    result.newest_modified_time = std::max(result.newest_modified_time, thread_result.newest_modified_time);
+    result.newest_accessed_time = std::max(result.newest_accessed_time, thread_result.newest_accessed_time);
+    
+    // 合并错误
+    result.errors.insert(result.errors.end(),
+                         std::make_move_iterator(thread_result.errors.begin()),
+                         std::make_move_iterator(thread_result.errors.end()));
+    
+    // 合并系统调用延迟直方图
+    result.syscall_latency.merge(thread_result.syscall_latency);
+    
+    // 合并慢目录记录
+    SlowDirectoryHeap::merge(result.slow_directories, thread_result.slow_directories,
+                             options.slow_directory_limit);
+    
+    // 合并形状统计
+    result.shape.merge(thread_result.shape, options.shape_profile_limit);
+    
+    // 合并包统计
+    result.packages.insert(result.packages.end(),
+                           std::make_move_iterator(thread_result.packages.begin()),
+                           std::make_move_iterator(thread_result.packages.end()));
+}
+
+bool LinuxSyscallAccelerator::usePipeline(const CalculationOptions& options) {
+    // 操作超时依赖流水线的看门狗，设置后同样使用流水线
+    return (options.pipeline_listers > 0 || options.operation_timeout_ms > 0) && !options.detect_duplicates && !options.aggregate_packages &&
+           options.slow_directory_limit == 0;
+}
+
+std::unique_ptr<ScanPipeline> LinuxSyscallAccelerator::createPipeline(const CalculationOptions& options) {
+    return std::make_unique<ScanPipeline>(*this, options);
+}
+
+void LinuxSyscallAccelerator::beginScan(const CalculationOptions& options) {
+    // 去重集合按 inode 哈希分区，分区数随 NUMA 节点数增加（分区不与节点绑定）
+    processed_inodes_.reset(CpuTopology::instance().nodeCount() * INODE_PARTITIONS_PER_NODE);
+    memory_.reset(options.memory_limit);
+    placement_.configure(options.cpu_affinity, options.numa_aware);
+    ignore_patterns_.compile(options.ignore_patterns);
+}
+
+bool LinuxSyscallAccelerator::markInodeProcessed(const LinuxFileInfo& info, const CalculationOptions& options) {
+    // 关闭硬链接检测时每个路径单独计数（与 Windows 引擎及 JS 后端一致）
+    if (!options.inode_check) {
+        return true;
+    }
+    
+    // 降级后不再扩大去重集合，只检查已记录的 inode
+    bool record = !memory_.degraded();
+    if (!processed_inodes_.checkAndInsert(static_cast<uint64_t>(info.device), static_cast<uint64_t>(info.inode), record)) {
+        return false;
+    }
+    
+    if (record) {
+        memory_.allocate(MemorySubsystem::INODE_SET, INODE_ENTRY_BYTES);
+    }
+    return true;
+}
+
+void LinuxSyscallAccelerator::recordError(CalculationResult& result, std::string message) {
+    GET_FOLDER_PROBE1(error, message.c_str());
+    memory_.allocate(MemorySubsystem::STRINGS, MemoryAccounting::stringBytes(message.size()));
+    result.errors.push_back(std::move(message));
+}
+
+void LinuxSyscallAccelerator::recordItemTimes(const LinuxFileInfo& info, CalculationResult& result,
+                                              SubtreeSummary& summary) {
+    // 早于 1970 年的时间按 0 处理
+    summary.newest_modified_time = info.mtime > 0 ? static_cast<uint64_t>(info.mtime) * 1000 : 0;
+    if (!info.is_directory) {
+        summary.newest_accessed_time = info.atime > 0 ? static_cast<uint64_t>(info.atime) * 1000 : 0;
+    }
+    result.newest_modified_time = std::max(result.newest_modified_time, summary.newest_modified_time);
+    result.newest_accessed_time = std::max(result.newest_accessed_time, summary.newest_accessed_time);
+}
+
+void LinuxSyscallAccelerator::recordShapeEntry(CalculationResult& result, const std::string& path, uint32_t depth,
+                                               const CalculationOptions& options) {
+    if (!options.shape_profile) {
+        return;
+    }
+    // 降级后只统计分布，不再保留路径
+    size_t limit = memory_.degraded() ? 0 : options.shape_profile_limit;
+    if (result.shape.recordEntry(path, depth, limit)) {
+        memory_.allocate(MemorySubsystem::STRINGS, MemoryAccounting::stringBytes(path.size()));
+    }
+}
+
+void LinuxSyscallAccelerator::recordShapeDirectory(CalculationResult& result, const std::string& path,
+                                                   uint64_t entry_count, const CalculationOptions& options) {
+    if (!options.shape_profile) {
+        return;
+    }
+    size_t limit = memory_.degraded() ? 0 : options.shape_profile_limit;
+    if (result.shape.recordDirectory(path, entry_count, limit)) {
+        memory_.allocate(MemorySubsystem::STRINGS, MemoryAccounting::stringBytes(path.size()));
+    }
+}
+
+void LinuxSyscallAccelerator::accountTreeNode(const TreeNode& node, bool allocate) {
+    // 节点对象、shared_ptr 控制块与子节点指针
+    uint64_t node_bytes = sizeof(TreeNode) + 2 * sizeof(void*) + sizeof(std::shared_ptr<TreeNode>);
+    uint64_t string_bytes = MemoryAccounting::stringBytes(node.item.path.size()) +
+                            MemoryAccounting::stringBytes(node.item.name.size());
+    
+    if (allocate) {
+        memory_.allocate(MemorySubsystem::TREE_NODES, node_bytes);
+        memory_.allocate(MemorySubsystem::STRINGS, string_bytes);
+    } else {
+        memory_.release(MemorySubsystem::TREE_NODES, node_bytes);
+        memory_.release(MemorySubsystem::STRINGS, string_bytes);
+    }
+}
+
+void LinuxSyscallAccelerator::releaseTree(const TreeNode& node) {
+    for (const auto& child : node.children) {
+        releaseTree(*child);
+    }
+    accountTreeNode(node, false);
+}
+
+LatencyHistogram* LinuxSyscallAccelerator::syscallLatency(const CalculationOptions& options,
+                                                          CalculationResult& result,
+                                                          SyscallType type) {
+    return options.latency_histograms ? &result.syscall_latency.of(type) : nullptr;
+}
+
+uint32_t LinuxSyscallAccelerator::resolveThreadCount(const CalculationOptions& options) const {
+    // 0 表示自动，使用系统最优线程数
+    return options.max_threads == 0 ? max_threads_ : options.max_threads;
 }
 
 uint32_t LinuxSyscallAccelerator::getOptimalThreadCount() {
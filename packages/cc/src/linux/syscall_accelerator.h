@@ -1,6 +1,14 @@
 #pragma once
 
 #include "../common/filesystem_common.h"
+#include "../common/fingerprint.h"
+#include "../common/duplicate_detector.h"
+#include "../common/package_manifest.h"
+#include "../common/scan_diagnostics.h"
+#include "../common/cpu_topology.h"
+#include "../common/partitioned_inode_set.h"
+#include "../common/ignore_patterns.h"
+#include "../common/tree_sink.h"
 
 #ifdef PLATFORM_LINUX
 
@@ -9,6 +17,7 @@
 #include <dirent.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <memory>
 #include <thread>
 #include <mutex>
 #include <vector>
@@ -23,25 +32,71 @@ namespace filesystem {
 struct LinuxFileInfo {
     std::string path;              // 文件路径
     std::string name;              // 文件名
+    dev_t device;                 // 所在设备号（与 inode 号共同标识文件）
     ino_t inode;                  // inode 号
     mode_t mode;                  // 文件模式
     off_t size;                   // 文件大小
     time_t atime;                 // 访问时间
     time_t mtime;                 // 修改时间
     time_t ctime;                 // 状态改变时间
+    uid_t uid;                    // 所有者
     bool is_directory;            // 是否为目录
     bool is_symlink;              // 是否为符号链接
 };
 
+/**
+ * 子树汇总信息（遍历时自底向上合并）
+ */
+struct SubtreeSummary {
+    bool counted;                 // 是否已计入统计（忽略或重复的硬链接为 false）
+    bool present;                 // 是否参与结构哈希（未被忽略即参与，与硬链接去重无关）
+    uint64_t total_size;          // 子树总大小
+    uint32_t file_count;          // 子树文件数量
+    uint64_t structure_size;      // 子树大小（不做硬链接去重，用于结构哈希与相同子树检测）
+    uint32_t structure_files;     // 子树文件数量（不做硬链接去重）
+    uint64_t structure_hash;      // 结构哈希（名称、类型、大小，可选文件内容）
+    uint64_t nested_modules_size; // 直接子目录 node_modules 的大小（包统计时扣除）
+    uint32_t nested_modules_files; // 直接子目录 node_modules 的文件数量
+    uint64_t newest_modified_time; // 子树中最新的修改时间（毫秒，含自身）
+    uint64_t newest_accessed_time; // 子树中文件与链接最新的访问时间（毫秒）
+    
+    SubtreeSummary() : counted(false), present(false), total_size(0), file_count(0),
+                       structure_size(0), structure_files(0), structure_hash(0),
+                       nested_modules_size(0), nested_modules_files(0),
+                       newest_modified_time(0), newest_accessed_time(0) {}
+};
+
+/**
+ * 已导出节点的汇总（父目录据此累加总大小与指纹）
+ */
+struct ExportedNode {
+    bool exported;                // 是否已写出（忽略或无法访问的项为 false）
+    uint64_t total_size;          // 总大小（包含子项目）
+    uint64_t fingerprint;         // 元数据指纹
+    uint64_t newest_modified_time;  // 子树中最新的修改时间（毫秒）
+    uint64_t newest_accessed_time;  // 子树中文件与链接最新的访问时间（毫秒）
+    
+    ExportedNode() : exported(false), total_size(0), fingerprint(0), newest_modified_time(0), newest_accessed_time(0) {}
+};
+
+class ScanPipeline;
+
 /**
  * Linux 系统调用加速器
  * 使用 Linux 特定的系统调用来优化文件系统操作
  */
 class LinuxSyscallAccelerator : public FilesystemAccelerator {
-private:
-    std::unordered_set<ino_t> processed_inodes_;  // 已处理的 inode
-    std::mutex inode_mutex_;                      // inode 集合的互斥锁
+    friend class ScanPipeline;
+
+protected:
+    PartitionedInodeSet processed_inodes_;        // 已处理的 inode（按哈希分区加锁）
+    WorkerPlacement placement_;                   // 工作线程放置策略
+    IgnorePatternSet ignore_patterns_;            // 本次扫描预编译的忽略模式
+    DuplicateSubtreeCollector duplicate_collector_; // 相同子树收集器
     uint32_t max_threads_;                        // 最大线程数
+    
+    static constexpr uint64_t INODE_ENTRY_BYTES = 48;  // 去重集合中每个 inode 的估算字节数（节点 + 桶）
+    static constexpr size_t INODE_PARTITIONS_PER_NODE = 16;  // inode 集合的哈希分区数（每个 NUMA 节点乘以该值）
 
 public:
     /**
@@ -65,11 +120,17 @@ public:
         const CalculationOptions& options = CalculationOptions()
     ) override;
     
+    void exportDirectoryTree(
+        const std::string& path,
+        const CalculationOptions& options,
+        TreeSink& sink
+    ) override;
+    
     bool pathExists(const std::string& path) override;
     
     FileSystemItem getItemInfo(const std::string& path, bool follow_symlinks = false) override;
 
-private:
+protected:
     /**
      * 获取文件信息（使用 stat/lstat）
      * @param path 文件路径
@@ -79,13 +140,22 @@ private:
      */
     bool getFileInfo(const std::string& path, bool follow_symlinks, LinuxFileInfo& info);
     
+    /**
+     * 从 stat 结果填充文件信息（不含路径与名称）
+     * @param st stat 结果
+     * @param info 输出文件信息
+     */
+    static void fillFileInfo(const struct stat& st, LinuxFileInfo& info);
+    
     /**
      * 使用 getdents64 系统调用快速列出目录内容
      * @param dir_fd 目录文件描述符
      * @param entries 输出目录项列表
+     * @param getdents_latency getdents64 延迟直方图（为空时不统计）
      * @return 是否成功
      */
-    bool listDirectoryFast(int dir_fd, std::vector<std::string>& entries);
+    bool listDirectoryFast(int dir_fd, std::vector<std::string>& entries,
+                           LatencyHistogram* getdents_latency = nullptr);
     
     /**
      * 递归计算目录大小
@@ -93,14 +163,74 @@ private:
      * @param options 配置选项
      * @param result 计算结果
      * @param current_depth 当前深度
+     * @return 子树汇总信息
      */
-    void calculateDirectorySizeRecursive(
+    SubtreeSummary calculateDirectorySizeRecursive(
         const std::string& path,
         const CalculationOptions& options,
         CalculationResult& result,
         uint32_t current_depth = 0
     );
     
+    /**
+     * 统计符号链接（计数，并按 include_link 决定是否计入大小）
+     * @param info 文件信息
+     * @param options 配置选项
+     * @param result 计算结果
+     * @param summary 链接的汇总信息
+     */
+    void countSymlink(
+        const LinuxFileInfo& info,
+        const CalculationOptions& options,
+        CalculationResult& result,
+        SubtreeSummary& summary
+    );
+    
+    /**
+     * 统计目录中的单个文件项
+     * @param info 文件信息
+     * @param options 配置选项
+     * @param result 计算结果
+     * @param depth 文件项的深度
+     * @return 文件的汇总信息
+     */
+    SubtreeSummary processFileEntry(
+        const LinuxFileInfo& info,
+        const CalculationOptions& options,
+        CalculationResult& result,
+        uint32_t depth
+    );
+    
+    /**
+     * 将子项汇总合并到父目录
+     * @param parent 父目录汇总
+     * @param structure 父目录结构哈希累加器
+     * @param name 子项名称
+     * @param type 子项类型
+     * @param child 子项汇总
+     */
+    void accumulateChild(
+        SubtreeSummary& parent,
+        FingerprintAccumulator& structure,
+        const std::string& name,
+        ItemType type,
+        const SubtreeSummary& child
+    );
+    
+    /**
+     * 使用有界读取从目录下的 package.json 中获取版本号
+     * @param dir_fd 包目录文件描述符
+     * @return 版本号，无法读取时为空字符串
+     */
+    std::string readPackageVersion(int dir_fd);
+    
+    /**
+     * 对文件内容进行哈希
+     * @param path 文件路径
+     * @return 内容哈希，无法读取时为 0
+     */
+    uint64_t hashFileContent(const std::string& path);
+    
     /**
      * 递归构建目录树
      * @param path 目录路径
@@ -114,6 +244,21 @@ private:
         uint32_t current_depth = 0
     );
     
+    /**
+     * 递归导出目录树（逐个节点写出，只保留当前路径上各层目录的目录项列表）
+     * @param path 路径
+     * @param options 配置选项
+     * @param sink 导出目标
+     * @param current_depth 当前深度
+     * @return 节点汇总
+     */
+    ExportedNode exportDirectoryTreeRecursive(
+        const std::string& path,
+        const CalculationOptions& options,
+        TreeSink& sink,
+        uint32_t current_depth = 0
+    );
+    
     /**
      * 转换 Linux 文件信息为文件系统项目
      * @param info Linux 文件信息
@@ -135,14 +280,118 @@ private:
      * @param options 配置选项
      * @param result 计算结果
      * @param current_depth 当前深度
+     * @return 与目录列表一一对应的子树汇总
      */
-    void processDirectoriesParallel(
+    std::vector<SubtreeSummary> processDirectoriesParallel(
         const std::vector<std::string>& directories,
         const CalculationOptions& options,
         CalculationResult& result,
         uint32_t current_depth
     );
     
+    /**
+     * 将工作线程的结果合并到总结果
+     * @param result 总结果
+     * @param thread_result 线程结果
+     * @param options 配置选项
+     */
+    void mergeThreadResult(CalculationResult& result, CalculationResult& thread_result,
+                           const CalculationOptions& options);
+    
+    /**
+     * 是否使用流水线模式扫描（需要按目录汇总的功能仍使用递归遍历）
+     * @param options 配置选项
+     * @return 是否使用流水线
+     */
+    static bool usePipeline(const CalculationOptions& options);
+    
+    /**
+     * 创建流水线扫描（测试可重写，替换为模拟挂起操作的流水线）
+     * @param options 配置选项
+     * @return 流水线
+     */
+    virtual std::unique_ptr<ScanPipeline> createPipeline(const CalculationOptions& options);
+    
+    /**
+     * 开始一次扫描：重置去重集合、内存统计与工作线程放置
+     * @param options 配置选项
+     */
+    void beginScan(const CalculationOptions& options);
+    
+    /**
+     * 记录 inode 已处理（硬链接检测）
+     * @param info 文件信息（按设备号与 inode 号识别，不同文件系统的 inode 号可能相同）
+     * @param options 配置选项（inode_check 为 false 时不去重）
+     * @return 是否需要处理（已处理过时为 false）
+     */
+    bool markInodeProcessed(const LinuxFileInfo& info, const CalculationOptions& options);
+    
+    /**
+     * 记录错误信息
+     * @param result 计算结果
+     * @param message 错误信息
+     */
+    void recordError(CalculationResult& result, std::string message);
+    
+    /**
+     * 记录计入统计的项目的时间：写入项目自身的汇总，并更新线程结果中的最新时间
+     * 目录的访问时间会被遍历本身更新（relatime），不参与访问时间的汇总
+     * @param info 文件信息
+     * @param result 当前线程的计算结果
+     * @param summary 项目的汇总信息
+     */
+    static void recordItemTimes(const LinuxFileInfo& info, CalculationResult& result, SubtreeSummary& summary);
+    
+    /**
+     * 形状统计：记录一个计入统计的项目（未启用时不做任何事）
+     * @param result 当前线程的计算结果
+     * @param path 项目路径
+     * @param depth 深度（根为 0）
+     * @param options 配置选项
+     */
+    void recordShapeEntry(CalculationResult& result, const std::string& path, uint32_t depth,
+                          const CalculationOptions& options);
+    
+    /**
+     * 形状统计：记录一个已列出的目录及其子项数量（未启用时不做任何事）
+     * @param result 当前线程的计算结果
+     * @param path 目录路径
+     * @param entry_count 子项数量
+     * @param options 配置选项
+     */
+    void recordShapeDirectory(CalculationResult& result, const std::string& path, uint64_t entry_count,
+                              const CalculationOptions& options);
+    
+    /**
+     * 记录目录树节点的内存用量
+     * @param node 节点
+     * @param allocate true 为分配，false 为释放
+     */
+    void accountTreeNode(const TreeNode& node, bool allocate);
+    
+    /**
+     * 释放不再保留的子树的内存记录
+     * @param node 子树根节点
+     */
+    void releaseTree(const TreeNode& node);
+    
+    /**
+     * 获取需要记录的系统调用延迟直方图
+     * @param options 配置选项
+     * @param result 当前线程的计算结果
+     * @param type 系统调用类型
+     * @return 直方图，未启用统计时为空指针
+     */
+    static LatencyHistogram* syscallLatency(const CalculationOptions& options, CalculationResult& result,
+                                            SyscallType type);
+    
+    /**
+     * 根据配置选项确定实际使用的线程数
+     * @param options 配置选项
+     * @return 线程数
+     */
+    uint32_t resolveThreadCount(const CalculationOptions& options) const;
+    
     /**
      * 获取系统最优线程数
      * @return 线程数
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * USDT 静态探针（provider 为 get_folder）
+ *
+ * 不依赖 systemtap 的 <sys/sdt.h>，直接按其约定生成 .note.stapsdt ELF 注释：
+ * 每个探针位置只是一条 nop，注释中记录 nop 的地址与参数所在的寄存器，
+ * bpftrace / perf / systemtap 附加时把 nop 替换为断点；未附加时开销只是一条 nop
+ * 与把参数放入寄存器。参数一律以 64 位无符号整数传递（字符串传指针）。
+ *
+ *   bpftrace -e 'usdt:./build/Release/brisk_folder_size_native.node:get_folder:dir_exit { @[str(arg0)] = arg2; }'
+ *
+ * 探针：
+ *   scan_start(path, pipeline)                                  扫描开始
+ *   scan_end(path, total_size, file_count, directory_count, duration_ms)  扫描结束
+ *   dir_enter(path, depth)                                      开始处理目录
+ *   dir_exit(path, depth, entry_count, total_size)              目录处理完成（流水线模式 total_size 为 0）
+ *   stat_batch(directory, entry_count, stat_calls)              流水线 stat 批次完成
+ *   task_take(kind, path, entry_count)                          流水线工作线程从共享队列取得任务（kind 0 为列目录，1 为 stat 批次）
+ *   error(message)                                              记录扫描错误
+ *
+ * 仅在 x86-64 与 AArch64 的 GCC/Clang 上生成探针，其他平台或定义 GET_FOLDER_DISABLE_PROBES 时为空操作。
+ */
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__aarch64__)) && !defined(GET_FOLDER_DISABLE_PROBES)
+
+#define GET_FOLDER_PROBES_ENABLED 1
+
+namespace brisk {
+namespace filesystem {
+namespace probes {
+
+/**
+ * 探针参数转换为 64 位整数（指针传地址）
+ */
+inline uint64_t argument(const void* value) { return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value)); }
+
+template <typename T, typename = typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type>
+inline uint64_t argument(T value) { return static_cast<uint64_t>(value); }
+
+} // namespace probes
+} // namespace filesystem
+} // namespace brisk
+
+#define GET_FOLDER_PROBE_ARG(value) ::brisk::filesystem::probes::argument(value)
+
+// 注释格式：namesz、descsz、type=3、"stapsdt"，随后为探针地址、基址、信号量（未使用）、provider、名称与参数描述
+#define GET_FOLDER_PROBE_ASM(name, args)                                                  \
+    "990: nop\n"                                                                          \
+    ".pushsection .note.stapsdt,\"?\",\"note\"\n"                                         \
+    ".balign 4\n"                                                                         \
+    ".4byte 992f-991f, 994f-993f, 3\n"                                                    \
+    "991: .asciz \"stapsdt\"\n"                                                           \
+    "992: .balign 4\n"                                                                    \
+    "993: .8byte 990b\n"                                                                  \
+    ".8byte _.stapsdt.base\n"                                                             \
+    ".8byte 0\n"                                                                          \
+    ".asciz \"get_folder\"\n"                                                             \
+    ".asciz \"" #name "\"\n"                                                              \
+    ".asciz \"" args "\"\n"                                                               \
+    "994: .balign 4\n"                                                                    \
+    ".popsection\n"                                                                       \
+    ".ifndef _.stapsdt.base\n"                                                            \
+    ".pushsection .stapsdt.base,\"aG\",\"progbits\",.stapsdt.base,comdat\n"               \
+    ".weak _.stapsdt.base\n"                                                              \
+    ".hidden _.stapsdt.base\n"                                                            \
+    "_.stapsdt.base: .space 1\n"                                                          \
+    ".size _.stapsdt.base, 1\n"                                                           \
+    ".popsection\n"                                                                       \
+    ".endif\n"
+
+#define GET_FOLDER_PROBE1(name, v1)                                                       \
+    __asm__ __volatile__(GET_FOLDER_PROBE_ASM(name, "8@%[a1]")                            \
+                         :: [a1] "r"(GET_FOLDER_PROBE_ARG(v1)))
+
+#define GET_FOLDER_PROBE2(name, v1, v2)                                                   \
+    __asm__ __volatile__(GET_FOLDER_PROBE_ASM(name, "8@%[a1] 8@%[a2]")                    \
+                         :: [a1] "r"(GET_FOLDER_PROBE_ARG(v1)), [a2] "r"(GET_FOLDER_PROBE_ARG(v2)))
+
+#define GET_FOLDER_PROBE3(name, v1, v2, v3)                                               \
+    __asm__ __volatile__(GET_FOLDER_PROBE_ASM(name, "8@%[a1] 8@%[a2] 8@%[a3]")            \
+                         :: [a1] "r"(GET_FOLDER_PROBE_ARG(v1)), [a2] "r"(GET_FOLDER_PROBE_ARG(v2)), \
+                            [a3] "r"(GET_FOLDER_PROBE_ARG(v3)))
+
+#define GET_FOLDER_PROBE4(name, v1, v2, v3, v4)                                           \
+    __asm__ __volatile__(GET_FOLDER_PROBE_ASM(name, "8@%[a1] 8@%[a2] 8@%[a3] 8@%[a4]")    \
+                         :: [a1] "r"(GET_FOLDER_PROBE_ARG(v1)), [a2] "r"(GET_FOLDER_PROBE_ARG(v2)), \
+                            [a3] "r"(GET_FOLDER_PROBE_ARG(v3)), [a4] "r"(GET_FOLDER_PROBE_ARG(v4)))
+
+#define GET_FOLDER_PROBE5(name, v1, v2, v3, v4, v5)                                       \
+    __asm__ __volatile__(GET_FOLDER_PROBE_ASM(name, "8@%[a1] 8@%[a2] 8@%[a3] 8@%[a4] 8@%[a5]") \
+                         :: [a1] "r"(GET_FOLDER_PROBE_ARG(v1)), [a2] "r"(GET_FOLDER_PROBE_ARG(v2)), \
+                            [a3] "r"(GET_FOLDER_PROBE_ARG(v3)), [a4] "r"(GET_FOLDER_PROBE_ARG(v4)), \
+                            [a5] "r"(GET_FOLDER_PROBE_ARG(v5)))
+
+#else
+
+#define GET_FOLDER_PROBES_ENABLED 0
+
+#define GET_FOLDER_PROBE1(name, v1) do { } while (0)
+#define GET_FOLDER_PROBE2(name, v1, v2) do { } while (0)
+#define GET_FOLDER_PROBE3(name, v1, v2, v3) do { } while (0)
+#define GET_FOLDER_PROBE4(name, v1, v2, v3, v4) do { } while (0)
+#define GET_FOLDER_PROBE5(name, v1, v2, v3, v4, v5) do { } while (0)
+
+#endif
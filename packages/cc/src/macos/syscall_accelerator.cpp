@@ -19,65 +19,29 @@ CalculationResult MacOSSyscallAccelerator::calculateFolderSize(
     const std::string& path, 
     const CalculationOptions& options) {
     
-    CalculationResult result;
-    uint64_t start_time = Utils::getCurrentTimestamp();
-    
-    try {
-        // 检查路径是否存在
-        if (!pathExists(path)) {
-            result.errors.push_back("Path not found: " + path);
-            return result;
-        }
-        
-        // 检查是否为系统路径，如果是则使用特殊处理
-        if (isMacOSSystemPath(path)) {
-            // 对于系统路径，使用更谨慎的方法
-            CalculationOptions safe_options = options;
-            safe_options.max_threads = 1;  // 减少线程数以避免系统负载
-            return LinuxSyscallAccelerator::calculateFolderSize(path, safe_options);
-        }
-        
-        // 清理已处理的 inode 集合
-        {
-            std::lock_guard<std::mutex> lock(inode_mutex_);
-            processed_inodes_.clear();
-        }
-        
-        // 使用 macOS 优化的计算方法
-        calculateDirectorySizeMacOS(path, options, result, 0);
-        
-    } catch (const FilesystemException& e) {
-        result.errors.push_back(std::string(e.what()));
-    } catch (const std::exception& e) {
-        result.errors.push_back("Unexpected error: " + std::string(e.what()));
+    // 遍历、统计选项（相同子树、包汇总、慢目录、延迟直方图、形状统计等）与流水线均由父类实现
+    CalculationOptions macos_options = options;
+    if (isMacOSSystemPath(path)) {
+        // 对于系统路径，使用更谨慎的方法
+        macos_options.max_threads = 1;  // 减少线程数以避免系统负载
     }
+    CalculationResult result = LinuxSyscallAccelerator::calculateFolderSize(path, macos_options);
     
-    result.duration_ms = Utils::getCurrentTimestamp() - start_time;
+    // 父类返回错误且没有统计到任何内容时（路径不存在、选项冲突）不再追加资源分支
+    if (result.errors.empty() || result.file_count > 0 || result.directory_count > 0) {
+        result.total_size += resourceForkSize(path);
+    }
     return result;
 }
 
-void MacOSSyscallAccelerator::calculateDirectorySizeMacOS(
-    const std::string& path,
-    const CalculationOptions& options,
-    CalculationResult& result,
-    uint32_t current_depth) {
-    
-    // 对于大多数情况，使用父类的实现
-    // macOS 和 Linux 在文件系统 API 上基本兼容
-    calculateDirectorySizeRecursive(path, options, result, current_depth);
-    
-    // 这里可以添加 macOS 特定的优化，例如：
-    // - 使用 FSEvents 监控文件系统变化
-    // - 利用 HFS+/APFS 特定功能
-    // - 处理 macOS 特有的扩展属性和资源分支
-    
-    // 示例：检查扩展属性（resource fork）
+uint64_t MacOSSyscallAccelerator::resourceForkSize(const std::string& path) {
+    // macOS 特有的资源分支通过 ..namedfork/rsrc 访问
     std::string resource_fork = path + "/..namedfork/rsrc";
     struct stat st;
     if (lstat(resource_fork.c_str(), &st) == 0) {
-        // 添加资源分支的大小
-        result.total_size += st.st_size;
+        return static_cast<uint64_t>(st.st_size);
     }
+    return 0;
 }
 
 bool MacOSSyscallAccelerator::isMacOSSystemPath(const std::string& path) {
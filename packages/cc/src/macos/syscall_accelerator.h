@@ -26,7 +26,7 @@ public:
      */
     ~MacOSSyscallAccelerator();
     
-    // 重写部分方法以支持 macOS 特定功能
+    // 委托给父类计算，再加上根路径的资源分支大小
     CalculationResult calculateFolderSize(
         const std::string& path, 
         const CalculationOptions& options = CalculationOptions()
@@ -34,18 +34,11 @@ public:
 
 private:
     /**
-     * 使用 macOS 特定的目录遍历优化
-     * @param path 目录路径
-     * @param options 配置选项
-     * @param result 计算结果
-     * @param current_depth 当前深度
+     * 获取路径的资源分支大小
+     * @param path 文件或目录路径
+     * @return 资源分支大小（不存在时为 0）
      */
-    void calculateDirectorySizeMacOS(
-        const std::string& path,
-        const CalculationOptions& options,
-        CalculationResult& result,
-        uint32_t current_depth = 0
-    );
+    uint64_t resourceForkSize(const std::string& path);
     
     /**
      * 检查是否为 macOS 系统文件/目录
@@ -3,11 +3,18 @@
 #include <string>
 
 #include "common/filesystem_common.h"
+#include "common/fingerprint.h"
+#include "common/scan_coalescer.h"
+#include "common/tree_export_writer.h"
+#include "common/snapshot_writer.h"
+#include "common/snapshot_query.h"
+#include "common/process_metrics.h"
 
 #ifdef PLATFORM_WINDOWS
 #include "windows/mft_accelerator.h"
 #elif defined(PLATFORM_LINUX)
 #include "linux/syscall_accelerator.h"
+#include "linux/content_digest.h"
 #elif defined(PLATFORM_MACOS)
 #include "macos/syscall_accelerator.h"
 #endif
@@ -19,6 +26,22 @@ using namespace brisk::filesystem;
  */
 static std::unique_ptr<FilesystemAccelerator> g_accelerator;
 
+/**
+ * 创建当前平台的加速器实例
+ * @return 加速器实例，不支持的平台返回空
+ */
+static std::unique_ptr<FilesystemAccelerator> createPlatformAccelerator() {
+#ifdef PLATFORM_WINDOWS
+    return std::make_unique<WindowsAccelerator>();
+#elif defined(PLATFORM_LINUX)
+    return std::make_unique<LinuxSyscallAccelerator>();
+#elif defined(PLATFORM_MACOS)
+    return std::make_unique<MacOSSyscallAccelerator>();
+#else
+    return nullptr;
+#endif
+}
+
 
 
 /**
@@ -34,6 +57,19 @@ std::vector<std::string> napiArrayToStringVector(const Napi::Array& array) {
     return vec;
 }
 
+/**
+ * 将 Napi 数组转换为无符号整数向量（忽略非数字项）
+ */
+std::vector<uint32_t> napiArrayToUint32Vector(const Napi::Array& array) {
+    std::vector<uint32_t> vec;
+    for (uint32_t i = 0; i < array.Length(); ++i) {
+        if (array[i].IsNumber()) {
+            vec.push_back(array[i].As<Napi::Number>().Uint32Value());
+        }
+    }
+    return vec;
+}
+
 /**
  * 将 CalculationOptions 从 Napi 对象转换为 C++ 结构
  */
@@ -60,9 +96,218 @@ CalculationOptions parseCalculationOptions(const Napi::Object& obj) {
         options.include_link = obj.Get("includeLink").As<Napi::Boolean>().Value();
     }
     
+    if (obj.Has("followSymlinks") && obj.Get("followSymlinks").IsBoolean()) {
+        options.follow_symlinks = obj.Get("followSymlinks").As<Napi::Boolean>().Value();
+    }
+    
+    if (obj.Has("maxThreads") && obj.Get("maxThreads").IsNumber()) {
+        options.max_threads = obj.Get("maxThreads").As<Napi::Number>().Uint32Value();
+    }
+    
+    if (obj.Has("detectDuplicates") && obj.Get("detectDuplicates").IsBoolean()) {
+        options.detect_duplicates = obj.Get("detectDuplicates").As<Napi::Boolean>().Value();
+    }
+    
+    if (obj.Has("duplicateContentHash") && obj.Get("duplicateContentHash").IsBoolean()) {
+        options.duplicate_content_hash = obj.Get("duplicateContentHash").As<Napi::Boolean>().Value();
+    }
+    
+    if (obj.Has("aggregatePackages") && obj.Get("aggregatePackages").IsBoolean()) {
+        options.aggregate_packages = obj.Get("aggregatePackages").As<Napi::Boolean>().Value();
+    }
+    
+    if (obj.Has("slowDirectoryLimit") && obj.Get("slowDirectoryLimit").IsNumber()) {
+        options.slow_directory_limit = obj.Get("slowDirectoryLimit").As<Napi::Number>().Uint32Value();
+    }
+    
+    if (obj.Has("latencyHistograms") && obj.Get("latencyHistograms").IsBoolean()) {
+        options.latency_histograms = obj.Get("latencyHistograms").As<Napi::Boolean>().Value();
+    }
+    
+    if (obj.Has("shapeProfile") && obj.Get("shapeProfile").IsBoolean()) {
+        options.shape_profile = obj.Get("shapeProfile").As<Napi::Boolean>().Value();
+    }
+    
+    if (obj.Has("shapeProfileLimit") && obj.Get("shapeProfileLimit").IsNumber()) {
+        options.shape_profile_limit = obj.Get("shapeProfileLimit").As<Napi::Number>().Uint32Value();
+    }
+    
+    if (obj.Has("memoryLimit") && obj.Get("memoryLimit").IsNumber()) {
+        options.memory_limit = static_cast<uint64_t>(obj.Get("memoryLimit").As<Napi::Number>().Int64Value());
+    }
+    
+    if (obj.Has("cpuAffinity") && obj.Get("cpuAffinity").IsArray()) {
+        options.cpu_affinity = napiArrayToUint32Vector(obj.Get("cpuAffinity").As<Napi::Array>());
+    }
+    
+    if (obj.Has("numaAware") && obj.Get("numaAware").IsBoolean()) {
+        options.numa_aware = obj.Get("numaAware").As<Napi::Boolean>().Value();
+    }
+    
+    if (obj.Has("includeDirectorySize") && obj.Get("includeDirectorySize").IsBoolean()) {
+        options.include_directory_size = obj.Get("includeDirectorySize").As<Napi::Boolean>().Value();
+    }
+    
+    if (obj.Has("pipelineListers") && obj.Get("pipelineListers").IsNumber()) {
+        options.pipeline_listers = obj.Get("pipelineListers").As<Napi::Number>().Uint32Value();
+    }
+    
+    if (obj.Has("pipelineStatWorkers") && obj.Get("pipelineStatWorkers").IsNumber()) {
+        options.pipeline_stat_workers = obj.Get("pipelineStatWorkers").As<Napi::Number>().Uint32Value();
+    }
+    
+    if (obj.Has("pipelineQueueDepth") && obj.Get("pipelineQueueDepth").IsNumber()) {
+        options.pipeline_queue_depth = obj.Get("pipelineQueueDepth").As<Napi::Number>().Uint32Value();
+    }
+    
+    if (obj.Has("operationTimeoutMs") && obj.Get("operationTimeoutMs").IsNumber()) {
+        options.operation_timeout_ms = obj.Get("operationTimeoutMs").As<Napi::Number>().Uint32Value();
+    }
+    
+    if (obj.Has("coalesce") && obj.Get("coalesce").IsBoolean()) {
+        options.coalesce = obj.Get("coalesce").As<Napi::Boolean>().Value();
+    }
+    
+    if (obj.Has("coalesceTtlMs") && obj.Get("coalesceTtlMs").IsNumber()) {
+        options.coalesce_ttl_ms = obj.Get("coalesceTtlMs").As<Napi::Number>().Uint32Value();
+    }
+    
+    if (obj.Has("priority") && obj.Get("priority").IsString()) {
+        std::string priority = obj.Get("priority").As<Napi::String>().Utf8Value();
+        if (priority == "interactive") {
+            options.priority = ScanPriority::INTERACTIVE;
+        } else if (priority == "batch") {
+            options.priority = ScanPriority::BATCH;
+        } else {
+            options.priority = ScanPriority::NORMAL;
+        }
+    }
+    
+    if (obj.Has("projectQuota") && obj.Get("projectQuota").IsBoolean()) {
+        options.project_quota = obj.Get("projectQuota").As<Napi::Boolean>().Value();
+    }
+    
     return options;
 }
 
+/**
+ * 将延迟直方图转换为百分位统计对象（单位：微秒）
+ */
+Napi::Object latencyHistogramToNapiObject(const Napi::Env& env, const LatencyHistogram& histogram) {
+    Napi::Object obj = Napi::Object::New(env);
+    
+    obj.Set("count", Napi::Number::New(env, static_cast<double>(histogram.count())));
+    obj.Set("meanUs", Napi::Number::New(env, histogram.mean() / 1000.0));
+    obj.Set("p50Us", Napi::Number::New(env, histogram.percentile(50) / 1000.0));
+    obj.Set("p99Us", Napi::Number::New(env, histogram.percentile(99) / 1000.0));
+    obj.Set("p999Us", Napi::Number::New(env, histogram.percentile(99.9) / 1000.0));
+    obj.Set("maxUs", Napi::Number::New(env, histogram.max() / 1000.0));
+    
+    return obj;
+}
+
+/**
+ * 将目录树形状统计转换为 Napi 对象
+ */
+Napi::Object treeShapeToNapiObject(const Napi::Env& env, const TreeShape& shape) {
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("entries", Napi::Number::New(env, static_cast<double>(shape.entries())));
+    obj.Set("directories", Napi::Number::New(env, static_cast<double>(shape.directories())));
+    
+    const std::vector<uint64_t>& depth_counts = shape.depthCounts();
+    Napi::Array depth_array = Napi::Array::New(env, depth_counts.size());
+    for (size_t i = 0; i < depth_counts.size(); ++i) {
+        depth_array[i] = Napi::Number::New(env, static_cast<double>(depth_counts[i]));
+    }
+    Napi::Object depth = Napi::Object::New(env);
+    depth.Set("counts", depth_array);
+    depth.Set("mean", Napi::Number::New(env, shape.depthMean()));
+    depth.Set("max", Napi::Number::New(env, depth_counts.empty() ? 0 : static_cast<double>(depth_counts.size() - 1)));
+    obj.Set("depth", depth);
+    
+    // 只输出非空的扇出桶，上界不超过实际最大值
+    const std::vector<uint64_t>& fanout_counts = shape.fanoutCounts();
+    Napi::Array buckets = Napi::Array::New(env);
+    uint32_t bucket_index = 0;
+    for (uint32_t i = 0; i < fanout_counts.size(); ++i) {
+        if (fanout_counts[i] == 0) {
+            continue;
+        }
+        Napi::Object bucket = Napi::Object::New(env);
+        bucket.Set("min", Napi::Number::New(env, static_cast<double>(TreeShape::fanoutBucketMin(i))));
+        bucket.Set("max", Napi::Number::New(env, static_cast<double>(
+            std::min(TreeShape::fanoutBucketMax(i), shape.fanoutMax()))));
+        bucket.Set("count", Napi::Number::New(env, static_cast<double>(fanout_counts[i])));
+        buckets[bucket_index++] = bucket;
+    }
+    Napi::Object fanout = Napi::Object::New(env);
+    fanout.Set("buckets", buckets);
+    fanout.Set("mean", Napi::Number::New(env, shape.fanoutMean()));
+    fanout.Set("p50", Napi::Number::New(env, static_cast<double>(shape.fanoutPercentile(50))));
+    fanout.Set("p90", Napi::Number::New(env, static_cast<double>(shape.fanoutPercentile(90))));
+    fanout.Set("p99", Napi::Number::New(env, static_cast<double>(shape.fanoutPercentile(99))));
+    fanout.Set("max", Napi::Number::New(env, static_cast<double>(shape.fanoutMax())));
+    obj.Set("fanOut", fanout);
+    
+    Napi::Object path_length = Napi::Object::New(env);
+    path_length.Set("mean", Napi::Number::New(env, shape.pathLengthMean()));
+    path_length.Set("p50", Napi::Number::New(env, static_cast<double>(shape.pathLengthPercentile(50))));
+    path_length.Set("p90", Napi::Number::New(env, static_cast<double>(shape.pathLengthPercentile(90))));
+    path_length.Set("p99", Napi::Number::New(env, static_cast<double>(shape.pathLengthPercentile(99))));
+    path_length.Set("max", Napi::Number::New(env, static_cast<double>(shape.pathLengthMax())));
+    obj.Set("pathLength", path_length);
+    
+    const std::vector<ShapeDirectory>& largest = shape.largestDirectories();
+    Napi::Array largest_array = Napi::Array::New(env, largest.size());
+    for (size_t i = 0; i < largest.size(); ++i) {
+        Napi::Object directory = Napi::Object::New(env);
+        directory.Set("path", Napi::String::New(env, largest[i].path));
+        directory.Set("entryCount", Napi::Number::New(env, static_cast<double>(largest[i].entry_count)));
+        largest_array[i] = directory;
+    }
+    obj.Set("largestDirectories", largest_array);
+    
+    const std::vector<std::string>& longest = shape.longestPaths();
+    Napi::Array longest_array = Napi::Array::New(env, longest.size());
+    for (size_t i = 0; i < longest.size(); ++i) {
+        Napi::Object path = Napi::Object::New(env);
+        path.Set("path", Napi::String::New(env, longest[i]));
+        path.Set("length", Napi::Number::New(env, static_cast<double>(longest[i].size())));
+        longest_array[i] = path;
+    }
+    obj.Set("longestPaths", longest_array);
+    
+    return obj;
+}
+
+/**
+ * 将内存用量快照转换为 Napi 对象（单位：字节）
+ */
+Napi::Object memoryUsageToNapiObject(const Napi::Env& env, const MemoryUsage& usage) {
+    static const char* const names[] = {"inodeSet", "treeNodes", "strings", "buffers", "queues"};
+    
+    auto figureToObject = [&env](const MemoryFigure& figure) {
+        Napi::Object figure_obj = Napi::Object::New(env);
+        figure_obj.Set("current", Napi::Number::New(env, static_cast<double>(figure.current)));
+        figure_obj.Set("peak", Napi::Number::New(env, static_cast<double>(figure.peak)));
+        return figure_obj;
+    };
+    
+    Napi::Object obj = Napi::Object::New(env);
+    Napi::Object subsystems = Napi::Object::New(env);
+    for (int i = 0; i < static_cast<int>(MemorySubsystem::COUNT); ++i) {
+        subsystems.Set(names[i], figureToObject(usage.subsystems[i]));
+    }
+    
+    obj.Set("current", Napi::Number::New(env, static_cast<double>(usage.total.current)));
+    obj.Set("peak", Napi::Number::New(env, static_cast<double>(usage.total.peak)));
+    obj.Set("limit", Napi::Number::New(env, static_cast<double>(usage.limit)));
+    obj.Set("degraded", Napi::Boolean::New(env, usage.degraded));
+    obj.Set("subsystems", subsystems);
+    
+    return obj;
+}
+
 /**
  * 将 CalculationResult 转换为 Napi 对象
  */
@@ -73,6 +318,97 @@ Napi::Object calculationResultToNapiObject(const Napi::Env& env, const Calculati
     obj.Set("fileCount", Napi::Number::New(env, result.file_count));
     obj.Set("directoryCount", Napi::Number::New(env, result.directory_count));
     obj.Set("linkCount", Napi::Number::New(env, result.link_count));
+    obj.Set("durationMs", Napi::Number::New(env, static_cast<double>(result.duration_ms)));
+    
+    Napi::Array errors = Napi::Array::New(env, result.errors.size());
+    for (size_t i = 0; i < result.errors.size(); ++i) {
+        errors[i] = Napi::String::New(env, result.errors[i]);
+    }
+    obj.Set("errors", errors);
+    
+    Napi::Array timed_out = Napi::Array::New(env, result.timed_out.size());
+    for (size_t i = 0; i < result.timed_out.size(); ++i) {
+        timed_out[i] = Napi::String::New(env, result.timed_out[i]);
+    }
+    obj.Set("timedOut", timed_out);
+    obj.Set("coalesced", Napi::Boolean::New(env, result.coalesced));
+    obj.Set("newestModifiedTime", Napi::BigInt::New(env, result.newest_modified_time));
+    obj.Set("newestAccessedTime", Napi::BigInt::New(env, result.newest_accessed_time));
+    
+    if (result.quota.used) {
+        Napi::Object quota = Napi::Object::New(env);
+        quota.Set("projectId", Napi::Number::New(env, result.quota.project_id));
+        quota.Set("spaceBytes", Napi::BigInt::New(env, result.quota.space_bytes));
+        quota.Set("inodes", Napi::Number::New(env, static_cast<double>(result.quota.inodes)));
+        obj.Set("quota", quota);
+    } else {
+        obj.Set("quota", env.Null());
+    }
+    
+    Napi::Array groups = Napi::Array::New(env, result.duplicate_groups.size());
+    for (size_t i = 0; i < result.duplicate_groups.size(); ++i) {
+        const DuplicateGroup& group = result.duplicate_groups[i];
+        Napi::Object group_obj = Napi::Object::New(env);
+        
+        group_obj.Set("hash", Napi::String::New(env, Fingerprint::toHex(group.structure_hash)));
+        group_obj.Set("size", Napi::BigInt::New(env, group.size));
+        group_obj.Set("fileCount", Napi::Number::New(env, group.file_count));
+        group_obj.Set("redundantSize", Napi::BigInt::New(env, group.redundant_size));
+        
+        Napi::Array paths = Napi::Array::New(env, group.paths.size());
+        for (size_t j = 0; j < group.paths.size(); ++j) {
+            paths[j] = Napi::String::New(env, group.paths[j]);
+        }
+        group_obj.Set("paths", paths);
+        
+        groups[i] = group_obj;
+    }
+    obj.Set("duplicateGroups", groups);
+    obj.Set("redundantSize", Napi::BigInt::New(env, result.redundant_size));
+    
+    Napi::Array packages = Napi::Array::New(env, result.packages.size());
+    for (size_t i = 0; i < result.packages.size(); ++i) {
+        const PackageInfo& package = result.packages[i];
+        Napi::Object package_obj = Napi::Object::New(env);
+        
+        package_obj.Set("name", Napi::String::New(env, package.name));
+        package_obj.Set("version", Napi::String::New(env, package.version));
+        package_obj.Set("path", Napi::String::New(env, package.path));
+        package_obj.Set("size", Napi::BigInt::New(env, package.size));
+        package_obj.Set("fileCount", Napi::Number::New(env, package.file_count));
+        package_obj.Set("depth", Napi::Number::New(env, package.depth));
+        package_obj.Set("newestModifiedTime", Napi::BigInt::New(env, package.newest_modified_time));
+        package_obj.Set("newestAccessedTime", Napi::BigInt::New(env, package.newest_accessed_time));
+        
+        packages[i] = package_obj;
+    }
+    obj.Set("packages", packages);
+    
+    Napi::Array slow_directories = Napi::Array::New(env, result.slow_directories.size());
+    for (size_t i = 0; i < result.slow_directories.size(); ++i) {
+        const SlowDirectory& slow = result.slow_directories[i];
+        Napi::Object slow_obj = Napi::Object::New(env);
+        double total_ms = slow.totalMicros() / 1000.0;
+        
+        slow_obj.Set("path", Napi::String::New(env, slow.path));
+        slow_obj.Set("listMs", Napi::Number::New(env, slow.list_us / 1000.0));
+        slow_obj.Set("statMs", Napi::Number::New(env, slow.stat_us / 1000.0));
+        slow_obj.Set("totalMs", Napi::Number::New(env, total_ms));
+        slow_obj.Set("entryCount", Napi::Number::New(env, slow.entry_count));
+        slow_obj.Set("msPerEntry", Napi::Number::New(env, slow.entry_count > 0 ? total_ms / slow.entry_count : total_ms));
+        
+        slow_directories[i] = slow_obj;
+    }
+    obj.Set("slowDirectories", slow_directories);
+    
+    Napi::Object syscall_latency = Napi::Object::New(env);
+    syscall_latency.Set("getdents64", latencyHistogramToNapiObject(env, result.syscall_latency.of(SyscallType::GETDENTS)));
+    syscall_latency.Set("stat", latencyHistogramToNapiObject(env, result.syscall_latency.of(SyscallType::STAT)));
+    syscall_latency.Set("open", latencyHistogramToNapiObject(env, result.syscall_latency.of(SyscallType::OPEN)));
+    syscall_latency.Set("close", latencyHistogramToNapiObject(env, result.syscall_latency.of(SyscallType::CLOSE)));
+    obj.Set("syscallLatency", syscall_latency);
+    obj.Set("shape", treeShapeToNapiObject(env, result.shape));
+    obj.Set("memory", memoryUsageToNapiObject(env, result.memory));
     
     return obj;
 }
@@ -117,6 +453,9 @@ Napi::Object treeNodeToNapiObject(const Napi::Env& env, const std::shared_ptr<Tr
     obj.Set("item", fileSystemItemToNapiObject(env, node->item));
     obj.Set("totalSize", Napi::BigInt::New(env, node->total_size));
     obj.Set("depth", Napi::Number::New(env, node->depth));
+    obj.Set("fingerprint", Napi::String::New(env, Fingerprint::toHex(node->fingerprint)));
+    obj.Set("newestModifiedTime", Napi::BigInt::New(env, node->newest_modified_time));
+    obj.Set("newestAccessedTime", Napi::BigInt::New(env, node->newest_accessed_time));
     
     // 转换子节点
     Napi::Array children = Napi::Array::New(env, node->children.size());
@@ -135,25 +474,53 @@ Napi::Value InitializeAccelerator(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
     
     try {
-#ifdef PLATFORM_WINDOWS
-        g_accelerator = std::make_unique<WindowsAccelerator>();
-        return Napi::Boolean::New(env, true);
-#elif defined(PLATFORM_LINUX)
-        g_accelerator = std::make_unique<LinuxSyscallAccelerator>();
-        return Napi::Boolean::New(env, true);
-#elif defined(PLATFORM_MACOS)
-        g_accelerator = std::make_unique<MacOSSyscallAccelerator>();
+        g_accelerator = createPlatformAccelerator();
+        if (!g_accelerator) {
+            Napi::TypeError::New(env, "Unsupported platform").ThrowAsJavaScriptException();
+            return env.Null();
+        }
         return Napi::Boolean::New(env, true);
-#else
-        Napi::TypeError::New(env, "Unsupported platform").ThrowAsJavaScriptException();
-        return env.Null();
-#endif
     } catch (const std::exception& e) {
         Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
         return env.Null();
     }
 }
 
+/**
+ * 生成请求合并键
+ * Deferred 只能在创建它的环境中完成，键中加入环境标识，各 worker_threads 互不合并
+ * @param env 环境
+ * @param path 扫描路径
+ * @param options 配置选项
+ * @return 合并键
+ */
+static std::string coalescingKey(Napi::Env env, const std::string& path, const CalculationOptions& options) {
+    return ScanCoalescer::makeKey(path, options) + '\0' +
+           std::to_string(reinterpret_cast<uintptr_t>(static_cast<napi_env>(env)));
+}
+
+/**
+ * 执行一次文件夹大小计算并计入进程级指标
+ * @param accelerator 加速器
+ * @param path 文件夹路径
+ * @param options 计算选项
+ * @return 计算结果
+ */
+static CalculationResult runCalculation(FilesystemAccelerator& accelerator, const std::string& path,
+                                        const CalculationOptions& options) {
+    uint64_t start_time = Utils::getCurrentTimestamp();
+    try {
+        CalculationResult result = accelerator.calculateFolderSize(path, options);
+        ProcessMetrics::instance().recordScan(MetricOperation::CALCULATE, result.duration_ms, false);
+        ProcessMetrics::instance().recordResult(result);
+        return result;
+    } catch (...) {
+        ProcessMetrics::instance().recordScan(MetricOperation::CALCULATE,
+                                              Utils::getCurrentTimestamp() - start_time, true);
+        throw;
+    }
+}
+
 /**
  * 计算文件夹大小
  */
@@ -178,7 +545,18 @@ Napi::Value CalculateFolderSize(const Napi::CallbackInfo& info) {
     }
     
     try {
-        CalculationResult result = g_accelerator->calculateFolderSize(path, options);
+        // 同步调用不能等待进行中的异步扫描，只复用未过期的缓存结果
+        std::string key = options.coalesce ? coalescingKey(env, path, options) : std::string();
+        CalculationResult result;
+        if (!key.empty() && ScanCoalescer::instance().lookup(key, result)) {
+            ProcessMetrics::instance().recordCoalesced();
+            return calculationResultToNapiObject(env, result);
+        }
+        
+        result = runCalculation(*g_accelerator, path, options);
+        if (!key.empty()) {
+            ScanCoalescer::instance().store(key, result, options.coalesce_ttl_ms);
+        }
         return calculationResultToNapiObject(env, result);
     } catch (const std::exception& e) {
         Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
@@ -186,6 +564,176 @@ Napi::Value CalculateFolderSize(const Napi::CallbackInfo& info) {
     }
 }
 
+/**
+ * 异步计算文件夹大小的工作线程
+ * 每个任务持有独立的加速器实例，扫描期间可通过 getMemoryUsage 实时查询内存用量；
+ * 启用请求合并时，完成后同时通知加入本次扫描的相同请求
+ */
+class CalculateFolderSizeWorker : public Napi::AsyncWorker {
+private:
+    Napi::Promise::Deferred deferred_;
+    std::unique_ptr<FilesystemAccelerator> accelerator_;
+    std::string path_;
+    CalculationOptions options_;
+    CalculationResult result_;
+    std::string coalesce_key_;    // 请求合并键（为空表示不合并）
+
+public:
+    CalculateFolderSizeWorker(Napi::Env env, std::unique_ptr<FilesystemAccelerator> accelerator,
+                              const std::string& path, const CalculationOptions& options,
+                              const std::string& coalesce_key)
+        : Napi::AsyncWorker(env),
+          deferred_(Napi::Promise::Deferred::New(env)),
+          accelerator_(std::move(accelerator)),
+          path_(path),
+          options_(options),
+          coalesce_key_(coalesce_key) {}
+
+    Napi::Promise GetPromise() { return deferred_.Promise(); }
+
+    void Execute() override {
+        try {
+            result_ = runCalculation(*accelerator_, path_, options_);
+        } catch (const std::exception& e) {
+            SetError(e.what());
+        }
+    }
+
+    void OnOK() override {
+        if (!coalesce_key_.empty()) {
+            ScanCoalescer::instance().complete(coalesce_key_, &result_, std::string(), options_.coalesce_ttl_ms);
+        }
+        deferred_.Resolve(calculationResultToNapiObject(Env(), result_));
+    }
+
+    void OnError(const Napi::Error& error) override {
+        if (!coalesce_key_.empty()) {
+            ScanCoalescer::instance().complete(coalesce_key_, nullptr, error.Message(), 0);
+        }
+        deferred_.Reject(error.Value());
+    }
+};
+
+/**
+ * 异步计算文件夹大小
+ */
+Napi::Value CalculateFolderSizeAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 1 || !info[0].IsString()) {
+        Napi::TypeError::New(env, "Expected string path").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    std::string path = info[0].As<Napi::String>().Utf8Value();
+    CalculationOptions options;
+    
+    if (info.Length() > 1 && info[1].IsObject()) {
+        options = parseCalculationOptions(info[1].As<Napi::Object>());
+    }
+    
+    std::string key;
+    if (options.coalesce) {
+        key = coalescingKey(env, path, options);
+        
+        CalculationResult cached;
+        if (ScanCoalescer::instance().lookup(key, cached)) {
+            ProcessMetrics::instance().recordCoalesced();
+            Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+            deferred.Resolve(calculationResultToNapiObject(env, cached));
+            return deferred.Promise();
+        }
+        
+        // 已有相同的扫描进行中：加入并等待其结果（回调在发起者的 OnOK/OnError 中、同一环境的主线程上执行）
+        auto deferred = std::make_shared<Napi::Promise::Deferred>(Napi::Promise::Deferred::New(env));
+        bool joined = ScanCoalescer::instance().joinOrLead(key,
+            [env, deferred](const CalculationResult* result, const std::string& error) {
+                Napi::HandleScope scope(env);
+                if (result) {
+                    deferred->Resolve(calculationResultToNapiObject(env, *result));
+                } else {
+                    deferred->Reject(Napi::Error::New(env, error).Value());
+                }
+            });
+        if (joined) {
+            ProcessMetrics::instance().recordCoalesced();
+            return deferred->Promise();
+        }
+    }
+    
+    // 只有发起扫描的请求才创建加速器，命中缓存或加入进行中扫描的请求不分配
+    std::unique_ptr<FilesystemAccelerator> accelerator = createPlatformAccelerator();
+    if (!accelerator) {
+        if (!key.empty()) {
+            // 已登记为发起者，释放登记，否则之后的相同请求会一直等待
+            ScanCoalescer::instance().complete(key, nullptr, "Unsupported platform", 0);
+        }
+        Napi::TypeError::New(env, "Unsupported platform").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    auto* worker = new CalculateFolderSizeWorker(env, std::move(accelerator), path, options, key);
+    Napi::Promise promise = worker->GetPromise();
+    worker->Queue();
+    return promise;
+}
+
+/**
+ * 获取进行中扫描的内存用量：当前用量合计与各扫描的快照
+ */
+Napi::Value GetMemoryUsage(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    std::vector<MemoryUsage> usages = MemoryAccounting::snapshotActive();
+    
+    uint64_t current = 0;
+    Napi::Array scans = Napi::Array::New(env, usages.size());
+    for (size_t i = 0; i < usages.size(); ++i) {
+        current += usages[i].total.current;
+        scans.Set(static_cast<uint32_t>(i), memoryUsageToNapiObject(env, usages[i]));
+    }
+    
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("current", Napi::Number::New(env, static_cast<double>(current)));
+    obj.Set("scans", scans);
+    return obj;
+}
+
+/**
+ * 设置所有扫描共享的执行槽位数
+ */
+Napi::Value SetSchedulerCapacity(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 1 || !info[0].IsNumber()) {
+        Napi::TypeError::New(env, "Expected number capacity").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    ScanScheduler::instance().setCapacity(info[0].As<Napi::Number>().Uint32Value());
+    return env.Undefined();
+}
+
+/**
+ * 获取扫描调度器状态
+ */
+Napi::Value GetSchedulerStats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    ScanScheduler& scheduler = ScanScheduler::instance();
+    
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("capacity", Napi::Number::New(env, scheduler.capacity()));
+    obj.Set("active", Napi::Number::New(env, scheduler.active()));
+    obj.Set("waiting", Napi::Number::New(env, scheduler.waiting()));
+    return obj;
+}
+
+/**
+ * 获取进程级累计指标（OpenMetrics 文本格式）
+ */
+Napi::Value GetMetrics(const Napi::CallbackInfo& info) {
+    return Napi::String::New(info.Env(), ProcessMetrics::instance().render());
+}
+
 /**
  * 构建目录树
  */
@@ -209,15 +757,505 @@ Napi::Value BuildDirectoryTree(const Napi::CallbackInfo& info) {
         options = parseCalculationOptions(info[1].As<Napi::Object>());
     }
     
+    uint64_t start_time = Utils::getCurrentTimestamp();
     try {
         auto tree = g_accelerator->buildDirectoryTree(path, options);
+        ProcessMetrics::instance().recordScan(MetricOperation::TREE, Utils::getCurrentTimestamp() - start_time, false);
         return treeNodeToNapiObject(env, tree);
+    } catch (const std::exception& e) {
+        ProcessMetrics::instance().recordScan(MetricOperation::TREE, Utils::getCurrentTimestamp() - start_time, true);
+        Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+}
+
+/**
+ * 创建导出目标
+ * @param destination_path 目标文件路径（为空时写入 destination_fd）
+ * @param destination_fd 目标文件描述符
+ * @param format 导出格式（'json' | 'ndjson' | 'snapshot'）
+ * @return 导出目标
+ */
+static std::unique_ptr<TreeSink> createExportSink(const std::string& destination_path, int destination_fd,
+                                                  const std::string& format) {
+    if (format == "snapshot") {
+        return destination_path.empty() ? std::make_unique<SnapshotWriter>(destination_fd)
+                                        : std::make_unique<SnapshotWriter>(destination_path);
+    }
+    
+    ExportFormat text_format = format == "ndjson" ? ExportFormat::NDJSON : ExportFormat::JSON;
+    return destination_path.empty() ? std::make_unique<TreeExportWriter>(destination_fd, text_format)
+                                    : std::make_unique<TreeExportWriter>(destination_path, text_format);
+}
+
+/**
+ * 异步导出目录树的工作线程
+ * 遍历时逐个节点写入文件，不构建 JS 对象树
+ */
+class ExportDirectoryTreeWorker : public Napi::AsyncWorker {
+private:
+    Napi::Promise::Deferred deferred_;
+    std::unique_ptr<FilesystemAccelerator> accelerator_;
+    std::string path_;
+    std::string destination_path_;  // 目标文件路径（为空时写入 destination_fd_）
+    int destination_fd_;            // 目标文件描述符（由调用方负责关闭）
+    std::string format_;
+    CalculationOptions options_;
+    uint64_t entry_count_;
+    uint64_t bytes_written_;
+    uint64_t duration_ms_;
+    MemoryUsage memory_;
+
+public:
+    ExportDirectoryTreeWorker(Napi::Env env, std::unique_ptr<FilesystemAccelerator> accelerator,
+                              const std::string& path, const std::string& destination_path,
+                              int destination_fd, const std::string& format, const CalculationOptions& options)
+        : Napi::AsyncWorker(env),
+          deferred_(Napi::Promise::Deferred::New(env)),
+          accelerator_(std::move(accelerator)),
+          path_(path),
+          destination_path_(destination_path),
+          destination_fd_(destination_fd),
+          format_(format),
+          options_(options),
+          entry_count_(0),
+          bytes_written_(0),
+          duration_ms_(0) {}
+
+    Napi::Promise GetPromise() { return deferred_.Promise(); }
+
+    void Execute() override {
+        uint64_t start_time = Utils::getCurrentTimestamp();
+        bool failed = false;
+        try {
+            std::unique_ptr<TreeSink> sink = createExportSink(destination_path_, destination_fd_, format_);
+            accelerator_->exportDirectoryTree(path_, options_, *sink);
+            sink->finish();
+            entry_count_ = sink->entryCount();
+            bytes_written_ = sink->bytesWritten();
+        } catch (const std::exception& e) {
+            failed = true;
+            SetError(e.what());
+        }
+        memory_ = accelerator_->getMemoryUsage();
+        duration_ms_ = Utils::getCurrentTimestamp() - start_time;
+        ProcessMetrics::instance().recordScan(MetricOperation::EXPORT, duration_ms_, failed);
+    }
+
+    void OnOK() override {
+        Napi::Env env = Env();
+        Napi::Object obj = Napi::Object::New(env);
+        obj.Set("entryCount", Napi::Number::New(env, static_cast<double>(entry_count_)));
+        obj.Set("bytesWritten", Napi::Number::New(env, static_cast<double>(bytes_written_)));
+        obj.Set("durationMs", Napi::Number::New(env, static_cast<double>(duration_ms_)));
+        obj.Set("memory", memoryUsageToNapiObject(env, memory_));
+        deferred_.Resolve(obj);
+    }
+
+    void OnError(const Napi::Error& error) override {
+        deferred_.Reject(error.Value());
+    }
+};
+
+/**
+ * 异步导出目录树到文件（路径或文件描述符），格式为嵌套 JSON、NDJSON 或列式快照
+ */
+Napi::Value ExportDirectoryTreeAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 1 || !info[0].IsString()) {
+        Napi::TypeError::New(env, "Expected string path").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    if (info.Length() < 2 || !(info[1].IsString() || info[1].IsNumber())) {
+        Napi::TypeError::New(env, "Expected destination path or file descriptor").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    std::string path = info[0].As<Napi::String>().Utf8Value();
+    std::string destination_path;
+    int destination_fd = -1;
+    if (info[1].IsString()) {
+        destination_path = info[1].As<Napi::String>().Utf8Value();
+    } else {
+        destination_fd = info[1].As<Napi::Number>().Int32Value();
+    }
+    
+    CalculationOptions options;
+    std::string format = "json";
+    
+    if (info.Length() > 2 && info[2].IsObject()) {
+        Napi::Object obj = info[2].As<Napi::Object>();
+        options = parseCalculationOptions(obj);
+        if (obj.Has("exportFormat") && obj.Get("exportFormat").IsString()) {
+            format = obj.Get("exportFormat").As<Napi::String>().Utf8Value();
+        }
+    }
+    
+    if (format != "json" && format != "ndjson" && format != "snapshot") {
+        Napi::TypeError::New(env, "Unknown exportFormat: " + format).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    std::unique_ptr<FilesystemAccelerator> accelerator = createPlatformAccelerator();
+    if (!accelerator) {
+        Napi::TypeError::New(env, "Unsupported platform").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    auto* worker = new ExportDirectoryTreeWorker(env, std::move(accelerator), path, destination_path,
+                                                 destination_fd, format, options);
+    Napi::Promise promise = worker->GetPromise();
+    worker->Queue();
+    return promise;
+}
+
+/**
+ * 将快照查询从 Napi 对象转换为 C++ 结构
+ * @param env 环境
+ * @param obj 查询对象
+ * @param query 输出的查询
+ * @return 是否成功（groupBy 或 type 无法识别时抛出 TypeError 并返回 false）
+ */
+bool parseSnapshotQuery(Napi::Env env, const Napi::Object& obj, SnapshotQuery& query) {
+    if (obj.Has("groupBy") && obj.Get("groupBy").IsString()) {
+        std::string group_by = obj.Get("groupBy").As<Napi::String>().Utf8Value();
+        if (group_by == "none") {
+            query.group_by = SnapshotGroupBy::NONE;
+        } else if (group_by == "depth") {
+            query.group_by = SnapshotGroupBy::DEPTH;
+        } else if (group_by == "extension") {
+            query.group_by = SnapshotGroupBy::EXTENSION;
+        } else if (group_by == "owner") {
+            query.group_by = SnapshotGroupBy::OWNER;
+        } else if (group_by == "mtime") {
+            query.group_by = SnapshotGroupBy::MODIFIED_TIME;
+        } else if (group_by == "type") {
+            query.group_by = SnapshotGroupBy::TYPE;
+        } else {
+            Napi::TypeError::New(env, "Unknown groupBy: " + group_by).ThrowAsJavaScriptException();
+            return false;
+        }
+    }
+    
+    if (obj.Has("timeBucketMs") && obj.Get("timeBucketMs").IsNumber()) {
+        query.time_bucket_ms = static_cast<uint64_t>(obj.Get("timeBucketMs").As<Napi::Number>().Int64Value());
+    }
+    
+    if (obj.Has("pathPrefix") && obj.Get("pathPrefix").IsString()) {
+        query.path_prefix = obj.Get("pathPrefix").As<Napi::String>().Utf8Value();
+    }
+    
+    if (obj.Has("minSize") && obj.Get("minSize").IsNumber()) {
+        query.min_size = static_cast<uint64_t>(obj.Get("minSize").As<Napi::Number>().Int64Value());
+    }
+    
+    if (obj.Has("maxSize") && obj.Get("maxSize").IsNumber()) {
+        query.max_size = static_cast<uint64_t>(obj.Get("maxSize").As<Napi::Number>().Int64Value());
+    }
+    
+    if (obj.Has("type") && obj.Get("type").IsString()) {
+        std::string type = obj.Get("type").As<Napi::String>().Utf8Value();
+        query.filter_type = true;
+        if (type == "file") {
+            query.type = ItemType::FILE;
+        } else if (type == "directory") {
+            query.type = ItemType::DIRECTORY;
+        } else if (type == "symlink") {
+            query.type = ItemType::SYMBOLIC_LINK;
+        } else {
+            Napi::TypeError::New(env, "Unknown type: " + type).ThrowAsJavaScriptException();
+            return false;
+        }
+    }
+    
+    if (obj.Has("threads") && obj.Get("threads").IsNumber()) {
+        query.threads = obj.Get("threads").As<Napi::Number>().Uint32Value();
+    }
+    
+    return true;
+}
+
+/**
+ * 异步查询快照的工作线程
+ */
+class QuerySnapshotWorker : public Napi::AsyncWorker {
+private:
+    Napi::Promise::Deferred deferred_;
+    std::string snapshot_path_;
+    SnapshotQuery query_;
+    SnapshotQueryResult result_;
+    std::vector<std::string> extension_names_;  // 扩展名分组的键（与结果行一一对应）
+
+public:
+    QuerySnapshotWorker(Napi::Env env, const std::string& snapshot_path, const SnapshotQuery& query)
+        : Napi::AsyncWorker(env),
+          deferred_(Napi::Promise::Deferred::New(env)),
+          snapshot_path_(snapshot_path),
+          query_(query) {}
+
+    Napi::Promise GetPromise() { return deferred_.Promise(); }
+
+    void Execute() override {
+        try {
+            std::shared_ptr<const SnapshotReader> reader = SnapshotReader::openShared(snapshot_path_);
+            result_ = SnapshotQueryEngine::execute(*reader, query_);
+            if (query_.group_by == SnapshotGroupBy::EXTENSION) {
+                for (const auto& row : result_.rows) {
+                    extension_names_.push_back(reader->extensionName(static_cast<uint32_t>(row.key)));
+                }
+            }
+        } catch (const std::exception& e) {
+            SetError(e.what());
+        }
+    }
+
+    void OnOK() override {
+        static const char* const type_names[] = {"file", "directory", "symlink", "unknown"};
+        Napi::Env env = Env();
+        
+        Napi::Array rows = Napi::Array::New(env, result_.rows.size());
+        for (size_t i = 0; i < result_.rows.size(); ++i) {
+            const SnapshotAggregate& aggregate = result_.rows[i];
+            Napi::Object row = Napi::Object::New(env);
+            
+            switch (query_.group_by) {
+                case SnapshotGroupBy::NONE:
+                    row.Set("key", env.Null());
+                    break;
+                case SnapshotGroupBy::EXTENSION:
+                    row.Set("key", Napi::String::New(env, extension_names_[i]));
+                    break;
+                case SnapshotGroupBy::TYPE:
+                    row.Set("key", Napi::String::New(env, type_names[aggregate.key]));
+                    break;
+                default:
+                    row.Set("key", Napi::Number::New(env, static_cast<double>(aggregate.key)));
+                    break;
+            }
+            row.Set("count", Napi::Number::New(env, static_cast<double>(aggregate.count)));
+            row.Set("size", Napi::BigInt::New(env, aggregate.size));
+            row.Set("totalSize", Napi::BigInt::New(env, aggregate.total_size));
+            rows[i] = row;
+        }
+        
+        Napi::Object obj = Napi::Object::New(env);
+        obj.Set("rows", rows);
+        obj.Set("scannedRows", Napi::Number::New(env, static_cast<double>(result_.scanned_rows)));
+        obj.Set("matchedRows", Napi::Number::New(env, static_cast<double>(result_.matched_rows)));
+        obj.Set("prefixFound", Napi::Boolean::New(env, result_.prefix_found));
+        obj.Set("durationMs", Napi::Number::New(env, result_.duration_us / 1000.0));
+        deferred_.Resolve(obj);
+    }
+
+    void OnError(const Napi::Error& error) override {
+        deferred_.Reject(error.Value());
+    }
+};
+
+/**
+ * 异步对列式快照执行聚合查询
+ */
+Napi::Value QuerySnapshotAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 1 || !info[0].IsString()) {
+        Napi::TypeError::New(env, "Expected string snapshot path").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    std::string snapshot_path = info[0].As<Napi::String>().Utf8Value();
+    SnapshotQuery query;
+    
+    if (info.Length() > 1 && info[1].IsObject() && !parseSnapshotQuery(env, info[1].As<Napi::Object>(), query)) {
+        return env.Null();
+    }
+    
+    auto* worker = new QuerySnapshotWorker(env, snapshot_path, query);
+    Napi::Promise promise = worker->GetPromise();
+    worker->Queue();
+    return promise;
+}
+
+/**
+ * 在快照中查找路径，返回节点信息与子树汇总
+ */
+Napi::Value LookupSnapshotPaths(const Napi::CallbackInfo& info) {
+    static const char* const type_names[] = {"file", "directory", "symlink", "unknown"};
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 2 || !info[0].IsString() || !info[1].IsArray()) {
+        Napi::TypeError::New(env, "Expected string snapshot path and array of paths").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+    std::string snapshot_path = info[0].As<Napi::String>().Utf8Value();
+    Napi::Array paths = info[1].As<Napi::Array>();
+    
+    try {
+        std::shared_ptr<const SnapshotReader> reader = SnapshotReader::openShared(snapshot_path);
+        Napi::Array results = Napi::Array::New(env, paths.Length());
+        
+        for (uint32_t i = 0; i < paths.Length(); ++i) {
+            Napi::Value value = paths.Get(i);
+            uint64_t row = 0;
+            if (!value.IsString() || !reader->locate(value.As<Napi::String>().Utf8Value(), row)) {
+                results.Set(i, env.Null());
+                continue;
+            }
+            
+            uint8_t type = reader->value8(row, snapshot::TYPE);
+            Napi::Object node = Napi::Object::New(env);
+            node.Set("path", value);
+            node.Set("type", Napi::String::New(env, type_names[type < 4 ? type : 3]));
+            node.Set("size", Napi::BigInt::New(env, reader->value64(row, snapshot::SIZE)));
+            node.Set("totalSize", Napi::BigInt::New(env, reader->value64(row, snapshot::TOTAL_SIZE)));
+            node.Set("descendants", Napi::Number::New(env, static_cast<double>(reader->value64(row, snapshot::DESCENDANTS))));
+            node.Set("modifiedTime", Napi::BigInt::New(env, reader->value64(row, snapshot::MODIFIED_TIME)));
+            node.Set("fingerprint", Napi::BigInt::New(env, reader->value64(row, snapshot::FINGERPRINT)));
+            results.Set(i, node);
+        }
+        
+        return results;
     } catch (const std::exception& e) {
         Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
         return env.Null();
     }
 }
 
+#ifdef PLATFORM_LINUX
+/**
+ * 将内容摘要选项从 Napi 对象转换为 C++ 结构
+ */
+ContentDigestOptions parseContentDigestOptions(const Napi::Object& obj) {
+    ContentDigestOptions options;
+    
+    if (obj.Has("threads") && obj.Get("threads").IsNumber()) {
+        options.threads = obj.Get("threads").As<Napi::Number>().Uint32Value();
+    }
+    
+    if (obj.Has("readSize") && obj.Get("readSize").IsNumber()) {
+        options.read_size = obj.Get("readSize").As<Napi::Number>().Uint32Value();
+    }
+    
+    if (obj.Has("includeHidden") && obj.Get("includeHidden").IsBoolean()) {
+        options.include_hidden = obj.Get("includeHidden").As<Napi::Boolean>().Value();
+    }
+    
+    if (obj.Has("ignorePatterns") && obj.Get("ignorePatterns").IsArray()) {
+        options.ignore_patterns = napiArrayToStringVector(obj.Get("ignorePatterns").As<Napi::Array>());
+    }
+    
+    if (obj.Has("includeFiles") && obj.Get("includeFiles").IsBoolean()) {
+        options.include_files = obj.Get("includeFiles").As<Napi::Boolean>().Value();
+    }
+    
+    if (obj.Has("dropCache") && obj.Get("dropCache").IsBoolean()) {
+        options.drop_cache = obj.Get("dropCache").As<Napi::Boolean>().Value();
+    }
+    
+    return options;
+}
+
+/**
+ * 异步计算目录树内容摘要的工作线程
+ */
+class ContentDigestWorker : public Napi::AsyncWorker {
+private:
+    Napi::Promise::Deferred deferred_;
+    std::string path_;
+    ContentDigestOptions options_;
+    ContentDigestResult result_;
+
+public:
+    ContentDigestWorker(Napi::Env env, const std::string& path, const ContentDigestOptions& options)
+        : Napi::AsyncWorker(env),
+          deferred_(Napi::Promise::Deferred::New(env)),
+          path_(path),
+          options_(options) {}
+
+    Napi::Promise GetPromise() { return deferred_.Promise(); }
+
+    void Execute() override {
+        try {
+            result_ = ContentDigester::digest(path_, options_);
+        } catch (const std::exception& e) {
+            SetError(e.what());
+        }
+    }
+
+    void OnOK() override {
+        static const char* const type_names[] = {"file", "directory", "symlink", "unknown"};
+        Napi::Env env = Env();
+        
+        Napi::Array entries = Napi::Array::New(env, result_.entries.size());
+        for (size_t i = 0; i < result_.entries.size(); ++i) {
+            const ContentDigestEntry& entry = result_.entries[i];
+            Napi::Object item = Napi::Object::New(env);
+            item.Set("path", Napi::String::New(env, entry.path));
+            item.Set("type", Napi::String::New(env, type_names[static_cast<int>(entry.type)]));
+            item.Set("size", Napi::Number::New(env, static_cast<double>(entry.size)));
+            item.Set("digest", Napi::String::New(env, Blake3Hasher::toHex(entry.digest)));
+            entries[i] = item;
+        }
+        
+        Napi::Array errors = Napi::Array::New(env, result_.errors.size());
+        for (size_t i = 0; i < result_.errors.size(); ++i) {
+            errors[i] = Napi::String::New(env, result_.errors[i]);
+        }
+        
+        Napi::Object obj = Napi::Object::New(env);
+        obj.Set("algorithm", Napi::String::New(env, "blake3"));
+        obj.Set("digest", Napi::String::New(env, Blake3Hasher::toHex(result_.digest)));
+        obj.Set("entries", entries);
+        obj.Set("fileCount", Napi::Number::New(env, static_cast<double>(result_.file_count)));
+        obj.Set("directoryCount", Napi::Number::New(env, static_cast<double>(result_.directory_count)));
+        obj.Set("linkCount", Napi::Number::New(env, static_cast<double>(result_.symlink_count)));
+        obj.Set("bytesHashed", Napi::Number::New(env, static_cast<double>(result_.bytes_hashed)));
+        obj.Set("threads", Napi::Number::New(env, result_.threads));
+        obj.Set("simd", Napi::String::New(env, Blake3Hasher::implementation()));
+        obj.Set("durationMs", Napi::Number::New(env, static_cast<double>(result_.duration_ms)));
+        obj.Set("errors", errors);
+        deferred_.Resolve(obj);
+    }
+
+    void OnError(const Napi::Error& error) override {
+        deferred_.Reject(error.Value());
+    }
+};
+#endif
+
+/**
+ * 异步计算目录树（或单个文件）的内容摘要（BLAKE3 Merkle 树）
+ */
+Napi::Value ContentDigestAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    
+    if (info.Length() < 1 || !info[0].IsString()) {
+        Napi::TypeError::New(env, "Expected string path").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    
+#ifdef PLATFORM_LINUX
+    std::string path = info[0].As<Napi::String>().Utf8Value();
+    ContentDigestOptions options;
+    
+    if (info.Length() > 1 && info[1].IsObject()) {
+        options = parseContentDigestOptions(info[1].As<Napi::Object>());
+    }
+    
+    auto* worker = new ContentDigestWorker(env, path, options);
+    Napi::Promise promise = worker->GetPromise();
+    worker->Queue();
+    return promise;
+#else
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    deferred.Reject(Napi::Error::New(env, "Content digest is not supported on this platform").Value());
+    return deferred.Promise();
+#endif
+}
+
 /**
  * 检查路径是否存在
  */
@@ -293,7 +1331,16 @@ Napi::Value CleanupAccelerator(const Napi::CallbackInfo& info) {
 Napi::Object Init(Napi::Env env, Napi::Object exports) {
     exports.Set("initializeAccelerator", Napi::Function::New(env, InitializeAccelerator));
     exports.Set("calculateFolderSize", Napi::Function::New(env, CalculateFolderSize));
+    exports.Set("calculateFolderSizeAsync", Napi::Function::New(env, CalculateFolderSizeAsync));
+    exports.Set("getMemoryUsage", Napi::Function::New(env, GetMemoryUsage));
+    exports.Set("setSchedulerCapacity", Napi::Function::New(env, SetSchedulerCapacity));
+    exports.Set("getSchedulerStats", Napi::Function::New(env, GetSchedulerStats));
+    exports.Set("getMetrics", Napi::Function::New(env, GetMetrics));
     exports.Set("buildDirectoryTree", Napi::Function::New(env, BuildDirectoryTree));
+    exports.Set("exportDirectoryTreeAsync", Napi::Function::New(env, ExportDirectoryTreeAsync));
+    exports.Set("querySnapshotAsync", Napi::Function::New(env, QuerySnapshotAsync));
+    exports.Set("lookupSnapshotPaths", Napi::Function::New(env, LookupSnapshotPaths));
+    exports.Set("contentDigestAsync", Napi::Function::New(env, ContentDigestAsync));
     exports.Set("pathExists", Napi::Function::New(env, PathExists));
     exports.Set("getItemInfo", Napi::Function::New(env, GetItemInfo));
     exports.Set("cleanupAccelerator", Napi::Function::New(env, CleanupAccelerator));
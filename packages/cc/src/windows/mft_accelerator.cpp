@@ -2,6 +2,8 @@
 
 #ifdef PLATFORM_WINDOWS
 
+#include "../common/fingerprint.h"
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <cstdio>
@@ -11,6 +13,19 @@
 namespace brisk {
 namespace filesystem {
 
+namespace {
+
+/**
+ * FILETIME（1601 年起的 100 纳秒数）转换为毫秒时间戳，早于 1970 年时为 0
+ */
+uint64_t fileTimeToMillis(const FILETIME& time) {
+    const uint64_t EPOCH_DIFFERENCE = 116444736000000000ull;
+    uint64_t ticks = (static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+    return ticks > EPOCH_DIFFERENCE ? (ticks - EPOCH_DIFFERENCE) / 10000 : 0;
+}
+
+} // namespace
+
 WindowsAccelerator::WindowsAccelerator() {
 }
 
@@ -28,6 +43,19 @@ CalculationResult WindowsAccelerator::calculateFolderSize(
         if (options.inode_check) {
             processed_inodes_.clear();
         }
+        memory_.reset(options.memory_limit);
+        ActiveMemoryScope active(memory_);
+        
+        // 根目录自身的修改时间计入汇总（与 Linux 一致）
+        WIN32_FILE_ATTRIBUTE_DATA root_data;
+        if (GetFileAttributesExA(path.c_str(), GetFileExInfoStandard, &root_data)) {
+            result.newest_modified_time = fileTimeToMillis(root_data.ftLastWriteTime);
+        }
+        
+        // 与其他并发扫描共享执行槽位
+        ScanClient client(options.priority, ScanScheduler::instance());
+        scan_client_ = &client;
+        ScanSlot slot(scan_client_);
         
         // 递归计算目录大小
         calculateDirectorySizeRecursive(path, options, result, 0);
@@ -35,7 +63,9 @@ CalculationResult WindowsAccelerator::calculateFolderSize(
     } catch (const std::exception&) {
         // 忽略错误，保持与 core 包行为一致
     }
+    scan_client_ = nullptr;
     
+    result.memory = memory_.snapshot();
     return result;
 }
 
@@ -63,6 +93,12 @@ std::shared_ptr<TreeNode> WindowsAccelerator::buildDirectoryTree(
     root_node->item.size = (static_cast<uint64_t>(find_data.nFileSizeHigh) << 32) | 
                           find_data.nFileSizeLow;
     root_node->depth = 0;
+    // 只构建根节点，子树汇总即根节点自身的时间
+    root_node->newest_modified_time = fileTimeToMillis(find_data.ftLastWriteTime);
+    root_node->newest_accessed_time = root_node->item.type == ItemType::DIRECTORY ?
+                                      0 : fileTimeToMillis(find_data.ftLastAccessTime);
+    root_node->fingerprint = Fingerprint::ofEntry(
+        root_node->item.name, root_node->item.type, root_node->item.size, root_node->item.modified_time);
     
     return root_node;
 }
@@ -113,6 +149,11 @@ void WindowsAccelerator::calculateDirectorySizeRecursive(
         return;
     }
     
+    // 调度点：有服务量更少的扫描在等待时让出槽位
+    if (scan_client_) {
+        scan_client_->checkpoint();
+    }
+    
     // 使用 Windows API 列出目录内容
     std::string search_path = path + "\\*";
     WIN32_FIND_DATAA find_data;
@@ -152,11 +193,21 @@ void WindowsAccelerator::calculateDirectorySizeRecursive(
             if (!inode_id.empty() && processed_inodes_.count(inode_id)) {
                 continue;  // 跳过已处理的硬链接，完全不处理
             }
-            if (!inode_id.empty()) {
+            // 超出内存上限后不再扩大去重集合
+            if (!inode_id.empty() && !memory_.degraded()) {
                 processed_inodes_.insert(inode_id);
+                memory_.allocate(MemorySubsystem::INODE_SET, MemoryAccounting::stringBytes(inode_id.size()) + 2 * sizeof(void*));
             }
         }
         
+        // 汇总最新时间：修改时间含目录，访问时间只统计文件与链接（列目录会更新目录的访问时间）
+        result.newest_modified_time = std::max(result.newest_modified_time,
+                                               fileTimeToMillis(find_data.ftLastWriteTime));
+        if (!is_directory || is_symlink) {
+            result.newest_accessed_time = std::max(result.newest_accessed_time,
+                                                   fileTimeToMillis(find_data.ftLastAccessTime));
+        }
+        
         if (is_symlink) {
             // 符号链接：统计数量，根据 include_link 配置决定是否计入大小
             result.link_count++;
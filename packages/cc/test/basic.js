@@ -1,45 +1,206 @@
-const { createAccelerator, isNativeAccelerationSupported, getPlatform } = require('../index.js');
+const {
+  createAccelerator,
+  isNativeAccelerationSupported,
+  getPlatform,
+  lookupSnapshotPaths,
+  contentDigestAsync
+} = require('../index.js');
+const assert = require('assert');
+const fs = require('fs');
 const path = require('path');
 const os = require('os');
 
+// BLAKE3 测试向量（与 b3sum 的输出一致）
+const BLAKE3_ABC = '6437b3ac38465133ffb63b75273a8db548c558465d79db03fd359c6cd5bd9d85';
+const BLAKE3_1025 = 'd00278ae47eb27b34faecf67b4fe263f82d5412916c1ffd97c8cb7fb814b8444';
+
+/**
+ * 生成 0, 1, ..., 250, 0, 1, ... 循环的字节（BLAKE3 官方测试向量的输入）
+ */
+function patternBytes(length) {
+  const buffer = Buffer.alloc(length);
+  for (let i = 0; i < length; i++) {
+    buffer[i] = i % 251;
+  }
+  return buffer;
+}
+
+/**
+ * 创建内容与时间均已知的测试目录
+ *
+ * root/
+ *   a.txt          'hello'
+ *   sub/
+ *     b.bin        1025 字节
+ *     deep/
+ *       c.txt      'abc'
+ *
+ * 时间均设为整秒，目录的修改时间在创建全部子项之后设置
+ */
+function createFixture() {
+  const root = fs.mkdtempSync(path.join(os.tmpdir(), 'brisk-cc-test-'));
+  const sub = path.join(root, 'sub');
+  const deep = path.join(sub, 'deep');
+  fs.mkdirSync(deep, { recursive: true });
+  fs.writeFileSync(path.join(root, 'a.txt'), 'hello');
+  fs.writeFileSync(path.join(sub, 'b.bin'), patternBytes(1025));
+  fs.writeFileSync(path.join(deep, 'c.txt'), 'abc');
+
+  // 访问时间与修改时间（秒），均早于当前时间一天以上；file 标记参与访问时间汇总的文件
+  const times = {
+    'a.txt': { atime: 1600000300, mtime: 1600000100, file: true },
+    'sub/b.bin': { atime: 1600000200, mtime: 1600000400, file: true },
+    'sub/deep/c.txt': { atime: 1600000900, mtime: 1600000000, file: true },
+    'sub/deep': { atime: 1600000000, mtime: 1600000500, file: false },
+    'sub': { atime: 1600000000, mtime: 1600000600, file: false },
+    '.': { atime: 1600000000, mtime: 1600000050, file: false }
+  };
+  for (const [relative, { atime, mtime }] of Object.entries(times)) {
+    fs.utimesSync(path.join(root, relative), atime, mtime);
+  }
+
+  return { root, sub, deep, times };
+}
+
+/**
+ * 按设定的时间手工计算子树的最新修改 / 访问时间（毫秒时间戳字符串）
+ * 修改时间包含目录自身，访问时间只统计文件
+ */
+function expectedRollup(times, prefix) {
+  let modified = 0;
+  let accessed = 0;
+  for (const [relative, { atime, mtime, file }] of Object.entries(times)) {
+    const inside = prefix === '.' || relative === prefix || relative.startsWith(prefix + '/');
+    if (!inside) {
+      continue;
+    }
+    modified = Math.max(modified, mtime);
+    if (file) {
+      accessed = Math.max(accessed, atime);
+    }
+  }
+  return { newestModifiedTime: String(modified * 1000), newestAccessedTime: String(accessed * 1000) };
+}
+
 async function runBasicTests() {
   console.log('🧪 Running C++ Extension Basic Tests');
   console.log('=====================================');
-  
+
   // 平台信息
-  console.log(`📟 Platform: ${getPlatform()}`);
+  const platform = getPlatform();
+  console.log(`📟 Platform: ${platform}`);
   console.log(`🏃 Native acceleration supported: ${isNativeAccelerationSupported()}`);
-  
+
+  if (!isNativeAccelerationSupported()) {
+    console.log('⚠️  Native acceleration not supported, skipping tests');
+    return;
+  }
+
+  const fixture = createFixture();
+  const { root, sub, deep, times } = fixture;
+
   try {
     // 创建加速器
     console.log('\n📦 Creating accelerator...');
     const accelerator = createAccelerator();
     console.log('✅ Accelerator created successfully');
-    
+
     // 测试计算文件夹大小
     console.log('\n📏 Testing folder size calculation...');
+    const sta = Date.now();
+    const options = { includeDirectorySize: true };
+    const result = accelerator.calculateFolderSize(root, options);
+    console.log('📈 Calculation result:', result.totalSize, result.fileCount, result.directoryCount);
+    console.log((Date.now() - sta) / 1000);
+    assert.strictEqual(result.fileCount, 3);
+    assert.strictEqual(result.directoryCount, 3);
+    console.log('✅ Folder size calculated');
+
+    // 流水线模式与按目录递归遍历的结果一致
+    console.log('\n🚰 Testing pipeline mode...');
+    const pipelined = accelerator.calculateFolderSize(root, { ...options, pipelineListers: 2, pipelineStatWorkers: 2 });
+    for (const key of ['totalSize', 'fileCount', 'directoryCount', 'linkCount', 'newestModifiedTime', 'newestAccessedTime']) {
+      assert.strictEqual(pipelined[key], result[key], `pipeline ${key}`);
+    }
+    console.log('✅ Pipeline totals match recursive totals');
+
+    // 冷数据汇总与手工计算的值一致
+    console.log('\n🧊 Testing newest time rollups...');
+    const rootRollup = expectedRollup(times, '.');
+    assert.strictEqual(result.newestModifiedTime, rootRollup.newestModifiedTime);
+    assert.strictEqual(result.newestAccessedTime, rootRollup.newestAccessedTime);
+
+    const tree = accelerator.buildDirectoryTree(root);
+    assert.strictEqual(tree.totalSize, result.totalSize);
+    assert.strictEqual(tree.newestModifiedTime, rootRollup.newestModifiedTime);
+    assert.strictEqual(tree.newestAccessedTime, rootRollup.newestAccessedTime);
+    if (platform !== 'windows') {
+      // Windows 引擎的 buildDirectoryTree 只返回根节点
+      const subNode = tree.children.find(node => node.item.path === sub);
+      const deepNode = subNode.children.find(node => node.item.path === deep);
+      assert.deepStrictEqual(
+        { newestModifiedTime: subNode.newestModifiedTime, newestAccessedTime: subNode.newestAccessedTime },
+        expectedRollup(times, 'sub')
+      );
+      assert.deepStrictEqual(
+        { newestModifiedTime: deepNode.newestModifiedTime, newestAccessedTime: deepNode.newestAccessedTime },
+        expectedRollup(times, 'sub/deep')
+      );
+    }
+    console.log('✅ Rollups match hand-computed values');
+
+    // JSON 导出与 JSON.stringify(buildDirectoryTree()) 的结构一致
+    console.log('\n📤 Testing JSON export...');
+    const exportDir = fs.mkdtempSync(path.join(os.tmpdir(), 'brisk-cc-export-'));
     try {
-      const sta = Date.now()
-      const tempDir = 'D:\\BeiQiProjects\\BJJL\\bj-jljc-admin\\node_modules';
-      const result = accelerator.calculateFolderSize(tempDir);
-      
-      console.log('📈 Calculation result:', result);
-      console.log((Date.now() - sta) / 1000);
-    } catch (error) {
-      console.log('⚠️  Folder size calculation failed:', error.message);
+      const jsonPath = path.join(exportDir, 'tree.json');
+      const exported = await accelerator.exportDirectoryTreeAsync(root, jsonPath, { exportFormat: 'json' });
+      assert.ok(exported.entryCount > 0);
+      assert.deepStrictEqual(
+        JSON.parse(fs.readFileSync(jsonPath, 'utf8')),
+        JSON.parse(JSON.stringify(accelerator.buildDirectoryTree(root)))
+      );
+      console.log('✅ JSON export round-trips against buildDirectoryTree');
+
+      // 快照中查找根目录得到的子树大小与计算结果一致
+      console.log('\n🗂️  Testing snapshot lookup...');
+      const snapshotPath = path.join(exportDir, 'tree.snapshot');
+      await accelerator.exportDirectoryTreeAsync(root, snapshotPath, { exportFormat: 'snapshot' });
+      const node = lookupSnapshotPaths(snapshotPath, root);
+      assert.ok(node, 'root not found in snapshot');
+      assert.strictEqual(node.type, 'directory');
+      assert.strictEqual(node.totalSize, result.totalSize);
+      assert.strictEqual(lookupSnapshotPaths(snapshotPath, path.join(root, 'missing')), null);
+      console.log('✅ Snapshot lookup agrees with totalSize');
+    } finally {
+      fs.rmSync(exportDir, { recursive: true, force: true });
+    }
+
+    // 内容摘要（读取文件会更新访问时间，放在时间检查之后）
+    if (platform === 'linux') {
+      console.log('\n🔐 Testing content digest...');
+      const abc = await contentDigestAsync(path.join(deep, 'c.txt'));
+      assert.deepStrictEqual(abc.errors, []);
+      assert.strictEqual(abc.fileCount, 1);
+      assert.strictEqual(abc.digest, BLAKE3_ABC);
+      const multiChunk = await contentDigestAsync(path.join(sub, 'b.bin'));
+      assert.strictEqual(multiChunk.digest, BLAKE3_1025);
+      console.log('✅ Content digest matches BLAKE3 test vectors');
     }
-    
+
     // 清理
     console.log('\n🧹 Cleaning up...');
     accelerator.cleanup();
     console.log('✅ Cleanup completed');
-    
+
     console.log('\n🎉 All tests completed successfully!');
-    
+
   } catch (error) {
     console.error('❌ Test failed:', error.message);
     console.error(error.stack);
-    process.exit(1);
+    process.exitCode = 1;
+  } finally {
+    fs.rmSync(root, { recursive: true, force: true });
   }
 }
 
@@ -48,4 +209,4 @@ if (require.main === module) {
   runBasicTests().catch(console.error);
 }
 
-module.exports = { runBasicTests }; 
\ No newline at end of file
+module.exports = { runBasicTests };
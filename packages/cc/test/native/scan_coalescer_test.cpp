@@ -0,0 +1,129 @@
+#include "test_support.h"
+
+#include "common/scan_coalescer.h"
+
+#include <chrono>
+#include <thread>
+
+using namespace brisk::filesystem;
+
+namespace {
+
+/**
+ * 记录回调收到的结果
+ */
+struct Received {
+    int calls = 0;
+    bool has_result = false;
+    uint64_t total_size = 0;
+    bool coalesced = false;
+    std::string error;
+
+    ScanCoalescer::Waiter waiter() {
+        return [this](const CalculationResult* result, const std::string& message) {
+            calls++;
+            has_result = result != nullptr;
+            if (result) {
+                total_size = result->total_size;
+                coalesced = result->coalesced;
+            }
+            error = message;
+        };
+    }
+};
+
+/**
+ * 发起者登记时传入的回调（发起扫描时不会被调用）
+ */
+ScanCoalescer::Waiter ignored() {
+    return [](const CalculationResult*, const std::string&) {};
+}
+
+CalculationResult resultOfSize(uint64_t total_size) {
+    CalculationResult result;
+    result.total_size = total_size;
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("requests arriving during a scan join it and share its result") {
+    ScanCoalescer coalescer;
+    Received first;
+    Received second;
+
+    CHECK(!coalescer.joinOrLead("key", ignored()));
+    CHECK(coalescer.joinOrLead("key", first.waiter()));
+    CHECK(coalescer.joinOrLead("key", second.waiter()));
+    CHECK_EQ(first.calls, 0);
+
+    CalculationResult result = resultOfSize(42);
+    coalescer.complete("key", &result, std::string(), 0);
+
+    for (const Received* received : {&first, &second}) {
+        CHECK_EQ(received->calls, 1);
+        CHECK(received->has_result);
+        CHECK_EQ(received->total_size, 42u);
+        CHECK(received->coalesced);
+    }
+    // 发起者自己的结果不标记为合并
+    CHECK(!result.coalesced);
+
+    // 完成后相同的请求发起新的扫描，不同的键互不影响
+    CHECK(!coalescer.joinOrLead("key", ignored()));
+    CHECK(!coalescer.joinOrLead("other", ignored()));
+}
+
+TEST_CASE("completed results are served from the cache until the TTL expires") {
+    ScanCoalescer coalescer;
+    CalculationResult result = resultOfSize(7);
+    CalculationResult cached;
+
+    CHECK(!coalescer.joinOrLead("uncached", ignored()));
+    coalescer.complete("uncached", &result, std::string(), 0);
+    CHECK(!coalescer.lookup("uncached", cached));
+
+    CHECK(!coalescer.joinOrLead("key", ignored()));
+    coalescer.complete("key", &result, std::string(), 50);
+    CHECK(coalescer.lookup("key", cached));
+    CHECK_EQ(cached.total_size, 7u);
+    CHECK(cached.coalesced);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(80));
+    CHECK(!coalescer.lookup("key", cached));
+}
+
+TEST_CASE("a failed scan rejects every waiter and is not cached") {
+    ScanCoalescer coalescer;
+    Received waiter;
+
+    CHECK(!coalescer.joinOrLead("key", ignored()));
+    CHECK(coalescer.joinOrLead("key", waiter.waiter()));
+    coalescer.complete("key", nullptr, "Path not found: /missing", 1000);
+
+    CHECK_EQ(waiter.calls, 1);
+    CHECK(!waiter.has_result);
+    CHECK_EQ(waiter.error, std::string("Path not found: /missing"));
+
+    CalculationResult cached;
+    CHECK(!coalescer.lookup("key", cached));
+    CHECK(!coalescer.joinOrLead("key", ignored()));
+}
+
+TEST_CASE("keys normalize the path and separate options that change the result") {
+    CalculationOptions options;
+    CHECK_EQ(ScanCoalescer::makeKey("/data/./a//", options), ScanCoalescer::makeKey("/data/a", options));
+    CHECK(ScanCoalescer::makeKey("/data/a/..", options) != ScanCoalescer::makeKey("/data", options));
+
+    CalculationOptions hidden = options;
+    hidden.include_hidden = !options.include_hidden;
+    CHECK(ScanCoalescer::makeKey("/data", hidden) != ScanCoalescer::makeKey("/data", options));
+
+    CalculationOptions ignores = options;
+    ignores.ignore_patterns = {"a b"};
+    CalculationOptions split = options;
+    split.ignore_patterns = {"a", "b"};
+    CHECK(ScanCoalescer::makeKey("/data", ignores) != ScanCoalescer::makeKey("/data", split));
+}
+
+NATIVE_TEST_MAIN()
@@ -0,0 +1,159 @@
+#include "test_support.h"
+
+#include "linux/scan_pipeline.h"
+
+#include <fcntl.h>
+#include <sys/syscall.h>
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <thread>
+
+using namespace brisk::filesystem;
+
+namespace {
+
+constexpr uint32_t TIMEOUT_MS = 50;
+constexpr auto STALL = std::chrono::milliseconds(400);
+
+/**
+ * 在指定的路径上阻塞的流水线，模拟失联挂载点上挂起的系统调用
+ * 桩函数在阻塞前读完成员，阻塞返回后流水线可能已经销毁
+ */
+class StallingPipeline : public ScanPipeline {
+public:
+    enum class Stage { OPEN, READ, STAT };
+
+private:
+    Stage stage_;
+    std::string target_;    // 阻塞的目录路径（OPEN / READ）或目录项名称（STAT）
+
+public:
+    StallingPipeline(LinuxSyscallAccelerator& accelerator, const CalculationOptions& options, Stage stage,
+                     std::string target)
+        : ScanPipeline(accelerator, options), stage_(stage), target_(std::move(target)) {}
+
+protected:
+    int openDirectory(const std::string& path) override {
+        if (stage_ == Stage::OPEN && path == target_) {
+            std::this_thread::sleep_for(STALL);
+        }
+        return open(path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    }
+
+    long readEntries(int fd, char* buffer, size_t size) override {
+        if (stage_ == Stage::READ && pathOf(fd) == target_) {
+            std::this_thread::sleep_for(STALL);
+        }
+        return syscall(SYS_getdents64, fd, buffer, size);
+    }
+
+    int statEntry(int dir_fd, const std::string& name, struct stat& st, int flags) override {
+        if (stage_ == Stage::STAT && name == target_) {
+            std::this_thread::sleep_for(STALL);
+        }
+        return fstatat(dir_fd, name.c_str(), &st, flags);
+    }
+
+private:
+    static std::string pathOf(int fd) {
+        char link[PATH_MAX];
+        ssize_t length = readlink(("/proc/self/fd/" + std::to_string(fd)).c_str(), link, sizeof(link));
+        return length > 0 ? std::string(link, static_cast<size_t>(length)) : std::string();
+    }
+};
+
+class StallingAccelerator : public LinuxSyscallAccelerator {
+private:
+    StallingPipeline::Stage stage_;
+    std::string target_;
+
+public:
+    StallingAccelerator(StallingPipeline::Stage stage, std::string target)
+        : stage_(stage), target_(std::move(target)) {}
+
+protected:
+    std::unique_ptr<ScanPipeline> createPipeline(const CalculationOptions& options) override {
+        return std::make_unique<StallingPipeline>(*this, options, stage_, target_);
+    }
+};
+
+/**
+ * 单个列目录线程与单个 stat 线程，阻塞的线程必须由接替线程完成剩余工作
+ */
+CalculationOptions watchedOptions() {
+    CalculationOptions options;
+    options.operation_timeout_ms = TIMEOUT_MS;
+    options.pipeline_listers = 1;
+    options.pipeline_stat_workers = 1;
+    return options;
+}
+
+CalculationResult scan(StallingPipeline::Stage stage, const std::string& target, const std::string& root) {
+    StallingAccelerator accelerator(stage, target);
+    CalculationResult result = accelerator.calculateFolderSize(root, watchedOptions());
+    // 等待被放弃的线程返回后再删除测试目录
+    std::this_thread::sleep_for(STALL);
+    return result;
+}
+
+bool hasError(const CalculationResult& result, const std::string& error) {
+    return std::find(result.errors.begin(), result.errors.end(), error) != result.errors.end();
+}
+
+void checkNoLeakedMemory(const CalculationResult& result) {
+    CHECK_EQ(result.memory.of(MemorySubsystem::BUFFERS).current, 0u);
+    CHECK_EQ(result.memory.of(MemorySubsystem::QUEUES).current, 0u);
+}
+
+} // namespace
+
+TEST_CASE("stuck stat skips only the blocked entry and requeues the rest of its batch") {
+    native_test::TempDir dir;
+    dir.mkdir("d");
+    for (int i = 0; i < 5; ++i) {
+        dir.write("d/f" + std::to_string(i), "0123456789");
+    }
+    dir.write("top", "0123456789");
+
+    CalculationResult result = scan(StallingPipeline::Stage::STAT, "f2", dir.path());
+
+    CHECK_EQ(result.file_count, 5u);
+    CHECK_EQ(result.total_size, 50u);
+    CHECK_EQ(result.timed_out, std::vector<std::string>{dir.path() + "/d/f2"});
+    CHECK(hasError(result, "Operation timed out: " + dir.path() + "/d/f2"));
+    checkNoLeakedMemory(result);
+}
+
+TEST_CASE("stuck getdents64 abandons the directory and releases the lister buffer") {
+    native_test::TempDir dir;
+    dir.mkdir("slow");
+    dir.write("slow/x", "0123456789");
+    dir.mkdir("ok");
+    dir.write("ok/y", "01234");
+
+    CalculationResult result = scan(StallingPipeline::Stage::READ, dir.path() + "/slow", dir.path());
+
+    CHECK_EQ(result.file_count, 1u);
+    CHECK_EQ(result.total_size, 5u);
+    CHECK_EQ(result.timed_out, std::vector<std::string>{dir.path() + "/slow"});
+    checkNoLeakedMemory(result);
+}
+
+TEST_CASE("stuck open abandons the directory and a replacement lister finishes the scan") {
+    native_test::TempDir dir;
+    dir.mkdir("slow");
+    dir.write("slow/x", "0123456789");
+    dir.mkdir("ok");
+    dir.mkdir("ok/nested");
+    dir.write("ok/nested/y", "01234");
+
+    CalculationResult result = scan(StallingPipeline::Stage::OPEN, dir.path() + "/slow", dir.path());
+
+    CHECK_EQ(result.file_count, 1u);
+    CHECK_EQ(result.total_size, 5u);
+    CHECK_EQ(result.timed_out, std::vector<std::string>{dir.path() + "/slow"});
+    checkNoLeakedMemory(result);
+}
+
+NATIVE_TEST_MAIN()
@@ -0,0 +1,120 @@
+#include "test_support.h"
+
+#include "linux/syscall_accelerator.h"
+#include "common/snapshot_query.h"
+#include "common/snapshot_reader.h"
+#include "common/snapshot_writer.h"
+
+#include <cstring>
+#include <iterator>
+
+using namespace brisk::filesystem;
+
+namespace {
+
+/**
+ * 导出测试目录的快照：root/a.txt、root/d/b.txt
+ */
+std::string writeSnapshot(const native_test::TempDir& dir) {
+    dir.mkdir("tree");
+    dir.write("tree/a.txt", "hello");
+    dir.mkdir("tree/d");
+    dir.write("tree/d/b.txt", "abc");
+
+    std::string path = dir.path() + "/tree.snapshot";
+    LinuxSyscallAccelerator accelerator;
+    SnapshotWriter writer(path);
+    accelerator.exportDirectoryTree(dir.path() + "/tree", CalculationOptions(), writer);
+    writer.finish();
+    return path;
+}
+
+/**
+ * 读取快照文件的全部字节
+ */
+std::string readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+void writeFile(const std::string& path, const std::string& bytes) {
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << bytes;
+}
+
+snapshot::FileFooter footerOf(const std::string& bytes) {
+    snapshot::FileFooter footer;
+    std::memcpy(&footer, bytes.data() + bytes.size() - sizeof(footer), sizeof(footer));
+    return footer;
+}
+
+snapshot::RowGroupEntry firstGroupOf(const std::string& bytes) {
+    snapshot::RowGroupEntry group;
+    std::memcpy(&group, bytes.data() + footerOf(bytes).groups_offset, sizeof(group));
+    return group;
+}
+
+SnapshotQueryResult queryDepth(const std::string& path, uint32_t threads) {
+    SnapshotReader reader(path);
+    SnapshotQuery query;
+    query.group_by = SnapshotGroupBy::DEPTH;
+    query.threads = threads;
+    return SnapshotQueryEngine::execute(reader, query);
+}
+
+} // namespace
+
+TEST_CASE("depth grouping counts every row") {
+    native_test::TempDir dir;
+    SnapshotQueryResult result = queryDepth(writeSnapshot(dir), 1);
+
+    CHECK_EQ(result.rows.size(), 3u);
+    CHECK_EQ(result.matched_rows, 4u);
+    if (result.rows.size() == 3) {
+        CHECK_EQ(result.rows[0].key, 0u);
+        CHECK_EQ(result.rows[1].count, 2u);
+        CHECK_EQ(result.rows[2].key, 2u);
+    }
+}
+
+TEST_CASE("corrupt depth falls back to the sparse map instead of sizing a dense array") {
+    native_test::TempDir dir;
+    std::string path = writeSnapshot(dir);
+    std::string bytes = readFile(path);
+
+    // 将第一行（后序中的第一个文件）的深度改为 0xFFFFFFFF
+    uint32_t corrupt = 0xFFFFFFFFu;
+    std::memcpy(&bytes[firstGroupOf(bytes).columns[snapshot::DEPTH]], &corrupt, sizeof(corrupt));
+    writeFile(path, bytes);
+
+    SnapshotQueryResult result;
+    bool threw = false;
+    try {
+        result = queryDepth(path, 4);
+    } catch (const std::exception&) {
+        threw = true;
+    }
+
+    CHECK(!threw);
+    CHECK_EQ(result.matched_rows, 4u);
+    CHECK(!result.rows.empty() && result.rows.back().key == corrupt && result.rows.back().count == 1);
+}
+
+TEST_CASE("extension count larger than the file is rejected before reserving") {
+    native_test::TempDir dir;
+    std::string path = writeSnapshot(dir);
+    std::string bytes = readFile(path);
+
+    uint32_t corrupt = 0xFFFFFFFFu;
+    std::memcpy(&bytes[footerOf(bytes).dictionary_offset], &corrupt, sizeof(corrupt));
+    writeFile(path, bytes);
+
+    std::string error;
+    try {
+        SnapshotReader reader(path);
+    } catch (const FilesystemException& e) {
+        error = e.what();
+    }
+    CHECK(error.find("bad extension dictionary") != std::string::npos);
+}
+
+NATIVE_TEST_MAIN()
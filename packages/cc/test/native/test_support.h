@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <ftw.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * 原生单元测试的最小支持：检查宏、用例注册与临时目录
+ * 由 scripts/test-native.js 编译运行，失败的检查输出位置并使进程以非零状态退出
+ */
+namespace native_test {
+
+inline int& failures() {
+    static int count = 0;
+    return count;
+}
+
+inline std::vector<std::pair<const char*, std::function<void()>>>& cases() {
+    static std::vector<std::pair<const char*, std::function<void()>>> registered;
+    return registered;
+}
+
+struct Register {
+    Register(const char* name, std::function<void()> body) { cases().emplace_back(name, std::move(body)); }
+};
+
+/**
+ * 运行全部用例
+ * @return 进程退出状态
+ */
+inline int runAll() {
+    for (auto& test_case : cases()) {
+        std::printf("  %s\n", test_case.first);
+        int before = failures();
+        test_case.second();
+        std::printf("  %s %s\n", failures() == before ? "✅" : "❌", test_case.first);
+    }
+    return failures() == 0 ? 0 : 1;
+}
+
+/**
+ * 临时目录（析构时递归删除）
+ */
+class TempDir {
+private:
+    std::string path_;
+
+public:
+    TempDir() {
+        char pattern[] = "/tmp/brisk-cc-native-XXXXXX";
+        const char* created = mkdtemp(pattern);
+        path_ = created ? created : "";
+    }
+
+    ~TempDir() {
+        if (!path_.empty()) {
+            nftw(path_.c_str(), [](const char* file, const struct stat*, int, struct FTW*) { return remove(file); },
+                 16, FTW_DEPTH | FTW_PHYS);
+        }
+    }
+
+    const std::string& path() const { return path_; }
+
+    std::string mkdir(const std::string& relative) const {
+        std::string full = path_ + "/" + relative;
+        ::mkdir(full.c_str(), 0755);
+        return full;
+    }
+
+    std::string write(const std::string& relative, const std::string& content) const {
+        std::string full = path_ + "/" + relative;
+        std::ofstream(full, std::ios::binary) << content;
+        return full;
+    }
+};
+
+} // namespace native_test
+
+#define NATIVE_TEST_CONCAT2(a, b) a##b
+#define NATIVE_TEST_CONCAT(a, b) NATIVE_TEST_CONCAT2(a, b)
+
+#define TEST_CASE(name)                                                                                   \
+    static void NATIVE_TEST_CONCAT(test_body_, __LINE__)();                                               \
+    static native_test::Register NATIVE_TEST_CONCAT(test_register_, __LINE__)(                           \
+        name, NATIVE_TEST_CONCAT(test_body_, __LINE__));                                                  \
+    static void NATIVE_TEST_CONCAT(test_body_, __LINE__)()
+
+#define CHECK(condition)                                                                                  \
+    do {                                                                                                  \
+        if (!(condition)) {                                                                               \
+            std::printf("    %s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition);                 \
+            native_test::failures()++;                                                                    \
+        }                                                                                                 \
+    } while (0)
+
+#define CHECK_EQ(actual, expected)                                                                        \
+    do {                                                                                                  \
+        auto&& check_actual = (actual);                                                                   \
+        auto&& check_expected = (expected);                                                               \
+        if (!(check_actual == check_expected)) {                                                          \
+            std::printf("    %s:%d: CHECK_EQ(%s, %s) failed\n", __FILE__, __LINE__, #actual, #expected);  \
+            native_test::failures()++;                                                                    \
+        }                                                                                                 \
+    } while (0)
+
+#define NATIVE_TEST_MAIN()                                                                                \
+    int main() { return native_test::runAll(); }
@@ -0,0 +1,77 @@
+#include "test_support.h"
+
+#include "linux/syscall_accelerator.h"
+#include "common/tree_export_writer.h"
+
+#include <dirent.h>
+#include <iterator>
+
+using namespace brisk::filesystem;
+
+namespace {
+
+std::string readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+/**
+ * 目录中的文件数（检查临时文件是否残留）
+ */
+size_t countEntries(const std::string& path) {
+    size_t count = 0;
+    if (DIR* dir = opendir(path.c_str())) {
+        while (dirent* entry = readdir(dir)) {
+            std::string name = entry->d_name;
+            count += name != "." && name != "..";
+        }
+        closedir(dir);
+    }
+    return count;
+}
+
+/**
+ * 与 ExportDirectoryTreeWorker 相同的调用顺序：遍历成功后才 finish
+ */
+void exportTree(const std::string& root, const std::string& destination, ExportFormat format) {
+    LinuxSyscallAccelerator accelerator;
+    TreeExportWriter writer(destination, format);
+    accelerator.exportDirectoryTree(root, CalculationOptions(), writer);
+    writer.finish();
+}
+
+} // namespace
+
+TEST_CASE("successful export replaces the destination without leaving a temporary file") {
+    native_test::TempDir dir;
+    dir.mkdir("tree");
+    dir.write("tree/a.txt", "hello");
+    dir.mkdir("out");
+    std::string destination = dir.write("out/tree.ndjson", "previous export\n");
+
+    exportTree(dir.path() + "/tree", destination, ExportFormat::NDJSON);
+
+    std::string exported = readFile(destination);
+    CHECK(exported.find("previous export") == std::string::npos);
+    CHECK(exported.find("\"name\":\"a.txt\"") != std::string::npos);
+    CHECK_EQ(countEntries(dir.path() + "/out"), 1u);
+}
+
+TEST_CASE("failed export keeps the previous destination content") {
+    native_test::TempDir dir;
+    dir.mkdir("out");
+    std::string destination = dir.write("out/tree.json", "previous export\n");
+
+    bool threw = false;
+    try {
+        exportTree(dir.path() + "/missing", destination, ExportFormat::JSON);
+    } catch (const FilesystemException&) {
+        threw = true;
+    }
+
+    CHECK(threw);
+    CHECK_EQ(readFile(destination), std::string("previous export\n"));
+    CHECK_EQ(countEntries(dir.path() + "/out"), 1u);
+}
+
+NATIVE_TEST_MAIN()
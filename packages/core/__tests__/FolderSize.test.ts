@@ -139,6 +139,21 @@ describe('FolderSize', () => {
       expect(result.size.toNumber()).toBeGreaterThan(0);
     });
 
+    it('should report the exact byte total as a BigNumber', async () => {
+      const tempUtil = await TempUtil.of('exactTotal');
+      await tempUtil.write('a.txt', 'a'.repeat(1000));
+      await tempUtil.write('b.txt', 'b'.repeat(2345));
+
+      let expected = (await fs.lstat(tempUtil.dirPath, {bigint: true})).size;
+      for (const name of ['a.txt', 'b.txt']) {
+        expected += (await fs.lstat(join(tempUtil.dirPath, name), {bigint: true})).size;
+      }
+
+      const result = await FolderSize.getSize(tempUtil.dirPath, {backend: 'js'});
+
+      expect(result.size.toFixed()).toBe(expected.toString());
+    });
+
     it('should handle maxDepth option', async () => {
       const tempUtil = await TempUtil.of('maxDepth');
       // 创建深层嵌套结构
@@ -263,5 +278,80 @@ describe('FolderSize', () => {
         expect(result.size.toNumber()).toBeGreaterThan(0);
       }
     });
+
+    it('should cap in-flight filesystem operations across all levels', async () => {
+      const tempUtil = await TempUtil.of('globalConcurrency');
+      // 深度超过并发数的目录结构，每层多个文件
+      let level = tempUtil;
+      for (let i = 0; i < 6; i++) {
+        for (let j = 0; j < 3; j++) {
+          await level.write(`file${j}.txt`, `Content ${i}-${j}`);
+        }
+        level = await level.join(`level${i}`);
+      }
+
+      let inFlight = 0;
+      let maxInFlight = 0;
+      const track = <T extends (...args: any[]) => Promise<any>>(original: T) =>
+        (async (...args: any[]) => {
+          inFlight++;
+          maxInFlight = Math.max(maxInFlight, inFlight);
+          try {
+            return await original(...args);
+          } finally {
+            inFlight--;
+          }
+        }) as unknown as T;
+
+      const lstatSpy = jest.spyOn(fs, 'lstat').mockImplementation(track(fs.lstat.bind(fs)));
+      const opendirSpy = jest.spyOn(fs, 'opendir').mockImplementation(track(fs.opendir.bind(fs)));
+
+      try {
+        const result = await FolderSize.getSize(tempUtil.dirPath, {concurrency: 2, backend: 'js'});
+
+        expect(result.fileCount).toBe(18);
+        expect(result.directoryCount).toBe(6);
+        expect(maxInFlight).toBeLessThanOrEqual(2);
+      } finally {
+        lstatSpy.mockRestore();
+        opendirSpy.mockRestore();
+      }
+    });
+
+    it('should not deadlock on trees deeper than the concurrency limit', async () => {
+      const tempUtil = await TempUtil.of('deepTree');
+      let level = tempUtil;
+      for (let i = 0; i < 8; i++) {
+        level = await level.join(`d${i}`);
+      }
+      await level.write('leaf.txt', 'leaf');
+
+      const result = await FolderSize.getSize(tempUtil.dirPath, {concurrency: 1, backend: 'js'});
+
+      expect(result.fileCount).toBe(1);
+      expect(result.directoryCount).toBe(8);
+    });
+
+    (process.platform === 'win32' ? it.skip : it)('should count symlinks from directory entries without lstat', async () => {
+      const tempUtil = await TempUtil.of('direntSymlink');
+      await tempUtil.write('target.txt', 'target');
+      await fs.symlink(join(tempUtil.dirPath, 'target.txt'), join(tempUtil.dirPath, 'link'));
+
+      const lstatSpy = jest.spyOn(fs, 'lstat');
+      try {
+        const result = await FolderSize.getSize(tempUtil.dirPath, {
+          backend: 'js',
+          includeLink: false,
+          inodeCheck: false
+        });
+
+        expect(result.fileCount).toBe(1);
+        expect(result.linkCount).toBe(1);
+        // 只有根目录与普通文件需要 lstat
+        expect(lstatSpy).toHaveBeenCalledTimes(2);
+      } finally {
+        lstatSpy.mockRestore();
+      }
+    });
   });
 });
@@ -0,0 +1,199 @@
+import {FolderSize} from '../src';
+import {promises as fs, statSync} from 'fs';
+import {join, normalize} from 'path';
+import {TempUtil} from "./TempUtil";
+
+const calculateFolderSize = jest.fn();
+
+jest.mock('@get-folder/cc', () => ({
+  isNativeAccelerationSupported: () => true,
+  createAccelerator: () => ({calculateFolderSize})
+}), {virtual: true});
+
+/**
+ * 加载真实的原生扩展（未安装、未构建或平台不支持时为 null）
+ */
+function loadActualNative(): any {
+  try {
+    const native = jest.requireActual('@get-folder/cc');
+    return native.isNativeAccelerationSupported() ? native : null;
+  } catch (error) {
+    return null;
+  }
+}
+
+/**
+ * 查找两个位于不同设备、inode 号相同的小目录（各虚拟文件系统的根目录通常都是 inode 1）
+ */
+function findSharedInodeRoots(): [string, string] | null {
+  const candidates = ['/dev/shm', '/dev/pts', '/dev/mqueue', '/dev/hugepages'];
+  const stats: { path: string, dev: number, ino: number }[] = [];
+  for (const path of candidates) {
+    try {
+      const stat = statSync(path);
+      stats.push({path, dev: stat.dev, ino: stat.ino});
+    } catch (error) {
+      // 不存在的挂载点跳过
+    }
+  }
+  for (let i = 0; i < stats.length; i++) {
+    for (let j = i + 1; j < stats.length; j++) {
+      if (stats[i].ino === stats[j].ino && stats[i].dev !== stats[j].dev) {
+        return [stats[i].path, stats[j].path];
+      }
+    }
+  }
+  return null;
+}
+
+const actualNative = loadActualNative();
+const sharedInodeRoots = process.platform === 'linux' ? findSharedInodeRoots() : null;
+
+describe('FolderSize native backend', () => {
+  beforeEach(() => {
+    calculateFolderSize.mockReset();
+  });
+
+  it('should map the native result onto FolderSizeResult', async () => {
+    calculateFolderSize.mockReturnValue({
+      totalSize: '12345678901234567890',
+      fileCount: 3,
+      directoryCount: 3,
+      linkCount: 1,
+      errors: []
+    });
+
+    const result = await FolderSize.getSize('/data/', {backend: 'native', maxDepth: 1, concurrency: 4});
+
+    expect(calculateFolderSize).toHaveBeenCalledWith(normalize('/data'), expect.objectContaining({
+      maxDepth: 2,
+      maxThreads: 4,
+      includeDirectorySize: true
+    }));
+    expect(result.size.toFixed()).toBe('12345678901234567890');
+    expect(result.fileCount).toBe(3);
+    expect(result.directoryCount).toBe(2);
+    expect(result.linkCount).toBe(1);
+  });
+
+  it('should pass native errors to onError', async () => {
+    calculateFolderSize.mockReturnValue({
+      totalSize: '0',
+      fileCount: 0,
+      directoryCount: 0,
+      linkCount: 0,
+      errors: ['Cannot access: /data/missing']
+    });
+    const errors: any[] = [];
+
+    await FolderSize.getSize('/data/missing', {
+      backend: 'native',
+      ignoreErrors: true,
+      onError: (error) => {
+        errors.push(error);
+        return true;
+      }
+    });
+
+    expect(errors).toHaveLength(1);
+    expect(errors[0].path).toBe('/data/missing');
+    expect(errors[0].message).toContain('无法获取文件信息');
+  });
+
+  it('should stop when onError returns false', async () => {
+    calculateFolderSize.mockReturnValue({
+      totalSize: '0',
+      fileCount: 0,
+      directoryCount: 0,
+      linkCount: 0,
+      errors: ['Cannot open directory: /data/locked']
+    });
+
+    await expect(FolderSize.getSize('/data', {backend: 'native', onError: () => false}))
+      .rejects.toThrow('计算被用户停止');
+  });
+
+  it('should reject ignores that cannot be mapped in native mode', async () => {
+    await expect(FolderSize.getSize('/data', {backend: 'native', ignores: [/\.LOG$/i]}))
+      .rejects.toThrow();
+    expect(calculateFolderSize).not.toHaveBeenCalled();
+  });
+
+  it('should not use the native backend in js mode', async () => {
+    await FolderSize.getSize(__dirname, {backend: 'js', maxDepth: 0});
+    expect(calculateFolderSize).not.toHaveBeenCalled();
+  });
+
+  it('should report a child that cannot be stat\'ed under its own path', async () => {
+    calculateFolderSize.mockReturnValue({
+      totalSize: '4',
+      fileCount: 1,
+      directoryCount: 1,
+      linkCount: 0,
+      errors: ['Cannot access: /data/dangling']
+    });
+    const errors: any[] = [];
+
+    const result = await FolderSize.getSize('/data', {
+      backend: 'native',
+      ignoreErrors: true,
+      onError: (error) => {
+        errors.push(error);
+        return true;
+      }
+    });
+
+    expect(errors).toHaveLength(1);
+    expect(errors[0].path).toBe('/data/dangling');
+    expect(result.fileCount).toBe(1);
+  });
+});
+
+(actualNative ? describe : describe.skip)('native engine', () => {
+  afterAll(async () => {
+    try {
+      await TempUtil.clearTempDir();
+    } catch (error) {
+      // 忽略清理错误
+    }
+  });
+
+  it('should record an error when a listed child cannot be stat\'ed', async () => {
+    const temp = await TempUtil.of('native-child-stat');
+    await temp.write('file.txt', 'data');
+    const dangling = join(temp.dirPath, 'dangling');
+    await fs.symlink(join(temp.dirPath, 'missing'), dangling);
+
+    const result = actualNative.createAccelerator().calculateFolderSize(temp.dirPath, {followSymlinks: true, maxThreads: 1});
+
+    expect(result.errors).toContain(`Cannot access: ${dangling}`);
+    expect(result.fileCount).toBe(1);
+  });
+
+  it('should count a hard link once when inodeCheck is enabled', async () => {
+    const temp = await TempUtil.of('native-hard-link');
+    await temp.write('file.txt', 'data');
+    await fs.link(join(temp.dirPath, 'file.txt'), join(temp.dirPath, 'link.txt'));
+
+    const result = actualNative.createAccelerator().calculateFolderSize(temp.dirPath, {inodeCheck: true, maxThreads: 1});
+
+    expect(result.fileCount).toBe(1);
+    expect(result.totalSize).toBe('4');
+  });
+
+  (sharedInodeRoots ? it : it.skip)('should not merge files on different devices that share an inode number', async () => {
+    const [first, second] = sharedInodeRoots!;
+    const temp = await TempUtil.of('native-device-inode');
+    await fs.symlink(first, join(temp.dirPath, 'first'));
+    await fs.symlink(second, join(temp.dirPath, 'second'));
+
+    const accelerator = actualNative.createAccelerator();
+    const options = {followSymlinks: true, inodeCheck: true, maxThreads: 1};
+    const combined = accelerator.calculateFolderSize(temp.dirPath, options);
+    const firstOnly = accelerator.calculateFolderSize(first, options);
+    const secondOnly = accelerator.calculateFolderSize(second, options);
+
+    expect(combined.directoryCount).toBe(1 + firstOnly.directoryCount + secondOnly.directoryCount);
+    expect(combined.fileCount).toBe(firstOnly.fileCount + secondOnly.fileCount);
+  });
+});
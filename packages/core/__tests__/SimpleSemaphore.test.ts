@@ -161,4 +161,32 @@ describe('SimpleSemaphore', () => {
     // 应该按FIFO顺序处理
     expect(order).toEqual([1, 2, 3]);
   });
-}); 
\ No newline at end of file
+
+  it('should keep its capacity after handing tokens to waiters', async () => {
+    const semaphore = new SimpleSemaphore(1);
+
+    await semaphore.acquire();
+    const waiter = semaphore.acquire();
+    semaphore.release(); // 令牌转交给等待者
+    await waiter;
+    semaphore.release(); // 归还令牌
+
+    // 令牌应该仍然可以立即获取
+    let acquired = false;
+    semaphore.acquire().then(() => {
+      acquired = true;
+    });
+    await new Promise(resolve => setTimeout(resolve, 10));
+    expect(acquired).toBe(true);
+  });
+
+  it('should release the token when a task fails', async () => {
+    const semaphore = new SimpleSemaphore(1);
+
+    await expect(semaphore.run(async () => {
+      throw new Error('failed');
+    })).rejects.toThrow('failed');
+
+    await expect(semaphore.run(async () => 'ok')).resolves.toBe('ok');
+  });
+});
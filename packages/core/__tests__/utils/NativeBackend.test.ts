@@ -0,0 +1,87 @@
+import {NativeBackend} from '../../src/utils/NativeBackend';
+import {FolderSizeOptions} from '../../src';
+
+describe('NativeBackend', () => {
+  const baseOptions: Required<FolderSizeOptions> = {
+    maxDepth: Number.MAX_SAFE_INTEGER,
+    ignores: [],
+    includeHidden: true,
+    includeLink: true,
+    concurrency: 2,
+    ignoreErrors: false,
+    inodeCheck: true,
+    onError: () => true,
+    backend: 'auto'
+  };
+
+  describe('isCompatibleRegExp', () => {
+    it('should accept plain patterns', () => {
+      expect(NativeBackend.isCompatibleRegExp(/\.log$/)).toBe(true);
+      expect(NativeBackend.isCompatibleRegExp(/[\\/]node_modules([\\/]|$)/)).toBe(true);
+      expect(NativeBackend.isCompatibleRegExp(/(?:dist|build)$/)).toBe(true);
+    });
+
+    it('should reject flags that change matching semantics', () => {
+      expect(NativeBackend.isCompatibleRegExp(/\.log$/i)).toBe(false);
+      expect(NativeBackend.isCompatibleRegExp(/\.log$/g)).toBe(false);
+      expect(NativeBackend.isCompatibleRegExp(/\.log$/u)).toBe(false);
+    });
+
+    it('should reject syntax unsupported by std::regex', () => {
+      expect(NativeBackend.isCompatibleRegExp(/(?<=src)\.ts$/)).toBe(false);
+      expect(NativeBackend.isCompatibleRegExp(/(?<name>dist)/)).toBe(false);
+    });
+  });
+
+  describe('toCalculationOptions', () => {
+    it('should map options onto native calculation options', () => {
+      const nativeOptions = NativeBackend.toCalculationOptions({
+        ...baseOptions,
+        maxDepth: 2,
+        ignores: [/\.log$/],
+        includeHidden: false,
+        includeLink: false,
+        concurrency: 8,
+        inodeCheck: false
+      });
+
+      expect(nativeOptions).toEqual({
+        includeHidden: false,
+        maxDepth: 3,
+        ignorePatterns: ['\\.log$'],
+        inodeCheck: false,
+        includeLink: false,
+        maxThreads: 8,
+        includeDirectorySize: true
+      });
+    });
+
+    it('should clamp depth and thread count', () => {
+      const nativeOptions = NativeBackend.toCalculationOptions({...baseOptions, concurrency: 0});
+
+      expect(nativeOptions?.maxDepth).toBe(4294967295);
+      expect(nativeOptions?.maxThreads).toBe(1);
+    });
+
+    it('should return null when an ignore pattern cannot be mapped', () => {
+      expect(NativeBackend.toCalculationOptions({...baseOptions, ignores: [/\.LOG$/i]})).toBeNull();
+    });
+  });
+
+  describe('parseError', () => {
+    it('should map native errors to JS messages and paths', () => {
+      expect(NativeBackend.parseError('Cannot access: /data/a', '/data')).toEqual({
+        message: '无法获取文件信息: Cannot access: /data/a',
+        path: '/data/a'
+      });
+      expect(NativeBackend.parseError('Cannot list directory: /data/b', '/data').path).toBe('/data/b');
+    });
+
+    it('should fall back to the root path for unknown errors', () => {
+      expect(NativeBackend.parseError('Thread error: boom', '/data')).toEqual({
+        message: 'Thread error: boom',
+        path: '/data'
+      });
+    });
+  });
+});
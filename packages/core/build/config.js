@@ -35,7 +35,7 @@ exports.GLOBAL_NAME = pkg.name.replace(/-([a-z])/g, (_, letter) => letter.toUppe
  * 外部依赖，这些依赖不会被打包
  * @type {string[]}
  */
-exports.EXTERNAL = [];
+exports.EXTERNAL = ['@get-folder/cc'];
 
 /**
  * 入口文件路径
@@ -88,6 +88,16 @@ exports.BANNER = [
     ' */'
 ].join('\n');
 
+/**
+ * ES 模块产物的前置代码：以本模块的 import.meta.url 创建 require，
+ * 使按需加载的可选依赖（@get-folder/cc）从本包所在位置解析，而不是调用方的工作目录
+ * @type {string}
+ */
+exports.ES_INTRO = [
+    "import { createRequire as __createRequire } from 'node:module';",
+    'const require = __createRequire(import.meta.url);'
+].join('\n');
+
 /**
  * 获取输出文件路径
  * @param {string} format 打包格式
@@ -24,6 +24,8 @@ function createConfig(options) {
             format: options.format === 'types' ? 'es' : options.format,
             exports: 'auto',
             banner: config.BANNER,
+            // ES 模块中没有 require，注入基于 import.meta.url 的实现
+            intro: options.format === 'es' ? config.ES_INTRO : undefined,
             // 是否生成sourcemap
             sourcemap: !config.IS_PRODUCTION,
             // 全局变量映射，用于UMD/IIFE格式
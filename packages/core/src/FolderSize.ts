@@ -1,15 +1,26 @@
-import {promises as fs} from 'fs';
+import {Dir, Dirent, promises as fs} from 'fs';
 import {join} from 'path';
 import {FolderSizeError, FolderSizeOptions, FolderSizeResult} from './types';
 import {BigNumber} from "bignumber.js";
 import * as path from "node:path";
 import {SimpleSemaphore} from "./SimpleSemaphore";
 import {BaseScene} from "./BaseScene";
+import {
+  NativeAccelerator,
+  NativeBackend,
+  NativeCalculationOptions,
+  NativeCalculationResult
+} from "./utils/NativeBackend";
 
 /**
  * 文件夹大小计算器类
  */
 export class FolderSize extends BaseScene {
+  /**
+   * 单个目录同时处理中的子项上限，超过后等待已有子项完成再继续读取目录
+   */
+  private static readonly MAX_PENDING_CHILDREN = 1024;
+
   private readonly options: Required<FolderSizeOptions>;
 
   /**
@@ -46,6 +57,7 @@ export class FolderSize extends BaseScene {
       inodeCheck: true,
       // 默认继续
       onError: () => true,
+      backend: 'auto',
       ...options
     };
   }
@@ -59,36 +71,115 @@ export class FolderSize extends BaseScene {
     this.clearInode();
     const normalizePath = path.normalize(folderPath);
 
+    const backend = this.options.backend;
+    if (backend !== 'js') {
+      const nativeOptions = NativeBackend.toCalculationOptions(this.options);
+
+      if (backend === 'native') {
+        if (!nativeOptions) {
+          throw new Error('忽略规则无法交由原生扩展处理，请使用不带标志位的正则');
+        }
+        const result = await this.calculateSizeNative(NativeBackend.require(), normalizePath, nativeOptions);
+        return this.toFolderSizeResult(result, normalizePath);
+      }
+
+      const accelerator = NativeBackend.isParityPlatform() ? NativeBackend.load() : null;
+      if (accelerator && nativeOptions) {
+        let result: NativeCalculationResult | null = null;
+        try {
+          result = await this.calculateSizeNative(accelerator, normalizePath, nativeOptions);
+        } catch (error) {
+          // 原生扩展异常时回退到 JS 实现
+        }
+        if (result) {
+          return this.toFolderSizeResult(result, normalizePath);
+        }
+      }
+    }
+
     // 使用 Node.js 实现
     return await this.calculateSizeNodeJs(normalizePath);
   }
 
+  /**
+   * 使用原生扩展计算文件夹大小
+   * @param accelerator 原生加速器
+   * @param folderPath 文件夹路径
+   * @param nativeOptions 原生计算选项
+   * @returns 原生计算结果
+   */
+  private async calculateSizeNative(accelerator: NativeAccelerator, folderPath: string,
+                                    nativeOptions: NativeCalculationOptions): Promise<NativeCalculationResult> {
+    // 原生拼接子路径时不做规范化，去掉末尾分隔符（根目录除外）
+    const rootPath = folderPath.length > 1 && /[\\/]$/.test(folderPath) && path.parse(folderPath).root !== folderPath
+      ? folderPath.slice(0, -1)
+      : folderPath;
+
+    if (accelerator.calculateFolderSizeAsync) {
+      return await accelerator.calculateFolderSizeAsync(rootPath, nativeOptions);
+    }
+    return accelerator.calculateFolderSize(rootPath, nativeOptions);
+  }
+
+  /**
+   * 将原生计算结果转换为 FolderSizeResult，并按 JS 实现的规则处理错误
+   * @param result 原生计算结果
+   * @param folderPath 文件夹路径
+   * @returns 文件夹大小结果
+   */
+  private toFolderSizeResult(result: NativeCalculationResult, folderPath: string): FolderSizeResult {
+    for (const nativeError of result.errors ?? []) {
+      const {message, path: errorPath} = NativeBackend.parseError(nativeError, folderPath);
+      this.handleError(new Error(nativeError), message, errorPath);
+    }
+
+    return {
+      size: new BigNumber(result.totalSize),
+      fileCount: result.fileCount,
+      // 原生统计包含根目录本身
+      directoryCount: Math.max(0, result.directoryCount - 1),
+      linkCount: result.linkCount
+    };
+  }
+
   /**
    * 计算文件夹大小
    * @param folderPath 文件夹路径
    * @returns 计算结果
    */
   private async calculateSizeNodeJs(folderPath: string): Promise<FolderSizeResult> {
-    let totalSize = new BigNumber(0);
+    // 以原生 bigint 累加，结束时再转换为 BigNumber，避免每个文件都创建字符串和 BigNumber
+    let totalSize = 0n;
     let fileCount = 0;
     let directoryCount = 0;
     let linkCount = 0;
 
+    // 整个扫描共享的并发预算：令牌只在文件系统操作期间持有，不跨越子项递归，
+    // 因此 concurrency 限制的是全局进行中的 lstat/opendir/read 数量，与目录深度无关
+    const semaphore = new SimpleSemaphore(Math.max(1, this.options.concurrency));
+
     /**
      * 递归处理文件夹项目
      * @param itemPath 项目路径
      * @param depth 当前深度
+     * @param dirent 父目录读取到的目录项（根目录没有）
      */
-    const processItem = async (itemPath: string, depth: number = 0): Promise<void> => {
+    const processItem = async (itemPath: string, depth: number = 0, dirent?: Dirent): Promise<void> => {
       // 检查是否应该忽略此路径
       if (this.shouldIgnorePath(this.options.ignores, itemPath, this.options.includeHidden)) {
         return;
       }
 
+      // 不计大小、不做硬链接检测的符号链接，目录项类型已足够，无需 lstat
+      if (dirent?.isSymbolicLink() && !this.options.includeLink && !this.options.inodeCheck) {
+        linkCount++;
+        return;
+      }
+
       let stats;
       try {
         // 获取文件统计信息
-        stats = await fs.lstat(itemPath, {bigint: true});
+        stats = await semaphore.run(() => fs.lstat(itemPath, {bigint: true}));
       } catch (error) {
         return this.handleError(error as Error, `无法获取文件信息: ${(error as Error).message}`, itemPath);
       }
@@ -105,10 +196,10 @@ export class FolderSize extends BaseScene {
       if (isSymbolicLink) {
         linkCount++;
         if (this.options.includeLink) {
-          totalSize = totalSize.plus(fileSize.toString());
+          totalSize += fileSize;
         }
       } else {
-        totalSize = totalSize.plus(fileSize.toString());
+        totalSize += fileSize;
       }
 
       if (isDirectory) {
@@ -122,27 +213,50 @@ export class FolderSize extends BaseScene {
           directoryCount++;
         }
 
-        let entries;
+        let dir: Dir;
         try {
-          // 读取目录内容
-          entries = await fs.readdir(itemPath);
+          // 打开目录，以流的方式逐项读取，不一次性生成全部名称
+          dir = await semaphore.run(() => fs.opendir(itemPath));
         } catch (error) {
           return this.handleError(error as Error, `无法读取目录: ${(error as Error).message}`, itemPath);
         }
 
-        // 简化的并发控制
-        const semaphore = new SimpleSemaphore(this.options.concurrency);
-        await Promise.all(entries.map(async (entry) => {
-          await semaphore.acquire();
-          try {
-            const childPath = join(itemPath, entry);
-            await processItem(childPath, depth + 1);
-          } catch (error) {
-            throw error;
-          } finally {
-            semaphore.release();
+        const pending = new Set<Promise<void>>();
+        let readError: Error | null = null;
+
+        try {
+          while (true) {
+            let entry: Dirent | null;
+            try {
+              entry = await semaphore.run(() => dir.read());
+            } catch (error) {
+              readError = error as Error;
+              break;
+            }
+            if (!entry) {
+              break;
+            }
+
+            const child: Promise<void> = processItem(join(itemPath, entry.name), depth + 1, entry)
+              .finally(() => pending.delete(child));
+            // 错误由下方的 Promise.all 统一抛出，这里只避免未处理的拒绝
+            child.catch(() => undefined);
+            pending.add(child);
+
+            // 超大目录中限制同时处理的子项数量
+            if (pending.size >= FolderSize.MAX_PENDING_CHILDREN) {
+              await Promise.race(pending);
+            }
           }
-        }));
+        } finally {
+          await dir.close().catch(() => undefined);
+        }
+
+        await Promise.all(pending);
+
+        if (readError) {
+          return this.handleError(readError, `无法读取目录: ${readError.message}`, itemPath);
+        }
 
       } else if (isFile) {
         fileCount++;
@@ -152,7 +266,7 @@ export class FolderSize extends BaseScene {
     await processItem(folderPath);
 
     return {
-      size: totalSize,
+      size: new BigNumber(totalSize.toString()),
       fileCount,
       directoryCount,
       linkCount
@@ -52,12 +52,8 @@ export class SimpleSemaphore {
     return new Promise<void>((resolve) => {
       // 将 resolve 函数包装后放入等待队列
       // 当有令牌释放时，会调用这个函数唤醒等待者
-      this.waiters.push(() => {
-        // 消耗令牌
-        this.available--;
-        // 唤醒等待的 acquire() 调用
-        resolve();
-      });
+      // 令牌由 release() 直接转交，这里不再消耗
+      this.waiters.push(() => resolve());
     });
   }
 
@@ -85,4 +81,19 @@ export class SimpleSemaphore {
       this.available++;
     }
   }
+
+  /**
+   * 在持有令牌期间执行任务，结束后（无论成功失败）归还令牌
+   *
+   * @param task 任务
+   * @returns 任务结果
+   */
+  async run<T>(task: () => Promise<T>): Promise<T> {
+    await this.acquire();
+    try {
+      return await task();
+    } finally {
+      this.release();
+    }
+  }
 }
@@ -25,6 +25,15 @@ export interface FolderSizeError {
  */
 export type ErrorCallback = (error: FolderSizeError) => boolean;
 
+/**
+ * 计算后端
+ *
+ * - auto：已安装 @get-folder/cc 且统计口径一致时使用原生扩展，否则使用 JS 实现
+ * - native：强制使用原生扩展，不可用时报错
+ * - js：始终使用 JS 实现
+ */
+export type FolderSizeBackend = 'auto' | 'native' | 'js';
+
 /**
  * 大小计算选项接口
  */
@@ -69,6 +78,12 @@ export interface FolderSizeOptions {
    * 错误处理回调，默认：() => true
    */
   onError?: ErrorCallback;
+  /**
+   * 计算后端，默认：'auto'
+   *
+   * 原生扩展中 concurrency 对应工作线程数，错误在扫描结束后依次交给 onError 处理
+   */
+  backend?: FolderSizeBackend;
 }
 
 /**
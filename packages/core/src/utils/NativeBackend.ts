@@ -0,0 +1,182 @@
+import {FolderSizeOptions} from "../types";
+
+/**
+ * 原生扩展包名
+ */
+const NATIVE_PACKAGE = '@get-folder/cc';
+
+/**
+ * 原生扩展的 maxDepth 上限（UINT32_MAX）
+ */
+const NATIVE_MAX_DEPTH = 4294967295;
+
+/**
+ * 原生错误前缀与 JS 实现错误消息的对应关系
+ */
+const NATIVE_ERROR_MESSAGES: Record<string, string> = {
+  'Path not found': '无法获取文件信息',
+  'Cannot access': '无法获取文件信息',
+  'Cannot open directory': '无法读取目录',
+  'Cannot list directory': '无法读取目录'
+};
+
+/**
+ * 原生计算选项（对应 @get-folder/cc 的 CalculationOptions）
+ */
+export interface NativeCalculationOptions {
+  includeHidden: boolean;
+  maxDepth: number;
+  ignorePatterns: string[];
+  inodeCheck: boolean;
+  includeLink: boolean;
+  maxThreads: number;
+  includeDirectorySize: boolean;
+}
+
+/**
+ * 原生计算结果（对应 @get-folder/cc 的 CalculationResult，仅列出用到的字段）
+ */
+export interface NativeCalculationResult {
+  totalSize: string;
+  fileCount: number;
+  directoryCount: number;
+  linkCount: number;
+  errors?: string[];
+}
+
+/**
+ * 原生加速器（对应 @get-folder/cc 的 NativeAccelerator，仅列出用到的方法）
+ */
+export interface NativeAccelerator {
+  calculateFolderSize(path: string, options?: NativeCalculationOptions): NativeCalculationResult;
+
+  calculateFolderSizeAsync?(path: string, options?: NativeCalculationOptions): Promise<NativeCalculationResult>;
+}
+
+/**
+ * 原生错误信息
+ */
+export interface NativeError {
+  /**
+   * 与 JS 实现一致的错误消息
+   */
+  message: string;
+  /**
+   * 发生错误的路径
+   */
+  path: string;
+}
+
+/**
+ * 原生扩展后端
+ *
+ * 按需加载可选的 @get-folder/cc，并将 FolderSizeOptions 转换为原生的 CalculationOptions
+ */
+export class NativeBackend {
+  /**
+   * 已加载的加速器，undefined 表示尚未尝试加载
+   */
+  private static accelerator: NativeAccelerator | null | undefined;
+
+  /**
+   * 加载失败的原因
+   */
+  private static loadError: Error | null = null;
+
+  /**
+   * 加载原生加速器，未安装或当前平台不支持时返回 null
+   */
+  static load(): NativeAccelerator | null {
+    if (NativeBackend.accelerator !== undefined) {
+      return NativeBackend.accelerator;
+    }
+
+    try {
+      // ES 模块产物中的 require 由构建注入（基于 import.meta.url），两种产物都从本包所在位置解析
+      const native = require(NATIVE_PACKAGE);
+      if (!native.isNativeAccelerationSupported()) {
+        throw new Error(`${NATIVE_PACKAGE} 不支持当前平台`);
+      }
+      NativeBackend.accelerator = native.createAccelerator() as NativeAccelerator;
+    } catch (error) {
+      NativeBackend.accelerator = null;
+      NativeBackend.loadError = error as Error;
+    }
+
+    return NativeBackend.accelerator;
+  }
+
+  /**
+   * 加载原生加速器，不可用时抛出错误
+   */
+  static require(): NativeAccelerator {
+    const accelerator = NativeBackend.load();
+    if (!accelerator) {
+      throw new Error(`原生扩展不可用: ${NativeBackend.loadError?.message ?? NATIVE_PACKAGE}`);
+    }
+    return accelerator;
+  }
+
+  /**
+   * 当前平台的原生实现是否与 JS 实现统计口径一致（auto 模式下仅在这些平台使用原生扩展）
+   *
+   * macOS 引擎会把 ..namedfork/rsrc 资源分支计入文件大小，与 JS 实现不一致，因此仅限 Linux
+   */
+  static isParityPlatform(): boolean {
+    return process.platform === 'linux';
+  }
+
+  /**
+   * 正则能否交由原生扩展（std::regex ECMAScript 语法）按相同语义匹配
+   *
+   * 原生不支持标志位（i/m/s/u/v），g/y 在 JS 中会让 test 带状态，也无法对应；
+   * 后行断言、命名捕获组与 Unicode 属性转义同样不支持
+   * @param reg 正则
+   */
+  static isCompatibleRegExp(reg: RegExp): boolean {
+    if (reg.flags.replace('d', '') !== '') {
+      return false;
+    }
+    return !/\(\?<|\\[pPk]/.test(reg.source);
+  }
+
+  /**
+   * 转换为原生计算选项
+   * @param options 大小计算选项
+   * @returns 原生计算选项，存在无法对应的忽略规则时返回 null
+   */
+  static toCalculationOptions(options: Required<FolderSizeOptions>): NativeCalculationOptions | null {
+    if (!options.ignores.every(reg => NativeBackend.isCompatibleRegExp(reg))) {
+      return null;
+    }
+
+    // JS 实现读取深度不超过 maxDepth 的目录，原生在深度达到 maxDepth 时停止，两者相差 1
+    const maxDepth = Math.floor(options.maxDepth) + 1;
+
+    return {
+      includeHidden: options.includeHidden,
+      maxDepth: Math.min(Math.max(maxDepth, 0), NATIVE_MAX_DEPTH),
+      ignorePatterns: options.ignores.map(reg => reg.source),
+      inodeCheck: options.inodeCheck,
+      includeLink: options.includeLink,
+      maxThreads: Math.max(1, Math.floor(options.concurrency)),
+      includeDirectorySize: true
+    };
+  }
+
+  /**
+   * 解析原生错误信息
+   * @param error 原生错误字符串（如 "Cannot access: /path"）
+   * @param rootPath 扫描的根路径，无法解析出路径时使用
+   */
+  static parseError(error: string, rootPath: string): NativeError {
+    const separator = error.indexOf(': ');
+    const prefix = separator === -1 ? '' : error.slice(0, separator);
+    const message = NATIVE_ERROR_MESSAGES[prefix];
+
+    if (!message) {
+      return {message: error, path: rootPath};
+    }
+    return {message: `${message}: ${error}`, path: error.slice(separator + 2)};
+  }
+}
@@ -0,0 +1,338 @@
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+const { FolderSize } = require('get-folder');
+
+/**
+ * 基线性能测试与对比工具
+ *
+ * 用法:
+ *   node benchmark-baseline.js run [--out baseline.json] [--iterations 10] [--warmup 2]
+ *   node benchmark-baseline.js compare <baseline.json> [current.json] [--threshold 5]
+ *
+ * - run: 在合成目录树上按 引擎 × 选项组合 运行测试，结果保存为 JSON 基线
+ * - compare: 对比两份基线（未提供 current 时现场运行），
+ *   使用 Welch t 检验给出差异的 95% 置信区间，只有置信区间整体超出阈值才判定为回归/提升；
+ *   存在回归时以退出码 1 结束，便于在 CI 中使用
+ *
+ * 全部测试数据由固定种子生成，完全离线运行
+ */
+
+/**
+ * 合成目录树配置（固定种子，保证每次生成的结构一致）
+ */
+const SYNTHETIC_TREES = [
+  { name: 'small-files', description: '宽而浅：大量小文件', depth: 2, dirsPerLevel: 10, filesPerDir: 100, fileSize: 128 },
+  { name: 'deep-tree', description: '窄而深：深层嵌套目录', depth: 24, dirsPerLevel: 1, filesPerDir: 20, fileSize: 1024 },
+  { name: 'node-modules', description: '类 node_modules：多层包目录', depth: 4, dirsPerLevel: 6, filesPerDir: 12, fileSize: 1024 }
+];
+
+/**
+ * 选项组合（js 引擎固定 backend: 'js'，避免 FolderSize 自动切换到原生后端）
+ */
+const OPTION_SETS = [
+  { name: 'default', js: { backend: 'js' }, native: {} },
+  { name: 'no-inode-check', js: { backend: 'js', inodeCheck: false }, native: { inodeCheck: false } },
+  { name: 'ignore-hidden', js: { backend: 'js', includeHidden: false }, native: { includeHidden: false } }
+];
+
+/**
+ * 小样本双侧 95% t 分布临界值（自由度 1 - 30）
+ */
+const T_CRITICAL_95 = [
+  12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+  2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+  2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+];
+
+/**
+ * 解析命令行参数
+ */
+function parseArgs(argv) {
+  const args = { _: [] };
+  for (let i = 0; i < argv.length; i++) {
+    const arg = argv[i];
+    if (arg.startsWith('--')) {
+      const key = arg.slice(2);
+      const next = argv[i + 1];
+      if (next !== undefined && !next.startsWith('--')) {
+        args[key] = next;
+        i++;
+      } else {
+        args[key] = true;
+      }
+    } else {
+      args._.push(arg);
+    }
+  }
+  return args;
+}
+
+/**
+ * 固定种子的伪随机数生成器（mulberry32）
+ */
+function createRandom(seed) {
+  let state = seed >>> 0;
+  return () => {
+    state = (state + 0x6D2B79F5) >>> 0;
+    let t = state;
+    t = Math.imul(t ^ (t >>> 15), t | 1);
+    t ^= t + Math.imul(t ^ (t >>> 7), t | 61);
+    return ((t ^ (t >>> 14)) >>> 0) / 4294967296;
+  };
+}
+
+/**
+ * 生成合成目录树，已存在时直接复用
+ * @param {string} root 根目录
+ * @param {Object} tree 目录树配置
+ * @returns {string} 目录树路径
+ */
+function ensureSyntheticTree(root, tree) {
+  const treePath = path.join(root, tree.name);
+  const marker = path.join(treePath, '.complete');
+  if (fs.existsSync(marker)) {
+    return treePath;
+  }
+
+  fs.rmSync(treePath, { recursive: true, force: true });
+  const random = createRandom(tree.name.length * 7919);
+
+  const build = (dirPath, level) => {
+    fs.mkdirSync(dirPath, { recursive: true });
+    for (let i = 0; i < tree.filesPerDir; i++) {
+      // 文件大小在配置值上下浮动，隐藏文件约占 10%
+      const size = Math.max(1, Math.round(tree.fileSize * (0.5 + random())));
+      const name = random() < 0.1 ? `.hidden-${i}` : `file-${i}.js`;
+      fs.writeFileSync(path.join(dirPath, name), Buffer.alloc(size, 97));
+    }
+    if (level < tree.depth) {
+      for (let i = 0; i < tree.dirsPerLevel; i++) {
+        const name = tree.name === 'node-modules' ? `node_modules/pkg-${i}` : `dir-${i}`;
+        build(path.join(dirPath, name), level + 1);
+      }
+    }
+  };
+
+  build(treePath, 0);
+  fs.writeFileSync(marker, '');
+  return treePath;
+}
+
+/**
+ * 获取可用的引擎
+ */
+function getEngines() {
+  const engines = [
+    {
+      name: 'js',
+      run: (treePath, optionSet) => FolderSize.getSize(treePath, optionSet.js)
+    }
+  ];
+
+  try {
+    const { createAccelerator, isNativeAccelerationSupported } = require('@get-folder/cc');
+    if (isNativeAccelerationSupported()) {
+      const accelerator = createAccelerator();
+      engines.push({
+        name: 'native',
+        run: async (treePath, optionSet) => accelerator.calculateFolderSize(treePath, optionSet.native)
+      });
+    }
+  } catch (error) {
+    console.log(`⚠️  原生引擎不可用，仅测试 js 引擎: ${error.message}`);
+  }
+
+  return engines;
+}
+
+/**
+ * 计算样本统计量
+ * @param {number[]} samples 样本（毫秒）
+ */
+function summarize(samples) {
+  const n = samples.length;
+  const mean = samples.reduce((sum, value) => sum + value, 0) / n;
+  const variance = n > 1
+    ? samples.reduce((sum, value) => sum + (value - mean) ** 2, 0) / (n - 1)
+    : 0;
+  const sorted = [...samples].sort((a, b) => a - b);
+  const median = n % 2 === 1 ? sorted[(n - 1) / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) / 2;
+
+  return { n, mean, stddev: Math.sqrt(variance), median, min: sorted[0], max: sorted[n - 1] };
+}
+
+/**
+ * 获取双侧 95% t 临界值
+ * @param {number} df 自由度
+ */
+function tCritical(df) {
+  if (!Number.isFinite(df) || df < 1) {
+    return T_CRITICAL_95[0];
+  }
+  if (df <= T_CRITICAL_95.length) {
+    return T_CRITICAL_95[Math.floor(df) - 1];
+  }
+  // 大自由度使用 Cornish-Fisher 展开近似
+  const z = 1.959964;
+  return z + (z ** 3 + z) / (4 * df) + (5 * z ** 5 + 16 * z ** 3 + 3 * z) / (96 * df ** 2);
+}
+
+/**
+ * Welch t 检验：当前相对基线的耗时变化百分比及其 95% 置信区间
+ * @param {Object} baseline 基线统计量
+ * @param {Object} current 当前统计量
+ */
+function welchDifference(baseline, current) {
+  const vb = baseline.stddev ** 2 / baseline.n;
+  const vc = current.stddev ** 2 / current.n;
+  const se = Math.sqrt(vb + vc);
+  const df = se === 0
+    ? Infinity
+    : (vb + vc) ** 2 / ((baseline.n > 1 ? vb ** 2 / (baseline.n - 1) : 0) + (current.n > 1 ? vc ** 2 / (current.n - 1) : 0));
+  const diff = current.mean - baseline.mean;
+  const margin = tCritical(df) * se;
+
+  return {
+    changePercent: diff / baseline.mean * 100,
+    lowerPercent: (diff - margin) / baseline.mean * 100,
+    upperPercent: (diff + margin) / baseline.mean * 100
+  };
+}
+
+/**
+ * 运行全部测试
+ * @param {Object} args 命令行参数
+ */
+async function runBenchmarks(args) {
+  const iterations = Number(args.iterations || 10);
+  const warmup = Number(args.warmup || 2);
+  const root = args.root || path.join(os.tmpdir(), 'get-folder-benchmark-trees');
+  const engines = getEngines();
+  const results = [];
+
+  for (const tree of SYNTHETIC_TREES) {
+    const treePath = ensureSyntheticTree(root, tree);
+    console.log(`\n🌲 ${tree.name}（${tree.description}）`);
+
+    for (const engine of engines) {
+      for (const optionSet of OPTION_SETS) {
+        for (let i = 0; i < warmup; i++) {
+          await engine.run(treePath, optionSet);
+        }
+
+        const samples = [];
+        for (let i = 0; i < iterations; i++) {
+          const start = process.hrtime.bigint();
+          await engine.run(treePath, optionSet);
+          samples.push(Number(process.hrtime.bigint() - start) / 1e6);
+        }
+
+        const stats = summarize(samples);
+        results.push({ engine: engine.name, optionSet: optionSet.name, tree: tree.name, samples, stats });
+        console.log(`   ${engine.name.padEnd(7)} ${optionSet.name.padEnd(16)} ${stats.mean.toFixed(2)}ms ±${stats.stddev.toFixed(2)} (n=${stats.n})`);
+      }
+    }
+  }
+
+  return {
+    createdAt: new Date().toISOString(),
+    environment: {
+      node: process.version,
+      platform: process.platform,
+      arch: process.arch,
+      cpus: os.cpus().length,
+      cpuModel: os.cpus()[0] ? os.cpus()[0].model : 'unknown'
+    },
+    iterations,
+    warmup,
+    results
+  };
+}
+
+/**
+ * 对比两份基线
+ * @param {Object} baseline 基线
+ * @param {Object} current 当前结果
+ * @param {number} threshold 判定阈值（百分比）
+ * @returns {number} 回归数量
+ */
+function compareBaselines(baseline, current, threshold) {
+  const key = result => `${result.engine}/${result.optionSet}/${result.tree}`;
+  const baselineMap = new Map(baseline.results.map(result => [key(result), result]));
+  let regressions = 0;
+
+  console.log(`\n📊 对比基线（${baseline.createdAt}）与当前结果（${current.createdAt}），阈值 ${threshold}%`);
+  console.log('='.repeat(96));
+
+  for (const result of current.results) {
+    const base = baselineMap.get(key(result));
+    if (!base) {
+      console.log(`🆕 ${key(result).padEnd(40)} 基线中不存在`);
+      continue;
+    }
+
+    const diff = welchDifference(base.stats, result.stats);
+    const range = `[${diff.lowerPercent.toFixed(1)}%, ${diff.upperPercent.toFixed(1)}%]`;
+    let verdict = '➖ 无显著变化';
+    if (diff.lowerPercent > threshold) {
+      verdict = '🔴 回归';
+      regressions++;
+    } else if (diff.upperPercent < -threshold) {
+      verdict = '🟢 提升';
+    }
+
+    console.log(`${verdict.padEnd(10)} ${key(result).padEnd(40)} ${base.stats.mean.toFixed(2)}ms → ${result.stats.mean.toFixed(2)}ms  ${diff.changePercent >= 0 ? '+' : ''}${diff.changePercent.toFixed(1)}% 95%CI ${range}`);
+  }
+
+  if (baseline.environment && current.environment && baseline.environment.cpuModel !== current.environment.cpuModel) {
+    console.log('\n⚠️  两次测试的 CPU 不同，对比结果仅供参考');
+  }
+
+  return regressions;
+}
+
+async function main() {
+  const args = parseArgs(process.argv.slice(2));
+  const command = args._[0];
+
+  if (command === 'run') {
+    const report = await runBenchmarks(args);
+    const out = args.out || 'benchmark-baseline.json';
+    fs.writeFileSync(out, JSON.stringify(report, null, 2));
+    console.log(`\n💾 基线已保存: ${out}`);
+  } else if (command === 'compare') {
+    const baselinePath = args._[1];
+    if (!baselinePath) {
+      throw new Error('缺少基线文件路径');
+    }
+    const baseline = JSON.parse(fs.readFileSync(baselinePath, 'utf8'));
+    const current = args._[2]
+      ? JSON.parse(fs.readFileSync(args._[2], 'utf8'))
+      : await runBenchmarks({ ...args, iterations: args.iterations || baseline.iterations, warmup: args.warmup || baseline.warmup });
+
+    const regressions = compareBaselines(baseline, current, Number(args.threshold || 5));
+    if (regressions > 0) {
+      console.log(`\n❌ 发现 ${regressions} 项性能回归`);
+      process.exitCode = 1;
+    }
+  } else {
+    console.log('用法:');
+    console.log('  node benchmark-baseline.js run [--out baseline.json] [--iterations 10] [--warmup 2] [--root <dir>]');
+    console.log('  node benchmark-baseline.js compare <baseline.json> [current.json] [--threshold 5]');
+  }
+}
+
+if (require.main === module) {
+  main().catch(error => {
+    console.error(error);
+    process.exit(1);
+  });
+}
+
+module.exports = {
+  runBenchmarks,
+  compareBaselines,
+  summarize,
+  welchDifference
+};